@@ -0,0 +1,24 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../Sources/Crc/Crc32.c 
+
+OBJS += \
+./Sources/Crc/Crc32.o 
+
+C_DEPS += \
+./Sources/Crc/Crc32.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+Sources/Crc/%.o: ../Sources/Crc/%.c
+	@echo 'Building file: $<'
+	@echo 'Invoking: Cross ARM C Compiler'
+	arm-none-eabi-gcc -mcpu=cortex-m0plus -mthumb -O0 -fmessage-length=0 -fsigned-char -ffunction-sections -fdata-sections  -g3 -fstack-usage -I"../Sources" -I"../Includes" -std=c99 -DBASE_APP_ADDRESS=$(APP_BASE_ADDRESS) -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
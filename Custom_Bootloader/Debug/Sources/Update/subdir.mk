@@ -0,0 +1,27 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../Sources/Update/Update.c \
+../Sources/Update/Verify.c 
+
+OBJS += \
+./Sources/Update/Update.o \
+./Sources/Update/Verify.o 
+
+C_DEPS += \
+./Sources/Update/Update.d \
+./Sources/Update/Verify.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+Sources/Update/%.o: ../Sources/Update/%.c
+	@echo 'Building file: $<'
+	@echo 'Invoking: Cross ARM C Compiler'
+	arm-none-eabi-gcc -mcpu=cortex-m0plus -mthumb -O0 -fmessage-length=0 -fsigned-char -ffunction-sections -fdata-sections  -g3 -fstack-usage -I"../Sources" -I"../Includes" -std=c99 -DBASE_APP_ADDRESS=$(APP_BASE_ADDRESS) -DBOOT_NODE_ADDRESS=$(BOOT_NODE_ADDRESS) -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
@@ -29,5 +29,10 @@ Sources/Srec \
 Sources/Queue \
 Sources/HAL \
 Sources/Driver \
+Sources/Crc \
+Sources/Event \
+Sources/Trace \
+Sources/Update \
+Sources/Command \
 Project_Settings/Startup_Code \
 
@@ -0,0 +1,73 @@
+/**
+ * @file  : App_manifest.h
+ * @author: Nguyen The Anh.
+ * @brief : Declare the image manifest sent by the host in the S0 record and kept in the App information sector.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ * Project_Settings/Scripts/srec_manifest.awk generates the S0 record from the App S-record file.
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _APP_MANIFEST_H_
+#define _APP_MANIFEST_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Value of the magic field of a manifest ("MNFT" in the S0 data)*/
+#define APP_MANIFEST_MAGIC (0x54464E4Du)
+
+/*\The image_crc field holds the CRC-32 of the load range, erased gaps read as 0xFF*/
+#define APP_MANIFEST_FLAG_CRC (1u << 0)
+
+/*\Flags known by this bootloader, a manifest with another flag is rejected*/
+#define APP_MANIFEST_FLAG_MASK (APP_MANIFEST_FLAG_CRC)
+
+/*******************************************************************************
+ * Struct
+ ******************************************************************************/
+
+/**
+ * @brief Reference of the image manifest, little endian in the S0 data
+ */
+typedef struct app_manifest
+{
+    uint32_t magic;         /*APP_MANIFEST_MAGIC*/
+    uint32_t version;       /*App version*/
+    uint32_t load_address;  /*Flash address of the first image byte*/
+    uint32_t load_size;     /*Image size in byte*/
+    uint32_t entry_address; /*Address of the App vector table*/
+    uint32_t image_crc;     /*CRC-32 of the load range*/
+    uint32_t flags;         /*APP_MANIFEST_FLAG_ bits*/
+} app_manifest;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Check that a manifest describes an image this bootloader can write
+ *
+ * @param manifest: Manifest to check
+ *
+ * @return 1 if the manifest is accepted, 0 if not
+ */
+uint8_t App_manifest_check(const app_manifest *manifest);
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
@@ -0,0 +1,64 @@
+/**
+ * @file  : Boot_info.h
+ * @author: Nguyen The Anh.
+ * @brief : Declare the boot information block passed from the bootloader to the application.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _BOOT_INFO_H_
+#define _BOOT_INFO_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdint.h>
+#include "Flash_layout.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\RAM address of the boot information block (start of m_data, section .boot_info).
+ * The application must keep this block out of its own .data/.bss to read it: its linker script
+ * reserves BOOT_INFO_SIZE bytes at the start of SRAM_L (RAM_BASE_ADDRESS) before any other
+ * section, e.g. a NOLOAD section of that size first in m_data, and the startup code must not
+ * clear them*/
+#define BOOT_INFO_ADDRESS ((uint32_t)RAM_BASE_ADDRESS)
+
+/*\Value of the magic field when the block is valid ("BOOT")*/
+#define BOOT_INFO_MAGIC (0x424F4F54u)
+
+/*******************************************************************************
+ * Struct
+ ******************************************************************************/
+
+/**
+ * @brief Reference of the boot information block.
+ *        The clock fields give the clock tree the App starts on, the reset one (FEI) when the
+ *        bootloader jumped without clock init. baud_rate is 0 when UART0 was not used.
+ */
+typedef struct boot_info
+{
+    uint32_t magic;            /*BOOT_INFO_MAGIC if the block is valid*/
+    uint32_t clock_profile;    /*MCG profile left running (MCG_profile_enum_t)*/
+    uint32_t core_clock;       /*Core/system clock in Hz*/
+    uint32_t bus_clock;        /*Bus/flash clock in Hz*/
+    uint32_t peripheral_clock; /*MCGFLLCLK or MCGPLLCLK/2 clock in Hz*/
+    uint32_t baud_rate;        /*Last UART0 baud rate used by the bootloader*/
+} boot_info;
+
+_Static_assert(sizeof(boot_info) <= BOOT_INFO_SIZE, "Boot information block does not fit in BOOT_INFO_SIZE");
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
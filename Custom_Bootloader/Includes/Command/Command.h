@@ -0,0 +1,62 @@
+/**
+ * @file  : Command.h
+ * @author: Nguyen The Anh.
+ * @brief : Declare enum, typdef, macro and function using in Command.c.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _COMMAND_H_
+#define _COMMAND_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdint.h>
+#include "Boot_info.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Lines starting with this character are host commands, not S-records*/
+#define BOOT_COMMAND_PREFIX ('#')
+
+/*\Sent each time a paced S-record line has been processed and its queue line freed*/
+#define BOOT_PACE_ACK ('+')
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Answer a host command line received in boot mode, #COMMIT ends a complete multi-drop update
+ *
+ * @param line: Received line, starting with BOOT_COMMAND_PREFIX
+ * @param info: Boot information block, clocks reported by #INFO
+ *
+ * @return UPDATE_CONTINUE while the update goes on, BOOT_RESULT_SUCCESS once #COMMIT has marked the App valid
+ */
+uint32_t Command_handle(const uint8_t *line, const boot_info *info);
+
+/**
+ * @brief Get the pace setting of the host
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if each processed S-record line is acknowledged (#PACE 1), 0 if not
+ */
+uint8_t Command_get_pace(void);
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
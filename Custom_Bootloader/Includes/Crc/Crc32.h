@@ -0,0 +1,59 @@
+/**
+ * @file  : Crc32.h
+ * @author: Nguyen The Anh.
+ * @brief : Declare macro and function using in Crc32.c.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _CRC32_H_
+#define _CRC32_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Start value of a CRC-32 computation*/
+#define CRC32_INITIAL_VALUE (0xFFFFFFFFu)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Add bytes to a CRC-32 (IEEE 802.3, reflected, as zlib crc32)
+ *
+ * @param crc: Running value, CRC32_INITIAL_VALUE for the first bytes
+ * @param data: Bytes to add
+ * @param length: Number of bytes
+ *
+ * @return: Running value to pass to the next call or to Crc32_final
+ */
+uint32_t Crc32_update(uint32_t crc, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Get the CRC-32 of the bytes added so far
+ *
+ * @param crc: Running value
+ *
+ * @return: CRC-32
+ */
+uint32_t Crc32_final(uint32_t crc);
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
@@ -22,6 +22,15 @@
 #ifndef _DRIVER_GPIO_H_
 #define _DRIVER_GPIO_H_
 
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/**
+ * @brief Reference of the loop count to wait for an input pull-up to settle
+ */
+#define GPIO_PULL_UP_SETTLE_COUNT (1000u)
+
 /*******************************************************************************
  * Enum
  ******************************************************************************/
@@ -110,6 +119,16 @@ uint8_t Driver_GPIO_read_pin_state(Port_type_enum_t port_type, uint8_t pin);
  */
 void Driver_GPIO_toggle_pin_state(Port_type_enum_t port_type, uint8_t pin);
 
+/**
+ * @brief Return a GPIO pin to its reset state (output low, input, no pull, pin disabled)
+ *
+ * @param port_type is the PORT which contains the pin to de-initialize.
+ * @param pin is the pin number we want to de-initialize.
+ *
+ * @return: this function return nothing.
+ */
+void Driver_GPIO_deinit_pin(Port_type_enum_t port_type, uint8_t pin);
+
 /*Header Guard*/
 #endif
 /*EOF*/
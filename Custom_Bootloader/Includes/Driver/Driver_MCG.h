@@ -40,6 +40,38 @@
  */
 #define MCGFLLCLK_REFERENCE_CLOCK (32768u)
 
+/**
+ * @brief Reference of the crystal frequency on the FRDM-KL46Z board
+ */
+#define MCG_CRYSTAL_FREQUENCY (8000000u)
+
+/**
+ * @brief Reference of the PLL reference clock and VCO limits
+ */
+#define MCG_PLL_REFERENCE_MIN (2000000u)
+#define MCG_PLL_REFERENCE_MAX (4000000u)
+#define MCG_PLL_VCO_MIN (48000000u)
+#define MCG_PLL_VCO_MAX (100000000u)
+
+/**
+ * @brief Reference of the lowest VCO multiplier (VDIV0 = 0)
+ */
+#define MCG_PLL_MULTIPLIER_BASE (24u)
+
+/**
+ * @brief Reference of the MCG settings used to run the FLL from the 8 MHz crystal during the switch to PEE
+ */
+#define MCG_CRYSTAL_RANGE_HIGH (1u)
+#define MCG_FLL_EXTERNAL_DIVIDER_256 (3u)
+
+/**
+ * @brief Reference of the MCGOUTCLK source values in MCG_C1[CLKS] and MCG_S[CLKST]
+ */
+#define MCG_CLKS_FLL_PLL (0u)
+#define MCG_CLKS_EXTERNAL (2u)
+#define MCG_CLKST_EXTERNAL (2u)
+#define MCG_CLKST_PLL (3u)
+
 /*******************************************************************************
  * Enum
  ******************************************************************************/
@@ -82,6 +114,15 @@ typedef enum PLLS_type
     PLL_SELECTED = 1u, /*PLL output is selected for MCG source*/
 } PLLS_type_enum_t;
 
+/**
+ * @brief Reference of the supported clock profiles
+ */
+typedef enum MCG_profile_type
+{
+    MCG_PROFILE_FEI = 0u, /*FLL engaged internal: FLL from the 32 kHz internal reference*/
+    MCG_PROFILE_PEE = 1u, /*PLL engaged external: PLL from the crystal oscillator*/
+} MCG_profile_enum_t;
+
 /*******************************************************************************
  * Struct
  ******************************************************************************/
@@ -112,6 +153,33 @@ typedef struct MCG_C6_config
     PLLS_type_enum_t MCG_source; /*MCG source*/
 } MCG_C6_config_info;
 
+/**
+ * @brief Contain the information about a clock profile.
+ */
+typedef struct MCG_clock_config
+{
+    MCG_profile_enum_t profile;    /*Clock profile*/
+    MCG_C4_config_info FLL_config; /*FLL configuration, used by FEI profile*/
+    uint32_t crystal_frequency;    /*Crystal frequency, used by PEE profile*/
+    uint8_t PLL_divider;           /*Crystal divide factor for the PLL reference (1 -> 25), used by PEE profile*/
+    uint8_t PLL_multiplier;        /*VCO multiply factor (24 -> 55), used by PEE profile*/
+    uint8_t core_divider;          /*MCGOUTCLK divide factor for the core clock (1 -> 16)*/
+    uint8_t bus_divider;           /*Core clock divide factor for the bus and flash clock (1 -> 8)*/
+} MCG_clock_config_info;
+
+/**
+ * @brief Contain the frequencies of the clock tree.
+ */
+typedef struct MCG_clock_frequency
+{
+    uint32_t MCGOUTCLK;        /*MCG output clock*/
+    uint32_t MCGFLLCLK;        /*FLL output clock, 0 if the FLL is not used*/
+    uint32_t MCGPLLCLK;        /*PLL output clock, 0 if the PLL is not used*/
+    uint32_t core_clock;       /*Core and system clock*/
+    uint32_t bus_clock;        /*Bus and flash clock*/
+    uint32_t peripheral_clock; /*MCGFLLCLK or MCGPLLCLK/2 clock supplied to UART0*/
+} MCG_clock_frequency_info;
+
 /*******************************************************************************
  * Variable
  ******************************************************************************/
@@ -176,6 +244,36 @@ void Driver_MCG_select_MCGFLLCLK_max_frequency(DMX32_type_enum_t MCGFLLCLK_max_r
  */
 void Driver_MCG_select_FLL_output_range(DCO_range_type_enum_t FLL_range);
 
+/**
+ * @brief Init the clock tree according to a clock profile, a PEE profile with PLL settings
+ *        the PLL can not lock with runs the FLL of the profile
+ *
+ * @param clock_config is a struct pointer that has the information about the clock profile.
+ *
+ * @return: This function return nothing.
+ */
+void Driver_MCG_Init_clock(MCG_clock_config_info *clock_config);
+
+/**
+ * @brief Init the MCGPLLCLK clock and switch MCGOUTCLK to the PLL (FEI -> FBE -> PBE -> PEE)
+ *
+ * @param clock_config is a struct pointer that has the information about the PEE profile.
+ *
+ * @return: This function return nothing.
+ */
+void Driver_MCG_Init_MCGPLLCLK(MCG_clock_config_info *clock_config);
+
+/**
+ * @brief Calculate the frequencies of the clock tree Driver_MCG_Init_clock sets for a clock profile,
+ *        invalid dividers are ignored as by Driver_SIM_CLKDIV1_set_dividers
+ *
+ * @param clock_config is a struct pointer that has the information about the clock profile.
+ * @param frequency is a struct pointer to store the calculated frequencies.
+ *
+ * @return: This function return nothing.
+ */
+void Driver_MCG_get_clock_frequency(MCG_clock_config_info *clock_config, MCG_clock_frequency_info *frequency);
+
 /*******************************************************************************
  * End of header guard
  ******************************************************************************/
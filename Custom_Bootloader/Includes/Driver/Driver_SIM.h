@@ -168,6 +168,16 @@ void Driver_SIM_SCGC5_init_clock(SCGC5_config_info *SCGC5_clock_config);
  */
 void Driver_SIM_SCGC5_set_PORTn_clock_gate(Port_type_enum_t port, clock_gate_state_enum_t PORTn_gate);
 
+/**
+ * @brief Set the core clock (OUTDIV1) and bus clock (OUTDIV4) dividers.
+ *
+ * @param core_divider is the MCGOUTCLK divide factor for the core clock (1 -> 16).
+ * @param bus_divider is the core clock divide factor for the bus and flash clock (1 -> 8).
+ *
+ * @return: This function return nothing.
+ */
+void Driver_SIM_CLKDIV1_set_dividers(uint8_t core_divider, uint8_t bus_divider);
+
 /*******************************************************************************
  * End of header guard
  ******************************************************************************/
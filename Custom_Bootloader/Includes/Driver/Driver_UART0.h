@@ -31,6 +31,16 @@
  */
 #define BUFFER_SIZE (256u)
 
+/**
+ * @brief Reference of the number of baud rates used for automatic step-down.
+ */
+#define UART0_STEP_DOWN_BAUD_COUNT (6u)
+
+/**
+ * @brief Reference of the number of received bytes the line error rate is measured over.
+ */
+#define UART0_ERROR_WINDOW_BYTES (256u)
+
 /*******************************************************************************
  * Enum
  ******************************************************************************/
@@ -147,8 +157,31 @@ typedef struct uart0_config
     uint8_t Tx_pin;                              /*Transmitter pin*/
     uint8_t Rx_pin;                              /*Receiver pin*/
     uint8_t OSR;                                 /*Oversampling ratio*/
+    uint16_t error_rate;                         /*Line errors per 1000 received bytes for a step-down, 0 to disable*/
 } uart0_config_info;
 
+/**
+ * @brief Contain the line-quality counters of UART0.
+ */
+typedef struct uart0_error_counter
+{
+    uint32_t overrun_count;   /*Number of overrun errors (OR)*/
+    uint32_t noise_count;     /*Number of noise errors (NF)*/
+    uint32_t framing_count;   /*Number of framing errors (FE)*/
+    uint32_t parity_count;    /*Number of parity errors (PF)*/
+    uint32_t step_down_count; /*Number of automatic baud rate step-downs*/
+} uart0_error_counter_info;
+
+/**
+ * @brief Contain the receive statistics of UART0.
+ */
+typedef struct uart0_rx_statistic
+{
+    uint32_t received_bytes;      /*Number of bytes received*/
+    uint32_t dropped_bytes;       /*Number of bytes dropped: lines that found the queue full, bytes past QUEUE_LINE_SIZE*/
+    uint8_t peak_queue_occupancy; /*Highest number of ready lines waiting in the queue*/
+} uart0_rx_statistic_info;
+
 /*******************************************************************************
  * Variable
  ******************************************************************************/
@@ -167,6 +200,16 @@ typedef struct uart0_config
  */
 void Driver_UART0_init(uart0_config_info *uart0_config, uint32_t clock_frequency);
 
+/**
+ * @brief De-init the UART0: wait for the last character, disable the module and its interrupts,
+ *        release the Rx/Tx pins and gate off the UART0 clock
+ *
+ * @param: This function has no param
+ *
+ * @return: This function return nothing.
+ */
+void Driver_UART0_deinit(void);
+
 /**
  * @brief Select the length of data to receive and send by UART0
  *
@@ -334,7 +377,7 @@ uint8_t Driver_UART0_check_first_buffer(void);
 /**
  * @brief Get string in the Rx buffer
  *
- * @param str is the array to store the string get from Rx buffer
+ * @param str is the array to store the string get from Rx buffer, QUEUE_LINE_SIZE bytes
  *
  * @return: This function return nothing
  */
@@ -349,6 +392,136 @@ void Driver_UART0_receive_string(uint8_t *str);
  */
 void Driver_UART0_dequeue(void);
 
+/**
+ * @brief Send an unsigned decimal number by UART0
+ *
+ * @param number is the value to be sent
+ *
+ * @return: This function return nothing
+ */
+void Driver_UART0_send_number(uint32_t number);
+
+/**
+ * @brief Send an unsigned 64-bit decimal number by UART0
+ *
+ * @param number is the value to be sent
+ *
+ * @return: This function return nothing
+ */
+void Driver_UART0_send_number64(uint64_t number);
+
+/**
+ * @brief Send a 32-bit number by UART0 as 0x and 8 hexadecimal digits
+ *
+ * @param number is the value to be sent
+ *
+ * @return: This function return nothing
+ */
+void Driver_UART0_send_hex(uint32_t number);
+
+/**
+ * @brief Get the line-quality counters of UART0
+ *
+ * @param counters is a struct pointer to store the counters
+ *
+ * @return: This function return nothing
+ */
+void Driver_UART0_get_error_counters(uart0_error_counter_info *counters);
+
+/**
+ * @brief Reset the line-quality counters of UART0
+ *
+ * @param: This function has no param
+ *
+ * @return: This function return nothing
+ */
+void Driver_UART0_reset_error_counters(void);
+
+/**
+ * @brief Get the current baud rate of UART0
+ *
+ * @param: This function has no param
+ *
+ * @return the current baud rate (it may be lower than configured after a step-down)
+ */
+uint32_t Driver_UART0_get_baud_rate(void);
+
+/**
+ * @brief Get a baud rate of the step-down list, the rates UART0 is known to run at
+ *
+ * @param index is the position in the list, 0 is the fastest
+ *
+ * @return the baud rate, 0 if index is out of the list
+ */
+uint32_t Driver_UART0_get_supported_baud(uint8_t index);
+
+/**
+ * @brief Set the line error rate that triggers a baud rate step-down, the host must follow the
+ *        baud changes to enable it
+ *
+ * @param error_rate is the line errors per 1000 received bytes, 0 to disable the step-down
+ *
+ * @return: This function return nothing
+ */
+void Driver_UART0_set_error_rate(uint16_t error_rate);
+
+/**
+ * @brief Get the line error rate that triggers a baud rate step-down
+ *
+ * @param: This function has no param
+ *
+ * @return the line errors per 1000 received bytes, 0 if the step-down is disabled
+ */
+uint16_t Driver_UART0_get_error_rate(void);
+
+/**
+ * @brief Get the baud rate a pending step-down switches to, so that it is announced at the old rate
+ *
+ * @param: This function has no param
+ *
+ * @return the new baud rate, 0 if no step-down is pending
+ */
+uint32_t Driver_UART0_get_step_down_baud(void);
+
+/**
+ * @brief Switch UART0 to the baud rate of the pending step-down, once the last character is out
+ *
+ * @param: This function has no param
+ *
+ * @return: This function return nothing
+ */
+void Driver_UART0_step_down(void);
+
+/**
+ * @brief Get the receive statistics of UART0
+ *
+ * @param statistics is the struct pointer to store the statistics
+ *
+ * @return: This function return nothing
+ */
+void Driver_UART0_get_rx_statistics(uart0_rx_statistic_info *statistics);
+
+/**
+ * @brief Reset the receive statistics of UART0
+ *
+ * @param: This function has no param
+ *
+ * @return: This function return nothing
+ */
+void Driver_UART0_reset_rx_statistics(void);
+
+/**
+ * @brief Share the line with other nodes: 9-bit frames, only the data following a broadcast
+ *        address frame or the node address frame is received, and the transmitter stays
+ *        silent until the node address has been received
+ *
+ * @param node_address is the address of this node
+ * @param broadcast_address is the address received by all nodes
+ *
+ * @return: This function return nothing
+ */
+void Driver_UART0_enable_address_match(uint8_t node_address, uint8_t broadcast_address);
+
 /*******************************************************************************
  * End of header guard
  ******************************************************************************/
@@ -36,6 +36,7 @@ typedef enum Driver_port_type
 
 typedef enum Driver_pull_type
 {
+    PULL_DISABLED = 0u, /*<< Value to disable the pull resistor >>*/
     PULL_UP = 3u, /*<< Value to set Pull Up mode >>*/
     PULL_DOWN = 2 /*<< Valueto set Pull Down mode >>*/
 } Pull_type_enum_t;
@@ -21,6 +21,20 @@
 #ifndef _DRIVER_CORE_H_
 #define _DRIVER_CORE_H_
 
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/**
+ * @brief Reference of the SysTick reload value (24-bit counter)
+ */
+#define SYSTICK_RELOAD_VALUE (0x00FFFFFFu)
+
+/**
+ * @brief Reference of the pattern written to the unused stack
+ */
+#define STACK_PAINT_PATTERN (0xC5C5C5C5u)
+
 /*******************************************************************************
  * Enum
  ******************************************************************************/
@@ -39,5 +53,107 @@ void Driver_Set_MSP(uint32_t MSP_value);
 void Driver_Set_PSP(uint32_t PSP_value);
 void Driver_Set_VectorTable_offset(uint32_t offset_value);
 
+/**
+ * @brief Disable the interrupts and keep their previous state, usable from an ISR
+ *
+ * @param: This function has no parameter
+ *
+ * @return the previous PRIMASK value for Driver_Restore_IRQs
+ */
+uint32_t Driver_Save_and_disable_IRQs(void);
+
+/**
+ * @brief Restore the interrupt state saved by Driver_Save_and_disable_IRQs
+ *
+ * @param primask: PRIMASK value returned by Driver_Save_and_disable_IRQs
+ *
+ * @return: This function return nothing
+ */
+void Driver_Restore_IRQs(uint32_t primask);
+
+/**
+ * @brief Sleep until an interrupt is pending (WFI), SysTick and the peripherals keep running.
+ *        A pending interrupt wakes the core even with the interrupts disabled
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Driver_Wait_for_interrupt(void);
+
+/**
+ * @brief Start SysTick as a free-running timestamp counter clocked by the core clock
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Driver_SysTick_start(void);
+
+/**
+ * @brief Get the number of core clock cycles since Driver_SysTick_start, wraps after 2^32 cycles
+ *        (89 s at 48 MHz): only differences of less than that are valid
+ *
+ * @param: This function has no parameter
+ *
+ * @return the timestamp in core clock cycles
+ */
+uint32_t Driver_SysTick_get_ticks(void);
+
+/**
+ * @brief Get the number of core clock cycles since Driver_SysTick_start, for durations of any length.
+ *        With the interrupts masked it stays valid for one SysTick period (2^24 cycles)
+ *
+ * @param: This function has no parameter
+ *
+ * @return the timestamp in core clock cycles
+ */
+uint64_t Driver_SysTick_get_ticks64(void);
+
+/**
+ * @brief Stop SysTick and its interrupt
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Driver_SysTick_stop(void);
+
+/**
+ * @brief Disable every NVIC interrupt and clear the pending ones
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Driver_NVIC_clear_all_IRQs(void);
+
+/**
+ * @brief Fill the stack below the current stack pointer with STACK_PAINT_PATTERN
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Driver_Stack_paint(void);
+
+/**
+ * @brief Get the stack high-water mark since Driver_Stack_paint
+ *
+ * @param: This function has no parameter
+ *
+ * @return the number of stack bytes that have been used
+ */
+uint32_t Driver_Stack_get_used(void);
+
+/**
+ * @brief Get the stack size reserved by the linker
+ *
+ * @param: This function has no parameter
+ *
+ * @return the stack size in byte
+ */
+uint32_t Driver_Stack_get_size(void);
+
 #endif
 /*EOF*/
\ No newline at end of file
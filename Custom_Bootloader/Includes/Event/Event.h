@@ -0,0 +1,128 @@
+/**
+ * @file  : Event.h
+ * @author: Nguyen The Anh.
+ * @brief : Declare enum, typdef, macro and function using in Event.c.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _EVENT_H_
+#define _EVENT_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Bit of an event in the mask returned by Event_dispatch*/
+#define EVENT_MASK(event) (1u << (uint32_t)(event))
+
+/*******************************************************************************
+ * Enum
+ ******************************************************************************/
+
+/**
+ * @brief Reference of the events posted by the interrupts to the main loop
+ */
+typedef enum event_id
+{
+    EVENT_UART_RX = 0u,    /*UART0 has received a full line*/
+    EVENT_FLASH_DONE = 1u, /*A flash command running in background has finished*/
+    EVENT_TICK = 2u,       /*SysTick reload, every 2^24 core clock cycles*/
+    EVENT_COUNT = 3u,      /*Number of events*/
+} event_id_enum_t;
+
+/*******************************************************************************
+ * Struct
+ ******************************************************************************/
+
+/**
+ * @brief Reference of a handler run by Event_dispatch, it runs to completion and must not wait
+ */
+typedef void (*event_handler_t)(void);
+
+/**
+ * @brief Reference of the sleep statistics, since Event_init
+ */
+typedef struct event_statistic
+{
+    uint64_t sleep_cycles; /*Core clock cycles spent sleeping in Event_wait*/
+    uint32_t sleep_count;  /*Number of times the core went to sleep*/
+    uint32_t dispatched;   /*Number of handlers run by Event_dispatch*/
+} event_statistic_info;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Clear the pending events, the handler table and the statistics
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Event_init(void);
+
+/**
+ * @brief Set the handler of an event, 0 to remove it
+ *
+ * @param event: Event to handle
+ * @param handler: Function run by Event_dispatch when the event is pending
+ *
+ * @return: This function return nothing
+ */
+void Event_register(event_id_enum_t event, event_handler_t handler);
+
+/**
+ * @brief Mark an event pending, called from the interrupt handlers
+ *
+ * @param event: Event that has happened
+ *
+ * @return: This function return nothing
+ */
+void Event_post(event_id_enum_t event);
+
+/**
+ * @brief Take the pending events and run their handlers, in event order
+ *
+ * @param: This function has no parameter
+ *
+ * @return the EVENT_MASK of the events taken, 0 if none was pending
+ */
+uint32_t Event_dispatch(void);
+
+/**
+ * @brief Sleep until an event is pending, return at once if one already is
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Event_wait(void);
+
+/**
+ * @brief Get the sleep statistics
+ *
+ * @param statistics: Struct to fill
+ *
+ * @return: This function return nothing
+ */
+void Event_get_statistics(event_statistic_info *statistics);
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
@@ -0,0 +1,98 @@
+/**
+ * @file  : Flash_layout.h
+ * @author: Nguyen The Anh.
+ * @brief : Flash and RAM layout shared by the code and the linker file.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ * The linker file MKL46Z256xxx4_flash.ld is generated from MKL46Z256xxx4_flash.ld.in by the
+ * C preprocessor with LINKER_SCRIPT defined, so the values here are plain integer constants.
+ * Moving the bootloader/App boundary is done by APP_BASE_ADDRESS in makefile.defs only.
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _FLASH_LAYOUT_H_
+#define _FLASH_LAYOUT_H_
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Program flash: two 128 KB blocks of 1 KB sectors*/
+#define FLASH_BASE_ADDRESS          (0x00000000)
+#define FLASH_TOTAL_SIZE            (0x00040000)
+#define FLASH_BLOCK_SIZE            (0x00020000)
+#define FLASH_SECTOR_SIZE           (0x400)
+
+/*\Block the bootloader executes from: the FTFA can erase or program the other block meanwhile*/
+#define FLASH_BOOT_BLOCK            (0)
+
+/*\Bootloader vector table, flash configuration field and code*/
+#define BOOT_VECTOR_TABLE_ADDRESS   (0x00000000)
+#define BOOT_VECTOR_TABLE_SIZE      (0x00000100)
+#define FLASH_CONFIG_ADDRESS        (0x00000400)
+#define FLASH_CONFIG_SIZE           (0x00000010)
+#define BOOT_TEXT_ADDRESS           (0x00000410)
+
+/*\Base address of application code, the build passes APP_BASE_ADDRESS of makefile.defs*/
+#ifndef BASE_APP_ADDRESS
+#define BASE_APP_ADDRESS            (0x0000A000)
+#endif
+
+/*\App information sector: the sector just below the App*/
+#define APP_INFO_ADDRESS            (BASE_APP_ADDRESS - FLASH_SECTOR_SIZE)
+
+/*\Bootloader code and App region sizes*/
+#define BOOT_TEXT_SIZE              (APP_INFO_ADDRESS - BOOT_TEXT_ADDRESS)
+#define APP_REGION_SIZE             (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE - BASE_APP_ADDRESS)
+
+/*Flash location that stores the start address of application code*/
+#define APP_START_ADDRESS_LOCATION  (APP_INFO_ADDRESS)
+
+/*Flash location that stores the size of application in sector*/
+#define APP_SIZE_LOCATION           (APP_START_ADDRESS_LOCATION + 4)
+
+/*Flash location stores the flag that indicates firmware updated successfully*/
+#define APP_UPDATED_FLAG_LOCATION   (APP_SIZE_LOCATION + 4)
+
+/*Flash location that stores header of the file*/
+#define APP_HEADER_LOCATION         (APP_UPDATED_FLAG_LOCATION + 4)
+
+/*\Largest header stored: data of a S0 record with 255 bytes count*/
+#define APP_HEADER_MAX_SIZE         (252)
+
+/*\Alignment of the vector table offset register*/
+#define VECTOR_TABLE_ALIGNMENT      (0x100)
+
+/*\RAM: SRAM_L and SRAM_U*/
+#define RAM_BASE_ADDRESS            (0x1FFFE000)
+#define RAM_TOTAL_SIZE              (0x00008000)
+
+/*\Boot information block passed to the App at the start of RAM (Boot_info.h)*/
+#define BOOT_INFO_SIZE              (0x00000020)
+
+/*******************************************************************************
+ * Layout checks
+ ******************************************************************************/
+
+#ifndef LINKER_SCRIPT
+
+_Static_assert((BASE_APP_ADDRESS % FLASH_SECTOR_SIZE) == 0, "BASE_APP_ADDRESS must be aligned on a flash sector");
+_Static_assert((BASE_APP_ADDRESS % VECTOR_TABLE_ALIGNMENT) == 0, "BASE_APP_ADDRESS must be aligned for VTOR");
+_Static_assert(APP_INFO_ADDRESS <= (FLASH_BASE_ADDRESS + (FLASH_BOOT_BLOCK + 1) * FLASH_BLOCK_SIZE), "Bootloader must execute from a single flash block");
+_Static_assert(APP_INFO_ADDRESS > BOOT_TEXT_ADDRESS, "App information sector overlaps the bootloader start");
+_Static_assert(BASE_APP_ADDRESS < (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE), "App region is out of flash");
+_Static_assert((APP_HEADER_LOCATION + APP_HEADER_MAX_SIZE) <= BASE_APP_ADDRESS, "App header does not fit in the information sector");
+_Static_assert((FLASH_CONFIG_ADDRESS + FLASH_CONFIG_SIZE) == BOOT_TEXT_ADDRESS, "Bootloader code must follow the flash configuration field");
+
+#endif
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
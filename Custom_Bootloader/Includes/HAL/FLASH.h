@@ -9,14 +9,65 @@
 /*******************************************************************************
  * Defines
  ******************************************************************************/
+#define CMD_PROGRAM_CHECK        (0x02)
 #define CMD_PROGRAM_LONGWORD     (0x06)
+#define CMD_ERASE_FLASH_BLOCK    (0x08)
 #define CMD_ERASE_FLASH_SECTOR   (0x09)
 #define FLASH_DELETED_VALUE     (0xFFFFFFFFu)
+#define FLASH_MARGIN_USER       (0x01)
+#define FLASH_MARGIN_FACTORY    (0x02)
+#define FLASH_COMMAND_DATA_SIZE (8u)
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+
+/*!
+ * @brief
+ * flash command object: FCCOB0 command, FCCOB1-3 address, FCCOB4-B parameters
+ */
+typedef struct
+{
+    uint8_t Cmd;                              /* FCCOB0: command code */
+    uint32_t Addr;                            /* FCCOB1-FCCOB3: flash address */
+    uint8_t Data[FLASH_COMMAND_DATA_SIZE];    /* FCCOB4-FCCOBB: command parameters */
+    uint8_t DataCount;                        /* number of parameters used */
+} flash_command_info;
 
 /*******************************************************************************
  * API
  ******************************************************************************/
 
+/*!
+ * @brief
+ * launch a flash command and wait until it finishes. Interrupts are masked
+ * only when the command targets the block the bootloader executes from.
+ * @param Command: command object to load in FCCOB registers
+ * @return
+ * return 1: if success, 0: if the command fails (ACCERR, FPVIOL or MGSTAT0)
+ */
+uint8_t Flash_Launch_Command(flash_command_info *Command);
+
+/*!
+ * @brief
+ * launch a flash command without waiting when it targets the other block
+ * (read while write), its result is collected by the next flash access.
+ * A command on the boot block runs to the end as Flash_Launch_Command.
+ * @param Command: command object to load in FCCOB registers
+ * @return
+ * return 1: if launched (or finished) without error, 0: if fail
+ */
+uint8_t Flash_Start_Command(flash_command_info *Command);
+
+/*!
+ * @brief
+ * get the program flash block of an address
+ * @param Addr: flash address
+ * @return
+ * return block number
+ */
+uint8_t Flash_Get_Block(uint32_t Addr);
+
 uint8_t Read_Flash_byte(uint32_t Addr);
 
 /*!
@@ -48,6 +99,17 @@ uint8_t Program_LongWord_8B(uint32_t Addr,uint8_t *Data);
  */
 uint8_t Program_LongWord(uint32_t Addr,uint32_t Data);
 
+/*!
+ * @brief
+ * check a programmed longword at a margin read level
+ * @param Addr: address of the longword
+ * @param Data: expected value of the longword
+ * @param Margin: FLASH_MARGIN_USER or FLASH_MARGIN_FACTORY
+ * @return
+ * return 1: if the longword reads Data at the margin level, 0: if not
+ */
+uint8_t Program_Check_LongWord(uint32_t Addr, uint32_t Data, uint8_t Margin);
+
 /*!
  * @brief
  * erase a sector in flash
@@ -59,11 +121,50 @@ uint8_t Erase_Sector(uint32_t Addr);
 
 /*!
  * @brief
- * erase multi sectors in flash
+ * erase a program flash block, the boot block is refused
+ * @param Addr: address in the block to erase
+ * @return
+ * return 1: if success
+ */
+uint8_t Erase_Block(uint32_t Addr);
+
+/*!
+ * @brief
+ * erase multi sectors in flash, a whole block outside the boot block
+ * is erased with one block erase command
  * @param Addr: address to erase
+ * @param Size: number of sectors to erase
  * @return
  * return 1: if success
  */
-uint8_t Erase_Multi_Sector(uint32_t Addr,uint8_t Size);
+uint8_t Erase_Multi_Sector(uint32_t Addr,uint32_t Size);
+
+/*!
+ * @brief
+ * erase multi sectors, the sectors outside the boot block are erased in
+ * background by Flash_Background_Erase_poll while the bootloader runs
+ * @param Addr: address to erase
+ * @param Size: number of sectors to erase
+ * @return
+ * return 1: if the sectors of the boot block are erased
+ */
+uint8_t Erase_Multi_Sector_Background(uint32_t Addr, uint32_t Size);
+
+/*!
+ * @brief
+ * collect the finished background sector erase and launch the next one
+ * @return
+ * return number of sectors left to erase, 0: if the background erase is done
+ */
+uint32_t Flash_Background_Erase_poll(void);
+
+/*!
+ * @brief
+ * finish the background erase up to the sector of an address
+ * @param Addr: last address that must be erased, FLASH_DELETED_VALUE for all
+ * @return
+ * return 1: if all background erases succeeded so far
+ */
+uint8_t Flash_Background_Erase_wait(uint32_t Addr);
 
 #endif
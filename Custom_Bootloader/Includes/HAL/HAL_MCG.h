@@ -29,6 +29,69 @@
  * Prototypes
  ******************************************************************************/
 
+/* ----------------------------------------------------------------------------
+   -- MCG_C1 register bit setting function group
+   ---------------------------------------------------------------------------- */
+
+/**
+ * @brief Select the MCGOUTCLK source
+ *
+ * @param CLKS_value is the value to write to CLKS bit field (0: FLL or PLL, 1: internal, 2: external reference)
+ *
+ * @return: this function return nothing.
+ */
+void HAL_MCG_C1_set_CLKS(uint8_t CLKS_value);
+
+/**
+ * @brief Select the divider of the external reference clock for the FLL
+ *
+ * @param FRDIV_value is the value to write to FRDIV bit field (0 -> 7)
+ *
+ * @return: this function return nothing.
+ */
+void HAL_MCG_C1_set_FRDIV(uint8_t FRDIV_value);
+
+/**
+ * @brief Select the reference clock for the FLL
+ *
+ * @param IREFS_value is the state to write to IREFS bit field (0: external, 1: slow internal)
+ *
+ * @return: this function return nothing.
+ */
+void HAL_MCG_C1_set_IREFS(uint8_t IREFS_value);
+
+/*!
+ * @}
+ */
+/* end of group MCG_C1 register bit setting functions */
+
+/* ----------------------------------------------------------------------------
+   -- MCG_C2 register bit setting function group
+   ---------------------------------------------------------------------------- */
+
+/**
+ * @brief Select the frequency range of the crystal oscillator
+ *
+ * @param RANGE0_value is the value to write to RANGE0 bit field (0: low, 1: high, 2: very high)
+ *
+ * @return: this function return nothing.
+ */
+void HAL_MCG_C2_set_RANGE0(uint8_t RANGE0_value);
+
+/**
+ * @brief Select whether the external reference is an external clock or the crystal oscillator
+ *
+ * @param EREFS0_value is the state to write to EREFS0 bit field (0: external clock, 1: oscillator)
+ *
+ * @return: this function return nothing.
+ */
+void HAL_MCG_C2_set_EREFS0(uint8_t EREFS0_value);
+
+/*!
+ * @}
+ */
+/* end of group MCG_C2 register bit setting functions */
+
 /* ----------------------------------------------------------------------------
    -- MCG_C4 register bit setting function group
    ---------------------------------------------------------------------------- */
@@ -70,6 +133,15 @@ void HAL_MCG_C4_set_DRST_DRS(uint8_t range_select);
  */
 void HAL_MCG_C5_set_PLLCLKEN0(uint8_t PLL_option);
 
+/**
+ * @brief Set the external reference divider of the PLL
+ *
+ * @param PRDIV0_value is the value to write to PRDIV0 bit field (divide factor - 1, 0 -> 24)
+ *
+ * @return: this function return nothing.
+ */
+void HAL_MCG_C5_set_PRDIV0(uint8_t PRDIV0_value);
+
 /*!
  * @}
  */
@@ -88,11 +160,74 @@ void HAL_MCG_C5_set_PLLCLKEN0(uint8_t PLL_option);
  */
 void HAL_MCG_C6_set_PLLS(uint8_t pll_option);
 
+/**
+ * @brief Set the VCO multiplier of the PLL
+ *
+ * @param VDIV0_value is the value to write to VDIV0 bit field (multiply factor - 24, 0 -> 31)
+ *
+ * @return: this function return nothing.
+ */
+void HAL_MCG_C6_set_VDIV0(uint8_t VDIV0_value);
+
 /*!
  * @}
  */
 /* end of group MCG_C6 register bit setting functions */
 
+/* ----------------------------------------------------------------------------
+   -- MCG_S register bit reading function group
+   ---------------------------------------------------------------------------- */
+
+/**
+ * @brief Read the current source of MCGOUTCLK
+ *
+ * @param: This function has no parameter.
+ *
+ * @return CLKST value (0: FLL, 1: internal reference, 2: external reference, 3: PLL)
+ */
+uint8_t HAL_MCG_S_read_CLKST(void);
+
+/**
+ * @brief Read the current reference clock of the FLL
+ *
+ * @param: This function has no parameter.
+ *
+ * @return 1 if the internal reference is used, 0 if the external reference is used
+ */
+uint8_t HAL_MCG_S_read_IREFST(void);
+
+/**
+ * @brief Read whether the crystal oscillator is initialized
+ *
+ * @param: This function has no parameter.
+ *
+ * @return state of OSCINIT0 flag
+ */
+uint8_t HAL_MCG_S_read_OSCINIT0(void);
+
+/**
+ * @brief Read whether the PLLS clock source is the PLL output
+ *
+ * @param: This function has no parameter.
+ *
+ * @return state of PLLST flag
+ */
+uint8_t HAL_MCG_S_read_PLLST(void);
+
+/**
+ * @brief Read whether the PLL has acquired lock
+ *
+ * @param: This function has no parameter.
+ *
+ * @return state of LOCK0 flag
+ */
+uint8_t HAL_MCG_S_read_LOCK0(void);
+
+/*!
+ * @}
+ */
+/* end of group MCG_S register bit reading functions */
+
 /*******************************************************************************
  * End of header guard
  ******************************************************************************/
@@ -121,6 +121,25 @@ void HAL_SIM_SCGC5_set_clock_PORTE(uint8_t portE_gate_value);
  */
 /* end of group SCGC5 register bit setting function */
 
+/* ----------------------------------------------------------------------------
+   -- CLKDIV1 register bit setting function group
+   ---------------------------------------------------------------------------- */
+
+/**
+ * @brief Set the core/platform and bus/flash clock dividers
+ *
+ * @param OUTDIV1_value is the core clock divider value (divide factor - 1, 0 -> 15).
+ * @param OUTDIV4_value is the bus clock divider value (divide factor - 1, 0 -> 7).
+ *
+ * @return: this function return nothing.
+ */
+void HAL_SIM_CLKDIV1_set_OUTDIV(uint8_t OUTDIV1_value, uint8_t OUTDIV4_value);
+
+/*!
+ * @}
+ */
+/* end of group CLKDIV1 register bit setting function */
+
 /*Header guard*/
 #endif
 /*EOF*/
\ No newline at end of file
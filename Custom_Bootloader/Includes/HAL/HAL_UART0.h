@@ -155,6 +155,33 @@ void HAL_UART0_C2_set_RE(uint8_t RE_value);
  */
 /* end of group UART0_C2 register bit setting functions */
 
+/* ----------------------------------------------------------------------------
+   -- UART0_C3 register bit setting function group
+   ---------------------------------------------------------------------------- */
+
+/**
+ * @brief Select whether overrun, noise, framing and parity error interrupts are enabled
+ *
+ * @param error_IRQ_value is the state to write to ORIE, NEIE, FEIE and PEIE bit fields (0 / 1).
+ *
+ * @return: this function return nothing.
+ */
+void HAL_UART0_C3_set_error_IRQ(uint8_t error_IRQ_value);
+
+/**
+ * @brief Read the ninth bit of the received character (9-bit mode), it must be read before D register
+ *
+ * @param: This function has no parameter.
+ *
+ * @return the state of the R8T9 bit (1: address frame in match address mode).
+ */
+uint8_t HAL_UART0_C3_read_R8(void);
+
+/*!
+ * @}
+ */
+/* end of group UART0_C3 register bit setting functions */
+
 /* ----------------------------------------------------------------------------
    -- UART0_C4 register bit setting function group
    ---------------------------------------------------------------------------- */
@@ -168,11 +195,39 @@ void HAL_UART0_C2_set_RE(uint8_t RE_value);
  */
 void HAL_UART0_C4_set_OSR(uint8_t OSR_value);
 
+/**
+ * @brief Select whether the match address mode is enabled for MA1 and MA2
+ *
+ * @param MAEN_value is the state to write to MAEN1 and MAEN2 bit fields (0 / 1).
+ *
+ * @return: this function return nothing.
+ */
+void HAL_UART0_C4_set_MAEN(uint8_t MAEN_value);
+
 /*!
  * @}
  */
 /* end of group UART0_C4 register bit setting functions */
 
+/* ----------------------------------------------------------------------------
+   -- UART0_MA1 and UART0_MA2 register bit setting function group
+   ---------------------------------------------------------------------------- */
+
+/**
+ * @brief Set the addresses compared to the received address frames in match address mode
+ *
+ * @param MA1_value is the value to write to MA1 register.
+ * @param MA2_value is the value to write to MA2 register.
+ *
+ * @return: this function return nothing.
+ */
+void HAL_UART0_MA_set_addresses(uint8_t MA1_value, uint8_t MA2_value);
+
+/*!
+ * @}
+ */
+/* end of group UART0_MA1 and UART0_MA2 register bit setting functions */
+
 /* ----------------------------------------------------------------------------
    -- UART0_S1 register bit setting function group
    ---------------------------------------------------------------------------- */
@@ -195,6 +250,33 @@ uint8_t HAL_UART0_S1_read_TDRE(void);
  */
 uint8_t HAL_UART0_S1_read_RDRF(void);
 
+/**
+ * @brief Read the transmission complete flag (last character has been shifted out)
+ *
+ * @param: This function has no parameter.
+ *
+ * @return the state of the TC flag.
+ */
+uint8_t HAL_UART0_S1_read_TC(void);
+
+/**
+ * @brief Read the overrun, noise, framing and parity error flags
+ *
+ * @param: This function has no parameter.
+ *
+ * @return the OR, NF, FE and PF bits of S1 register (other bits are masked).
+ */
+uint8_t HAL_UART0_S1_read_error_flags(void);
+
+/**
+ * @brief Clear error flags in S1 register
+ *
+ * @param error_flags is the mask of OR, NF, FE and PF flags to clear.
+ *
+ * @return: this function return nothing.
+ */
+void HAL_UART0_S1_clear_error_flags(uint8_t error_flags);
+
 /*!
  * @}
  */
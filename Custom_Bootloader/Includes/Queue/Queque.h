@@ -35,6 +35,12 @@
  */
 #define QUEUE_EMPTY_MARK (MAX_QUEQUE_SIZE)
 
+/**
+ * @brief Reference of the size of a queue element, a line and its NULL character: the longest
+ *        srec line has 514 characters (255 bytes after the byte count).
+ */
+#define QUEUE_LINE_SIZE (515u)
+
 /*******************************************************************************
  * Enum
  ******************************************************************************/
@@ -57,7 +63,7 @@ typedef enum queue_state
  */
 typedef struct srec_queue
 {
-    volatile uint8_t record[MAX_QUEQUE_SIZE][80];   /*Store lines from srec file*/
+    volatile uint8_t record[MAX_QUEQUE_SIZE][QUEUE_LINE_SIZE];   /*Store lines from srec file*/
     volatile uint8_t first;                         /*Index of first element in queue*/
     volatile uint8_t end;                           /*Index of last element in queue*/
     volatile uint8_t queue_state[MAX_QUEQUE_SIZE];  /*Status of each element in queue*/
@@ -51,6 +51,15 @@
 /*\Size of a word in byte*/
 #define WORD_ALIGN              (4u)
 
+/*\Longest srec line: start code, type, byte count and 255 bytes in hex*/
+#define SREC_MAX_LINE_LENGTH    (514u)
+
+/*\Shortest srec line: start code, type, byte count, 16-bit address and checksum*/
+#define SREC_MIN_LINE_LENGTH    (10u)
+
+/*\Size of a buffer holding a srec line and its NULL character, rounded up to a word*/
+#define SREC_LINE_BUFFER_SIZE   (((SREC_MAX_LINE_LENGTH + 1u) + (WORD_ALIGN - 1u)) & ~(WORD_ALIGN - 1u))
+
 /*******************************************************************************
  * Enum
  ******************************************************************************/
@@ -87,7 +96,7 @@ typedef struct srec_line
     uint32_t address;   /*Record address*/
     uint8_t data[255];  /*Record data*/
     uint8_t check_sum;  /*Record check sum*/
-    uint8_t data_word;  /*Size of record data in word align*/
+    uint8_t data_word;  /*Size of record data in words, a partial last word is completed with 0xFF*/
 } srec_line;
 
 /*******************************************************************************
@@ -101,7 +110,7 @@ typedef struct srec_line
 /**
  * @brief Check srec line
  *
- * @param record: Struct pointer has infomation about a srec line
+ * @param record: Struct pointer has infomation about a srec line, parsed from line by parse_Srecord_line
  * @param line: Srec record
  *
  * @return 0 if no error, 1 if error
@@ -112,10 +121,11 @@ uint8_t check_srec_line(srec_line *record, uint8_t *line);
  * @brief Parse a srec record
  *
  * @param record_line: Input srec record
+ * @param record: Struct pointer to store the parsed record
  *
- * @return a parsed record struct
+ * @return: This function return nothing
  */
-srec_line parse_Srecord_line(uint8_t *record_line);
+void parse_Srecord_line(uint8_t *record_line, srec_line *record);
 
 /*******************************************************************************
  * End of header guard
@@ -0,0 +1,108 @@
+/**
+ * @file  : Trace.h
+ * @author: Nguyen The Anh.
+ * @brief : Declare enum, typdef, macro and function using in Trace.c.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Number of first records kept, the boot phases are never overwritten by the update records*/
+#define TRACE_PINNED_SIZE (16u)
+
+/*\Number of records in the trace ring after the kept ones (power of 2), the oldest is overwritten*/
+#define TRACE_BUFFER_SIZE (64u)
+
+/*******************************************************************************
+ * Enum
+ ******************************************************************************/
+
+/**
+ * @brief Reference of the traced boot and update phases
+ */
+typedef enum trace_event
+{
+    TRACE_EVENT_SWITCH_READ = 0u,    /*Boot switch has been read*/
+    TRACE_EVENT_CLOCK_INIT = 1u,     /*Clock tree has been initialized, param: core clock*/
+    TRACE_EVENT_UART_INIT = 2u,      /*UART0 and LEDs have been initialized, param: baud rate*/
+    TRACE_EVENT_BANNER = 3u,         /*Banner has been sent*/
+    TRACE_EVENT_ERASE_START = 4u,    /*Old application erase started, param: old App size in sector*/
+    TRACE_EVENT_ERASE_END = 5u,      /*Old application erase finished*/
+    TRACE_EVENT_RECORD_FIRST = 6u,   /*First data record received, param: record address*/
+    TRACE_EVENT_SECTOR_PROGRAM = 7u, /*Programming entered a new sector, param: sector address*/
+    TRACE_EVENT_RECORD_LAST = 8u,    /*Termination record received, param: programmed bytes*/
+    TRACE_EVENT_JUMP = 9u,           /*Jump to application, param: vector table address*/
+    TRACE_EVENT_COMMIT = 10u,        /*Staged image write to flash started, param: staged bytes*/
+    TRACE_EVENT_COUNT = 11u,         /*Number of event types*/
+} trace_event_enum_t;
+
+/*******************************************************************************
+ * Struct
+ ******************************************************************************/
+
+/**
+ * @brief Reference of a trace record
+ */
+typedef struct trace_record
+{
+    uint32_t timestamp; /*Core clock cycles since Driver_SysTick_start*/
+    uint32_t param;     /*Event parameter*/
+    uint32_t event;     /*Event type*/
+} trace_record;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Clear the trace ring
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Trace_init(void);
+
+/**
+ * @brief Add a timestamped record to the trace ring
+ *
+ * @param event: Event type
+ * @param param: Event parameter
+ *
+ * @return: This function return nothing
+ */
+void Trace_record(trace_event_enum_t event, uint32_t param);
+
+/**
+ * @brief Send the trace records over UART0 as a timeline with the delta between phases, the kept
+ *        records first then the ring, Scripts/trace_decode.awk reads it
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Trace_dump(void);
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
@@ -0,0 +1,256 @@
+/**
+ * @file  : Update.h
+ * @author: Nguyen The Anh.
+ * @brief : Declare enum, typdef, macro and function using in Update.c.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _UPDATE_H_
+#define _UPDATE_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdint.h>
+#include "../Includes/Srec/Srec.h"
+#include "Flash_layout.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\RAM image of a staged update: smaller images are received and checked before flash is touched.
+ *A streamed update keeps the received data of its last sectors there until they are verified*/
+#define STAGING_BUFFER_SIZE (0x4000u)
+
+/*\Address of this bootloader on a multi-drop line, 0 for a point-to-point line (makefile.defs)*/
+#ifndef BOOT_NODE_ADDRESS
+#define BOOT_NODE_ADDRESS (0u)
+#endif
+
+/*\Address frame received by every bootloader of a multi-drop line*/
+#define BOOT_BROADCAST_ADDRESS (0xFFu)
+
+#if (BOOT_NODE_ADDRESS >= BOOT_BROADCAST_ADDRESS)
+#error "BOOT_NODE_ADDRESS must be 0 (point-to-point) or 1 to 254"
+#endif
+
+/*\Indicating the app has been updated successfully*/
+#define APP_UPDATE_SUCCESS (1u)
+
+/*\Returned by a step of the update while the update goes on, not a boot_result_t*/
+#define UPDATE_CONTINUE (0xFFu)
+
+/*******************************************************************************
+ * Enum
+ ******************************************************************************/
+
+/**
+ * @brief Reference of the result of Boot_main and of App mode, printed in the RESULT line
+ */
+typedef enum boot_result
+{
+    BOOT_RESULT_BAD_LINE = 0u,      /*A line failed its format, checksum or count check, or was dropped*/
+    BOOT_RESULT_SUCCESS = 1u,       /*The App has been programmed, verified and marked valid*/
+    BOOT_RESULT_BAD_ADDRESS = 2u,   /*A data record below BASE_APP_ADDRESS, past flash or outside the manifest range*/
+    BOOT_RESULT_BAD_MANIFEST = 3u,  /*The manifest does not fit the App region*/
+    BOOT_RESULT_VERIFY_FAILED = 4u, /*A programmed sector or the manifest CRC failed the check*/
+    BOOT_RESULT_NO_APP = 5u,        /*App mode: no App in flash*/
+    BOOT_RESULT_APP_ERASED = 6u,    /*App mode: the last update failed, its App has been erased*/
+    BOOT_RESULT_TOO_LARGE = 7u,     /*Larger than the staging buffer, from a host that does not wait for the erase*/
+    BOOT_RESULT_COUNT = 8u          /*Number of results*/
+} boot_result_t;
+
+/*******************************************************************************
+ * Struct
+ ******************************************************************************/
+
+/**
+ * @brief Reference of the time spent in each stage of an update, in core clock cycles
+ */
+typedef struct update_statistic
+{
+    uint64_t total_cycles;     /*From Boot_main entry to its return*/
+    uint64_t erase_cycles;     /*Erasing the old App or the failed update*/
+    uint64_t parse_cycles;     /*Copying, parsing and checking the received lines*/
+    uint64_t program_cycles;   /*Programming the records to flash*/
+    uint64_t idle_cycles;      /*Waiting for a line to be received*/
+    uint32_t programmed_bytes; /*Bytes of App data programmed*/
+    uint32_t background_sectors; /*Sectors of the other flash block erased while receiving*/
+    uint64_t overlap_cycles;   /*Background erase time during which the bootloader kept running*/
+    uint64_t transfer_cycles;  /*From Boot_main entry to the termination record*/
+    uint64_t commit_cycles;    /*From the termination record to the end of the update*/
+    uint32_t staged;           /*1 if the whole image was received in RAM before writing flash*/
+    uint64_t verify_cycles;    /*Margin read check of the programmed sectors*/
+    uint32_t rejected_lines;   /*Bad lines skipped on a multi-drop line, retransmitted by the host*/
+    uint64_t sleep_cycles;     /*Part of idle_cycles spent sleeping (WFI), the energy proxy*/
+    uint32_t sleep_count;      /*Number of times the core went to sleep*/
+} update_statistic_info;
+
+/**
+ * @brief Data received in RAM: the whole image while it is staged, then the data of each sector
+ *        until it has been verified. A sector is kept in the 1 KB slot of its offset from
+ *        base_address modulo STAGING_BUFFER_SIZE
+ */
+typedef struct staging_image
+{
+    uint32_t base_address;                       /*Flash address of image[0], sector aligned*/
+    uint32_t end_address;                        /*Flash address after the last staged byte*/
+    uint32_t header_words;                       /*Words of the header record in header*/
+    uint8_t header[APP_HEADER_MAX_SIZE];         /*Header record data*/
+    uint32_t image[STAGING_BUFFER_SIZE / 4u];    /*Image data, erased value where no record*/
+    uint32_t sector_address[STAGING_BUFFER_SIZE / FLASH_SECTOR_SIZE]; /*Sector held by each slot, 0 if none*/
+} staging_image_info;
+
+/**
+ * @brief Reference of the image of the update being received
+ */
+typedef struct update_image
+{
+    uint32_t start_address;  /*Start address of new Application: manifest entry or first data record*/
+    uint32_t load_address;   /*Address of the first App byte*/
+    uint32_t end_address;    /*Address after the last data record*/
+    uint32_t byte_size;      /*Size of new Application in byte*/
+    uint32_t data_records;   /*Number of data records received*/
+    uint32_t program_sector; /*Address of the sector being programmed*/
+    uint8_t staging;         /*1 while the image is still received in RAM*/
+} update_image_info;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Start an update: clear its statistics, the staged image, the manifest and the
+ *        verification, nothing is erased
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_start(void);
+
+/**
+ * @brief Process a received S-record line
+ *
+ * @param record: Parsed S-record line
+ * @param line_error: 1 if the line failed its format or checksum check, 0 if not
+ * @param paced: 1 if the host waits for the acknowledge of each line (#PACE 1), 0 if not
+ *
+ * @return UPDATE_CONTINUE while the update goes on, the boot_result_t of its end otherwise
+ */
+uint32_t Update_record(srec_line *record, uint8_t line_error, uint8_t paced);
+
+/**
+ * @brief End a multi-drop update once the host has retransmitted the records this node missed:
+ *        check the image again and mark it valid
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if the App has been marked valid, 0 if not
+ */
+uint8_t Update_commit(void);
+
+/**
+ * @brief Add the time since the last stage to the line processing of the update
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_account_line(void);
+
+/**
+ * @brief Verify the completed sectors while no line is received, sleep once nothing is left
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_idle(void);
+
+/**
+ * @brief End an update: wait for the flash work left and complete its statistics
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_finish(void);
+
+/**
+ * @brief Check if the termination record of a multi-drop update has been received
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if #COMMIT can end the update, 0 if not
+ */
+uint8_t Update_is_image_complete(void);
+
+/**
+ * @brief Check if the update has erased the old App
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if a failed update no longer leaves the old App in place, 0 if not
+ */
+uint8_t Update_is_flash_written(void);
+
+/**
+ * @brief Wait until the background erase has passed an address
+ *
+ * @param address: Address that must be erased, FLASH_DELETED_VALUE for the whole erase
+ *
+ * @return: This function return nothing
+ */
+void Update_wait_background_erase(uint32_t address);
+
+/**
+ * @brief Check if a valid application is available in flash
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if the application is valid, 0 if not
+ */
+uint8_t Update_is_app_valid(void);
+
+/**
+ * @brief Erase failed update application code in flash
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_erase_failed_app(void);
+
+/**
+ * @brief Print the statistics of the last update as one key=value line
+ *
+ * @param core_clock: Core clock in Hz, converts the cycles to ms
+ *
+ * @return: This function return nothing
+ */
+void Update_print_statistics(uint32_t core_clock);
+
+/**
+ * @brief Send the result of the update on this node
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_print_status(void);
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
@@ -0,0 +1,149 @@
+/**
+ * @file  : Verify.h
+ * @author: Nguyen The Anh.
+ * @brief : Declare enum, typdef, macro and function using in Verify.c.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _VERIFY_H_
+#define _VERIFY_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdint.h>
+#include "../Includes/Srec/Srec.h"
+#include "Flash_layout.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Longwords verified each time the main loop has no line to process*/
+#define VERIFY_WORDS_PER_STEP (8u)
+
+/*\Number of flash sectors, size of the verification map*/
+#define FLASH_SECTOR_COUNT (FLASH_TOTAL_SIZE / FLASH_SECTOR_SIZE)
+
+/*******************************************************************************
+ * Struct
+ ******************************************************************************/
+
+/**
+ * @brief Reference of the function giving the value a programmed longword must hold
+ */
+typedef uint32_t (*verify_expected_t)(uint32_t address);
+
+/**
+ * @brief Verification of the programmed image, one longword at a time
+ */
+typedef struct verify_state
+{
+    uint32_t first_address;                       /*First verified longword, 0 until a range is ready*/
+    uint32_t next_address;                        /*Next longword to verify*/
+    uint32_t ready_address;                       /*End of the programmed range that can be verified*/
+    uint32_t failed_sectors;                      /*Number of sectors with a failed longword*/
+    uint32_t crc_failed;                          /*1 if the image does not match the CRC of its manifest*/
+    uint32_t failed_map[FLASH_SECTOR_COUNT / 32u]; /*Bit set for each failed sector*/
+    verify_expected_t expected;                   /*Value each longword of the ready range must hold*/
+} verify_state_info;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Restart the verification with nothing verified
+ *
+ * @param expected: Function giving the value a longword of the image must hold
+ *
+ * @return: This function return nothing
+ */
+void Verify_reset(verify_expected_t expected);
+
+/**
+ * @brief Mark a programmed range as ready for verification
+ *
+ * @param start_address: Address of the first programmed byte
+ * @param end_address: Address after the last programmed byte
+ *
+ * @return: This function return nothing
+ */
+void Verify_ready(uint32_t start_address, uint32_t end_address);
+
+/**
+ * @brief Verify the next longwords of the ready range with a user margin read
+ *
+ * @param word_count: Maximum number of longwords to verify
+ *
+ * @return 1 if longwords of the ready range are left to verify, 0 if not
+ */
+uint8_t Verify_step(uint32_t word_count);
+
+/**
+ * @brief Verify the ready range up to an address
+ *
+ * @param end_address: Address after the last longword to verify
+ *
+ * @return: This function return nothing
+ */
+void Verify_until(uint32_t end_address);
+
+/**
+ * @brief Mark the sector of a longword as failed in the verification map
+ *
+ * @param address: Address of the failed longword
+ *
+ * @return: This function return nothing
+ */
+void Verify_mark_failed(uint32_t address);
+
+/**
+ * @brief Verify the longwords of a programmed record with a user margin read of its own data
+ *
+ * @param record: Parsed data record
+ *
+ * @return: This function return nothing
+ */
+void Verify_record(srec_line *record);
+
+/**
+ * @brief Set the result of the CRC check of the image against its manifest
+ *
+ * @param failed: 1 if the image does not match the CRC, 0 if it does
+ *
+ * @return: This function return nothing
+ */
+void Verify_set_crc_failed(uint8_t failed);
+
+/**
+ * @brief Check the result of the verification
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if no sector and no CRC check failed, 0 if not
+ */
+uint8_t Verify_is_passed(void);
+
+/**
+ * @brief Print the per-sector verification map of the last update
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Verify_print_map(void);
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
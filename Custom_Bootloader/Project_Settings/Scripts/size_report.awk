@@ -0,0 +1,220 @@
+# Size report of Custom_Bootloader per module
+#
+# Usage: awk -f size_report.awk <map file> [<gcc-nm -A listing of the objects> <nm -S -l listing of the image>]
+#
+# Sums the input sections of the memory map by object file (archives are
+# grouped by library). Flash is text + rodata + data, RAM is data + bss.
+# With LTO (Release) the map only knows the ltrans partitions of the link:
+# given the two listings, each symbol of the image placed in a partition is
+# summed on its object instead, the one that defines it (gcc-nm of the LTO
+# objects) or the source file of its debug line (static functions). What is
+# left to a partition, alignment and static data, stays on its ltrans line.
+# The last lines compare the end of the bootloader image with the App
+# information sector (__app_info__ of the linker file).
+
+function hex_to_number(str,    i, c, value)
+{
+    value = 0
+    str = tolower(str)
+    sub(/^0x/, "", str)
+    for (i = 1; i <= length(str); i++)
+    {
+        c = index("0123456789abcdef", substr(str, i, 1)) - 1
+        value = value * 16 + c
+    }
+    return value
+}
+
+function module_name(path)
+{
+    sub(/\(.*\)$/, "", path)
+    sub(/^.*[\/\\]/, "", path)
+    return path
+}
+
+function section_kind(name)
+{
+    if (name ~ /^\.text/)
+    {
+        return "text"
+    }
+    if (name ~ /^\.rodata/)
+    {
+        return "rodata"
+    }
+    if (name ~ /^\.data/)
+    {
+        return "data"
+    }
+    if ((name ~ /^\.bss/) || (name == "COMMON"))
+    {
+        return "bss"
+    }
+    return ""
+}
+
+function add_size(module, kind, size)
+{
+    modules[module] = 1
+    if (kind == "text")
+    {
+        text[module] += size
+    }
+    else if (kind == "rodata")
+    {
+        rodata[module] += size
+    }
+    else if (kind == "data")
+    {
+        data[module] += size
+    }
+    else if (kind == "bss")
+    {
+        bss[module] += size
+    }
+}
+
+function add_section(name, address, size, path,    module, kind)
+{
+    kind = section_kind(name)
+    if ((size == 0) || (path == "") || (kind == ""))
+    {
+        return
+    }
+    module = module_name(path)
+    add_size(module, kind, size)
+
+    # Address range of an LTO partition section, for the symbols of the nm listing
+    if (module ~ /\.ltrans[0-9]*\.ltrans\.o$|\.ltrans[0-9]*\.o$/)
+    {
+        partitions++
+        partition_start[partitions] = address
+        partition_end[partitions] = address + size
+        partition_module[partitions] = module
+        partition_kind[partitions] = kind
+    }
+}
+
+# Symbol of the image: "<address> <size> <type> <name>\t<file>:<line>"
+function add_symbol(address, size, name, location,    i, module)
+{
+    if (name in owner)
+    {
+        module = owner[name]
+    }
+    else if (location != "")
+    {
+        sub(/:[0-9]+$/, "", location)
+        sub(/^.*[\/\\]/, "", location)
+        sub(/\.[^.]*$/, "", location)
+        module = location ".o"
+    }
+    if ((size == 0) || (module == "") || (address in symbol_seen))
+    {
+        return
+    }
+    symbol_seen[address] = 1
+    for (i = 1; i <= partitions; i++)
+    {
+        if ((address >= partition_start[i]) && ((address + size) <= partition_end[i]))
+        {
+            add_size(partition_module[i], partition_kind[i], -size)
+            add_size(module, partition_kind[i], size)
+            return
+        }
+    }
+}
+
+{
+    sub(/\r$/, "")
+}
+
+# Symbols defined by each object: "<object>:<address> <type> <name>"
+FILENAME == ARGV[2] {
+    if ((NF == 3) && ($2 ~ /^[BDRTVW]$/))
+    {
+        owner[$3] = module_name(substr($1, 1, index($1, ":") - 1))
+    }
+    next
+}
+
+# Symbols of the image, after the map
+FILENAME == ARGV[3] {
+    if ((NF >= 4) && ($1 ~ /^[0-9a-fA-F]+$/) && ($2 ~ /^[0-9a-fA-F]+$/))
+    {
+        split($0, fields, "\t")
+        split(fields[1], symbol_fields, " ")
+        add_symbol(hex_to_number($1), hex_to_number($2), symbol_fields[4], fields[2])
+    }
+    next
+}
+
+/^Linker script and memory map/ {
+    in_map = 1
+    next
+}
+
+!in_map {
+    next
+}
+
+# Symbols assigned by the linker file
+/^ +0x[0-9a-f]+ +[A-Za-z_]+ = / {
+    symbol[$2] = hex_to_number($1)
+    next
+}
+
+# Input section on one line: " .text.main 0x00000410 0x1c4 ./Sources/main.o"
+/^ \.[^ ]+ +0x[0-9a-f]+ +0x[0-9a-f]+ +[^ ]/ {
+    add_section($1, hex_to_number($2), hex_to_number($3), $4)
+    pending = ""
+    next
+}
+
+/^ COMMON +0x[0-9a-f]+ +0x[0-9a-f]+ +[^ ]/ {
+    add_section("COMMON", hex_to_number($2), hex_to_number($3), $4)
+    pending = ""
+    next
+}
+
+# Long section name, the address, size and file follow on the next line
+/^ (\.[^ ]+|COMMON)$/ {
+    pending = $1
+    next
+}
+
+/^ +0x[0-9a-f]+ +0x[0-9a-f]+ +[^ ]/ {
+    if (pending != "")
+    {
+        add_section(pending, hex_to_number($1), hex_to_number($2), $3)
+    }
+    pending = ""
+    next
+}
+
+{
+    pending = ""
+}
+
+END {
+    printf("%-24s %8s %8s %8s %8s %8s %8s\n", "module", "text", "rodata", "data", "bss", "flash", "ram")
+    for (m in modules)
+    {
+        if (text[m] + rodata[m] + data[m] + bss[m] == 0)
+        {
+            continue
+        }
+        printf("%-24s %8d %8d %8d %8d %8d %8d\n", m, text[m], rodata[m], data[m], bss[m],
+               text[m] + rodata[m] + data[m], data[m] + bss[m])
+        total_flash += text[m] + rodata[m] + data[m]
+        total_ram += data[m] + bss[m]
+    }
+    printf("%-24s %44d %8d\n", "total", total_flash, total_ram)
+
+    if (("__DATA_END" in symbol) && ("__app_info__" in symbol))
+    {
+        printf("bootloader image ends at 0x%05X, App information sector at 0x%05X, %d bytes free\n",
+               symbol["__DATA_END"], symbol["__app_info__"],
+               symbol["__app_info__"] - symbol["__DATA_END"])
+    }
+}
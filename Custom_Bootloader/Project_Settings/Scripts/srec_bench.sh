@@ -0,0 +1,214 @@
+#!/bin/sh
+# Update time benchmark of the bootloader, one CSV row per image
+#
+# Usage: sh srec_bench.sh <port> <results.csv> [<baseline.csv>]
+#        SIZES="1024 16384 65536 204800" TYPES="S1 S2 S3" RECORD=16 sh srec_bench.sh ...
+#        RESET_CMD="<command>" TOLERANCE=10 sh srec_bench.sh ...
+#
+# For each size (bytes) and record type an image of random data is generated
+# at BASE_APP_ADDRESS (S1 only where the image ends below 0x10000), the board
+# is reset into boot mode, by RESET_CMD or by hand on the prompt, and the image
+# is sent with srec_gang.sh. The RESULT and STAT lines the board sends back are
+# written to <results.csv>: type, size, result, then every key of the STAT line
+# in its order (time_ms, the stage cycle counts, dropped, ...). With a baseline
+# CSV, a row whose time_ms grew more than TOLERANCE percent is reported SLOW.
+# Exits 1 if an image failed or is slow.
+# The board is left with a random image: reprogram the App afterwards, the
+# images have no manifest so they are sent paced (#PACE 1, srec_gang.sh).
+# The timings come from the board, there is no host model of the flash.
+
+SIZES=${SIZES:-"1024 4096 16384 65536 131072 204800"}
+TYPES=${TYPES:-"S1 S2 S3"}
+RECORD=${RECORD:-16}
+BASE=${BASE:-0xA000}
+TOLERANCE=${TOLERANCE:-10}
+RESET_CMD=${RESET_CMD:-}
+
+if [ $# -lt 2 ]; then
+    echo "usage: sh srec_bench.sh <port> <results.csv> [<baseline.csv>]" >&2
+    exit 2
+fi
+port=$1
+csv=$2
+baseline=$3
+scripts=$(dirname "$0")
+
+work=$(mktemp -d) || exit 2
+rows="$work/rows"
+: > "$rows"
+
+# Write a random image of $2 bytes with $1 records at BASE to $3, 1 if it does not fit the type
+make_image()
+{
+    head -c "$2" /dev/urandom | od -An -v -tx1 | awk -v type="$1" -v size="$2" -v base="$BASE" -v record="$RECORD" '
+function hex_to_number(str,    i, c, value)
+{
+    value = 0
+    str = tolower(str)
+    sub(/^0x/, "", str)
+    for (i = 1; i <= length(str); i++)
+    {
+        c = index("0123456789abcdef", substr(str, i, 1)) - 1
+        value = value * 16 + c
+    }
+    return value
+}
+
+# One record: type, address, data (hex), the count and checksum are computed
+function put_record(rtype, address, data,    count, sum, str, i)
+{
+    str = sprintf("%0" ((rtype == "S0") ? 4 : 2 * address_bytes) "X", address) data
+    count = length(str) / 2 + 1
+    sum = count
+    for (i = 1; i <= length(str); i += 2)
+    {
+        sum += hex_to_number(substr(str, i, 2))
+    }
+    printf("%s%02X%s%02X\n", rtype, count, str, 255 - (sum % 256))
+}
+
+BEGIN {
+    start = hex_to_number(base)
+    address_bytes = (type == "S1") ? 2 : ((type == "S2") ? 3 : 4)
+    if (start + size > 256 ^ address_bytes)
+    {
+        too_large = 1
+        exit 1
+    }
+    put_record("S0", 0, "62656E6368")
+    address = start
+    data = ""
+}
+
+{
+    for (i = 1; i <= NF; i++)
+    {
+        data = data toupper($i)
+        if (length(data) == 2 * record)
+        {
+            put_record(type, address, data)
+            address += record
+            data = ""
+        }
+    }
+}
+
+END {
+    if (too_large)
+    {
+        exit 1
+    }
+    if (data != "")
+    {
+        put_record(type, address, data)
+    }
+    put_record((type == "S1") ? "S9" : ((type == "S2") ? "S8" : "S7"), start, "")
+}' > "$3"
+}
+
+failed=0
+for type in $TYPES; do
+    for size in $SIZES; do
+        image="$work/$type-$size.srec"
+        if ! make_image "$type" "$size" "$image"; then
+            continue
+        fi
+
+        if [ -n "$RESET_CMD" ]; then
+            sh -c "$RESET_CMD"
+        else
+            printf 'Reset %s into boot mode for %s %d bytes, then press Enter ' "$port" "$type" "$size" > /dev/tty
+            read -r answer < /dev/tty
+        fi
+
+        mkdir -p "$work/log" && rm -f "$work/log/"*
+        LOG_DIR="$work/log" sh "$scripts/srec_gang.sh" "$image" "$port" > /dev/null
+        log="$work/log/$(basename "$port").log"
+
+        result=$(sed -n 's/.*RESULT status=\([a-z_]*\).*/\1/p' "$log" 2>/dev/null | tail -n 1)
+        stat=$(sed -n 's/^.*STAT //p' "$log" 2>/dev/null | tr -d '\r' | tail -n 1)
+        echo "$type $size ${result:-none} $stat" >> "$rows"
+    done
+done
+
+awk -v csv="$csv" -v baseline="$baseline" -v tolerance="$TOLERANCE" '
+BEGIN {
+    # Baseline time_ms by image
+    if ((baseline != "") && ((getline line < baseline) > 0))
+    {
+        columns = split(line, name, ",")
+        for (i = 1; i <= columns; i++)
+        {
+            if (name[i] == "time_ms")
+            {
+                time_column = i
+            }
+        }
+        while ((getline line < baseline) > 0)
+        {
+            split(line, field, ",")
+            if (time_column != 0)
+            {
+                base_time[field[1] "," field[2]] = field[time_column]
+            }
+        }
+        close(baseline)
+    }
+    failed = 0
+}
+
+{
+    key = $1 "," $2
+    row = key "," $3
+    header = "type,size,result"
+    time_ms = ""
+    for (i = 4; i <= NF; i++)
+    {
+        split($i, pair, "=")
+        header = header "," pair[1]
+        row = row "," pair[2]
+        if (pair[1] == "time_ms")
+        {
+            time_ms = pair[2]
+        }
+    }
+    # A board that sent no STAT line has no key, the header is the longest
+    if (length(header) > length(csv_header))
+    {
+        csv_header = header
+    }
+    csv_row[NR] = row
+
+    status = "PASS"
+    timing = (time_ms != "") ? sprintf("%d ms", time_ms) : "-"
+    if ($3 != "success")
+    {
+        status = "FAIL"
+    }
+    else if ((key in base_time) && (time_ms != ""))
+    {
+        timing = sprintf("%d ms (baseline %d ms)", time_ms, base_time[key])
+        if ((time_ms + 0) * 100 > (base_time[key] + 0) * (100 + tolerance))
+        {
+            status = "SLOW"
+        }
+    }
+    if (status != "PASS")
+    {
+        failed++
+    }
+    printf("%-3s %8d bytes  %-5s %-14s %s\n", $1, $2, status, $3, timing)
+}
+
+END {
+    print csv_header > csv
+    for (i = 1; i <= NR; i++)
+    {
+        print csv_row[i] > csv
+    }
+    printf("%d images, %d failed\n", NR, failed)
+    exit (failed != 0)
+}' "$rows"
+status=$?
+rm -rf "$work"
+exit $status
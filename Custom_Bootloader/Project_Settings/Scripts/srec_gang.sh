@@ -0,0 +1,214 @@
+#!/bin/sh
+# Gang programming of boards in boot mode, one sender process per serial port
+#
+# Usage: sh srec_gang.sh <App.srec> <port> [<port> ...]
+#        BAUD=115200 TIMEOUT=50 sh srec_gang.sh ...   (TIMEOUT in tenths of a second)
+#        AUTOBAUD=20 sh srec_gang.sh ...              (line errors per 1000 bytes)
+#        SKIP_SAME=1 sh srec_gang.sh ...
+#
+# Nothing is sent to a board before its "Waiting for receiving Srec file"
+# prompt. A board that sent the prompt before its port was opened sends nothing
+# more: the sender goes on after TIMEOUT.
+# Each port is set to raw 8N1 and paced with "#PACE 1": the bootloader answers
+# "PACE on=1 window=N" then sends '+' each time it frees a receive queue line,
+# so at most N lines are in flight and no line is dropped while the board is
+# writing flash. The first line is sent alone: unless it is the manifest S0 of an
+# image that fits its staging buffer, the board erases the old App before the '+'
+# and a frame it receives meanwhile is lost. The boards run concurrently, each sender waits for the result
+# line of its board ("Update has been finished" or "Failed to update firmware")
+# and reads on to the "RESULT status=" line, so the report (STAT line) is
+# received too. With LOG_DIR set, the text lines of each board are written to
+# <LOG_DIR>/<port name>.log, srec_bench.sh reads them.
+# With AUTOBAUD set, "#AUTOBAUD <rate>" lets the board step its baud rate down
+# on line errors: it sends "BAUD <rate>" at the old baud rate and the port is
+# switched to the new one. A line lost across the switch fails as a bad line.
+# With SKIP_SAME set, each board is asked "#QUERY" first and is not updated if
+# srec_skip.awk finds the image already installed: it is reported SKIPPED and
+# left in boot mode, reset it to run the App. Boot mode erases nothing before
+# an image is received, so the answer describes the installed App.
+# Prints one line per board and the aggregate throughput, exits 1 if a board
+# failed. Linux: stty -F and date +%s%N.
+
+BAUD=${BAUD:-115200}
+TIMEOUT=${TIMEOUT:-50}
+LOG_DIR=${LOG_DIR:-}
+AUTOBAUD=${AUTOBAUD:-}
+SKIP_SAME=${SKIP_SAME:-}
+
+# Read one byte of the board into c (hex, empty on timeout) and collect the text lines
+next_byte()
+{
+    c=$(dd bs=1 count=1 <&3 2>/dev/null | od -An -tx1 | tr -d ' \n')
+    case $c in
+        "")
+            ;;
+        0a)
+            [ -z "$rx_log" ] || printf '%s\n' "$rx_line" >> "$rx_log"
+            case $rx_line in
+                *"PACE on=1 window="*) window=${rx_line##*window=} ;;
+                *"AUTOBAUD rate="*) autobaud=on ;;
+                *"QUERY valid="*) query=$rx_line ;;
+                "BAUD "[0-9]*) stty -F "$port" "${rx_line#BAUD }" 2>/dev/null ;;
+                *"Update has been finished"*) result=OK ;;
+                *"Failed to update firmware"*) result=FAILED ;;
+                *"RESULT status="*) finished=1 ;;
+            esac
+            rx_line=""
+            ;;
+        0d|2b)
+            ;;
+        *)
+            rx_line="$rx_line$(printf "\\$(printf %o "0x$c")")"
+            # The prompt does not end with a new line
+            case $rx_line in
+                *"Waiting for receiving Srec file") ready=1 ;;
+            esac
+            ;;
+    esac
+}
+
+now_ms()
+{
+    echo $(($(date +%s%N) / 1000000))
+}
+
+# Program one board, write "port bytes time_ms Bps result" to the log
+program_board()
+{
+    port=$1
+    log=$2
+    bytes=0
+    in_flight=0
+    window=""
+    autobaud=""
+    query=""
+    result=""
+    finished=""
+    ready=""
+    rx_line=""
+    rx_log=""
+    if [ -n "$LOG_DIR" ]; then
+        rx_log="$LOG_DIR/$(basename "$port").log"
+        : > "$rx_log"
+    fi
+
+    if ! stty -F "$port" "$BAUD" cs8 -cstopb -parenb raw -echo min 0 time "$TIMEOUT" 2>/dev/null; then
+        echo "$port 0 0 0 NO_PORT" > "$log"
+        return
+    fi
+    exec 3<>"$port"
+    start=$(now_ms)
+
+    while [ -z "$ready" ]; do
+        next_byte
+        [ -n "$c" ] || break
+    done
+
+    if [ -n "$SKIP_SAME" ]; then
+        printf '#QUERY\n' >&3
+        while [ -z "$query" ]; do
+            next_byte
+            if [ -z "$c" ]; then
+                echo "$port 0 0 0 NO_QUERY" > "$log"
+                exec 3<&-
+                return
+            fi
+        done
+        if awk -f "$scripts/srec_skip.awk" -v query="$query" "$srec" > /dev/null; then
+            echo "$port 0 $(($(now_ms) - start)) 0 SKIPPED" > "$log"
+            exec 3<&-
+            return
+        fi
+    fi
+
+    printf '#PACE 1\n' >&3
+    while [ -z "$window" ]; do
+        next_byte
+        if [ -z "$c" ]; then
+            echo "$port 0 0 0 NO_PACE" > "$log"
+            exec 3<&-
+            return
+        fi
+    done
+
+    if [ -n "$AUTOBAUD" ]; then
+        printf '#AUTOBAUD %s\n' "$AUTOBAUD" >&3
+        while [ -z "$autobaud" ]; do
+            next_byte
+            if [ -z "$c" ]; then
+                echo "$port 0 0 0 NO_AUTOBAUD" > "$log"
+                exec 3<&-
+                return
+            fi
+        done
+    fi
+
+    sent=0
+    while IFS= read -r line || [ -n "$line" ]; do
+        line=$(printf '%s' "$line" | tr -d '\r')
+        [ -n "$line" ] || continue
+
+        # Wait for a free queue line, a failed board stops acknowledging. The
+        # first line must be acknowledged before the second one is sent
+        limit=$window
+        [ "$sent" -gt 1 ] || limit=1
+        while [ "$in_flight" -ge "$limit" ] && [ -z "$result" ]; do
+            next_byte
+            case $c in
+                2b) in_flight=$((in_flight - 1)) ;;
+                "") result=TIMEOUT ;;
+            esac
+        done
+        [ -z "$result" ] || break
+
+        printf '%s\n' "$line" >&3
+        in_flight=$((in_flight + 1))
+        sent=$((sent + 1))
+        bytes=$((bytes + ${#line} + 1))
+    done < "$srec"
+
+    # The result line comes first, the report follows it
+    while [ -z "$finished" ]; do
+        next_byte
+        if [ -z "$c" ]; then
+            [ -n "$result" ] || result=TIMEOUT
+            break
+        fi
+    done
+
+    time_ms=$(($(now_ms) - start))
+    echo "$port $bytes $time_ms $((bytes * 1000 / (time_ms + 1))) $result" > "$log"
+    exec 3<&-
+}
+
+if [ $# -lt 2 ] || [ ! -r "$1" ]; then
+    echo "usage: sh srec_gang.sh <App.srec> <port> [<port> ...]" >&2
+    exit 2
+fi
+srec=$1
+shift
+scripts=$(dirname "$0")
+
+logs=$(mktemp -d) || exit 2
+wall_start=$(now_ms)
+n=0
+for port in "$@"; do
+    n=$((n + 1))
+    program_board "$port" "$logs/$n" &
+done
+wait
+wall_ms=$(($(now_ms) - wall_start))
+
+cat "$logs"/* | awk -v wall_ms="$wall_ms" '
+    { printf("%-16s %8d bytes %8d ms %7d B/s  %s\n", $1, $2, $3, $4, $5) }
+    { total += $2 }
+    $5 == "SKIPPED" { skipped++ }
+    ($5 != "OK") && ($5 != "SKIPPED") { failed++ }
+    END {
+        printf("%d boards, %d skipped, %d failed, %d bytes in %d ms, %d B/s aggregate\n",
+               NR, skipped, failed, total, wall_ms, total * 1000 / (wall_ms + 1))
+        exit (failed != 0)
+    }'
+status=$?
+rm -rf "$logs"
+exit $status
@@ -0,0 +1,159 @@
+# Image manifest generator for an App S-record file
+#
+# Usage: awk -f srec_manifest.awk [-v version=N] [-v entry=0xADDR] <App.srec> > <App_manifest.srec>
+#
+# Replaces the S0 record of the file by a manifest (Includes/App_manifest.h):
+# magic, version, load range of the data records, entry (vector table, lowest
+# data address by default), CRC-32 of the load range with gaps read as 0xFF,
+# flags. The bootloader programs whole longwords, so the trailing bytes of a
+# record that does not hold whole longwords are left out as on the target.
+# Plain POSIX awk: the bitwise operations are done on nibbles.
+
+function hex_to_number(str,    i, c, value)
+{
+    value = 0
+    str = tolower(str)
+    sub(/^0x/, "", str)
+    for (i = 1; i <= length(str); i++)
+    {
+        c = index("0123456789abcdef", substr(str, i, 1)) - 1
+        value = value * 16 + c
+    }
+    return value
+}
+
+function xor32(a, b,    result, weight, i)
+{
+    result = 0
+    weight = 1
+    for (i = 0; i < 8; i++)
+    {
+        result += nibble_xor[(a % 16) "," (b % 16)] * weight
+        a = int(a / 16)
+        b = int(b / 16)
+        weight *= 16
+    }
+    return result
+}
+
+function crc_add(crc, byte)
+{
+    return xor32(crc_table[xor32(crc, byte) % 256], int(crc / 256))
+}
+
+function hex_bytes(value, count,    str, i)
+{
+    # little endian
+    str = ""
+    for (i = 0; i < count; i++)
+    {
+        str = str sprintf("%02X", value % 256)
+        value = int(value / 256)
+    }
+    return str
+}
+
+BEGIN {
+    for (i = 0; i < 16; i++)
+    {
+        for (j = 0; j < 16; j++)
+        {
+            value = 0
+            for (bit = 1; bit < 16; bit *= 2)
+            {
+                if ((int(i / bit) % 2) != (int(j / bit) % 2))
+                {
+                    value += bit
+                }
+            }
+            nibble_xor[i "," j] = value
+        }
+    }
+
+    # reflected CRC-32, polynomial 0xEDB88320
+    for (i = 0; i < 256; i++)
+    {
+        c = i
+        for (k = 0; k < 8; k++)
+        {
+            if (c % 2)
+            {
+                c = xor32(int(c / 2), 3988292384)
+            }
+            else
+            {
+                c = int(c / 2)
+            }
+        }
+        crc_table[i] = c
+    }
+
+    if (version == "")
+    {
+        version = 0
+    }
+    low = -1
+    high = 0
+    lines = 0
+}
+
+{ sub(/\r$/, "") }
+
+/^S[123]/ {
+    address_length = (substr($0, 2, 1) + 1) * 2
+    count = hex_to_number(substr($0, 3, 2))
+    address = hex_to_number(substr($0, 5, address_length))
+    data_length = int((count - address_length / 2 - 1) / 4) * 4
+    for (i = 0; i < data_length; i++)
+    {
+        memory[address + i] = hex_to_number(substr($0, 5 + address_length + i * 2, 2))
+    }
+    if ((data_length > 0) && ((low < 0) || (address < low)))
+    {
+        low = address
+    }
+    if (address + data_length > high)
+    {
+        high = address + data_length
+    }
+}
+
+!/^S0/ {
+    line[++lines] = $0
+}
+
+END {
+    if (low < 0)
+    {
+        print "srec_manifest.awk: no data record" > "/dev/stderr"
+        exit 1
+    }
+
+    crc = 4294967295
+    for (address = low; address < high; address++)
+    {
+        crc = crc_add(crc, (address in memory) ? memory[address] : 255)
+    }
+    crc = xor32(crc, 4294967295)
+
+    entry_address = (entry == "") ? low : hex_to_number(entry)
+
+    # magic "MNFT", version, load address, load size, entry, CRC, flags (APP_MANIFEST_FLAG_CRC)
+    data = "4D4E4654" hex_bytes(version, 4) hex_bytes(low, 4) hex_bytes(high - low, 4) \
+           hex_bytes(entry_address, 4) hex_bytes(crc, 4) hex_bytes(1, 4)
+    count = length(data) / 2 + 3
+    sum = count
+    for (i = 1; i <= length(data); i += 2)
+    {
+        sum += hex_to_number(substr(data, i, 2))
+    }
+    printf("S0%02X0000%s%02X\n", count, data, 255 - (sum % 256))
+
+    for (i = 1; i <= lines; i++)
+    {
+        print line[i]
+    }
+
+    printf("manifest: version %d, load 0x%05X, %d bytes, entry 0x%05X, crc 0x%08X\n",
+           version, low, high - low, entry_address, crc) > "/dev/stderr"
+}
@@ -0,0 +1,184 @@
+# Repacker of an App S-record file into the longest records the bootloader accepts
+#
+# Usage: awk -f srec_repack.awk [-v line=514] [-v baud=115200] <App.srec> > <App_packed.srec>
+#
+# The data records are merged by address and cut in whole longwords, at each
+# flash sector and at each gap, into records of at most `line` characters (the
+# "line=" of #INFO, 514 is the longest S-record). A longword that is only partly
+# covered is completed with the erased value 0xFF, as it reads on the target.
+# The S0 record is kept, the records use the widest address type of the file.
+# Run srec_manifest.awk on the output, not the input, if a manifest is needed.
+# The wire bytes (with CR LF) and the transfer time before and after are
+# printed on stderr. Plain POSIX awk, see srec_manifest.awk.
+
+function hex_to_number(str,    i, c, value)
+{
+    value = 0
+    str = tolower(str)
+    sub(/^0x/, "", str)
+    for (i = 1; i <= length(str); i++)
+    {
+        c = index("0123456789abcdef", substr(str, i, 1)) - 1
+        value = value * 16 + c
+    }
+    return value
+}
+
+function hex_bytes(value, count,    str)
+{
+    # big endian, as the address field
+    str = ""
+    while (count-- > 0)
+    {
+        str = sprintf("%02X", value % 256) str
+        value = int(value / 256)
+    }
+    return str
+}
+
+function emit(type, address, data,    count, sum, i, record)
+{
+    count = length(data) / 2 + address_bytes[type] + 1
+    record = sprintf("%02X", count) hex_bytes(address, address_bytes[type]) data
+    sum = 0
+    for (i = 1; i <= length(record); i += 2)
+    {
+        sum += hex_to_number(substr(record, i, 2))
+    }
+    record = "S" type record sprintf("%02X", 255 - (sum % 256))
+    print record
+    out_lines++
+    out_bytes += length(record) + 2
+}
+
+function transfer_ms(bytes)
+{
+    # 10 bits per character: start, 8 data bits, stop
+    return int(bytes * 10 * 1000 / baud)
+}
+
+BEGIN {
+    if (line == "")
+    {
+        line = 514
+    }
+    if (baud == "")
+    {
+        baud = 115200
+    }
+    SECTOR_SIZE = 1024
+
+    address_bytes[1] = 2
+    address_bytes[2] = 3
+    address_bytes[3] = 4
+    address_bytes[7] = 4
+    address_bytes[8] = 3
+    address_bytes[9] = 2
+
+    low = -1
+    high = 0
+    type = 1
+    header = ""
+    entry = 0
+}
+
+{ sub(/\r$/, "") }
+
+NF {
+    in_lines++
+    in_bytes += length($0) + 2
+}
+
+/^S0/ {
+    header = $0
+}
+
+/^S[123]/ {
+    record_type = substr($0, 2, 1) + 0
+    if (record_type > type)
+    {
+        type = record_type
+    }
+    address_length = address_bytes[record_type] * 2
+    count = hex_to_number(substr($0, 3, 2))
+    address = hex_to_number(substr($0, 5, address_length))
+    data_length = count - address_bytes[record_type] - 1
+    for (i = 0; i < data_length; i++)
+    {
+        memory[address + i] = substr($0, 5 + address_length + i * 2, 2)
+    }
+    if ((data_length > 0) && ((low < 0) || (address < low)))
+    {
+        low = address
+    }
+    if (address + data_length > high)
+    {
+        high = address + data_length
+    }
+}
+
+/^S[789]/ {
+    entry = hex_to_number(substr($0, 5, address_bytes[substr($0, 2, 1) + 0] * 2))
+}
+
+END {
+    if (low < 0)
+    {
+        print "srec_repack.awk: no data record" > "/dev/stderr"
+        exit 1
+    }
+
+    # longest data field in whole longwords
+    max_data = (line - 4 - address_bytes[type] * 2 - 2) / 2
+    if (max_data > 255 - address_bytes[type] - 1)
+    {
+        max_data = 255 - address_bytes[type] - 1
+    }
+    max_data = int(max_data / 4) * 4
+    if (max_data < 4)
+    {
+        print "srec_repack.awk: line is too short for a longword" > "/dev/stderr"
+        exit 1
+    }
+
+    if (header != "")
+    {
+        print header
+        out_lines++
+        out_bytes += length(header) + 2
+    }
+
+    data = ""
+    start = 0
+    for (word = low - low % 4; word < high; word += 4)
+    {
+        used = ((word in memory) || ((word + 1) in memory) || ((word + 2) in memory) || ((word + 3) in memory))
+
+        # cut at a gap, a sector and the longest record
+        if ((data != "") && (!used || (word % SECTOR_SIZE == 0) || (length(data) / 2 >= max_data)))
+        {
+            emit(type, start, data)
+            data = ""
+        }
+        if (used)
+        {
+            if (data == "")
+            {
+                start = word
+            }
+            for (i = 0; i < 4; i++)
+            {
+                data = data (((word + i) in memory) ? memory[word + i] : "FF")
+            }
+        }
+    }
+    if (data != "")
+    {
+        emit(type, start, data)
+    }
+    emit(10 - type, entry, "")
+
+    printf("repack: %d lines, %d wire bytes, %d ms -> %d lines, %d wire bytes, %d ms at %d baud (%d%% saved)\n",
+           in_lines, in_bytes, transfer_ms(in_bytes), out_lines, out_bytes, transfer_ms(out_bytes), baud,
+           (in_bytes - out_bytes) * 100 / in_bytes) > "/dev/stderr"
+}
@@ -0,0 +1,147 @@
+# Per-sector CRC check of a flashed board against an App S-record file
+#
+# Usage: awk -f srec_sector_crc.awk <App.srec>               prints the command to send
+#        awk -f srec_sector_crc.awk <App.srec> <reply file>  compares the CRC line of the reply
+#
+# The bootloader answers "#SECTORS <first sector> <count>" with
+# "CRC address=.. size=.. step=1024 crc=0x..,0x.." (CRC-32 of each sector, as
+# zlib crc32, in hexadecimal). The local sectors are built from the data records as the
+# bootloader programs them (whole longwords, erased bytes read as 0xFF).
+# Exits 1 if a sector differs. Plain POSIX awk, see srec_manifest.awk.
+
+function hex_to_number(str,    i, c, value)
+{
+    value = 0
+    str = tolower(str)
+    sub(/^0x/, "", str)
+    for (i = 1; i <= length(str); i++)
+    {
+        c = index("0123456789abcdef", substr(str, i, 1)) - 1
+        value = value * 16 + c
+    }
+    return value
+}
+
+function xor32(a, b,    result, weight, i)
+{
+    result = 0
+    weight = 1
+    for (i = 0; i < 8; i++)
+    {
+        result += nibble_xor[(a % 16) "," (b % 16)] * weight
+        a = int(a / 16)
+        b = int(b / 16)
+        weight *= 16
+    }
+    return result
+}
+
+function sector_crc(sector,    crc, address, byte)
+{
+    crc = 4294967295
+    for (address = sector * SECTOR_SIZE; address < (sector + 1) * SECTOR_SIZE; address++)
+    {
+        byte = (address in memory) ? memory[address] : 255
+        crc = xor32(crc_table[xor32(crc, byte) % 256], int(crc / 256))
+    }
+    return xor32(crc, 4294967295)
+}
+
+BEGIN {
+    SECTOR_SIZE = 1024
+
+    for (i = 0; i < 16; i++)
+    {
+        for (j = 0; j < 16; j++)
+        {
+            value = 0
+            for (bit = 1; bit < 16; bit *= 2)
+            {
+                if ((int(i / bit) % 2) != (int(j / bit) % 2))
+                {
+                    value += bit
+                }
+            }
+            nibble_xor[i "," j] = value
+        }
+    }
+
+    for (i = 0; i < 256; i++)
+    {
+        c = i
+        for (k = 0; k < 8; k++)
+        {
+            c = (c % 2) ? xor32(int(c / 2), 3988292384) : int(c / 2)
+        }
+        crc_table[i] = c
+    }
+
+    low = -1
+    high = 0
+}
+
+{ sub(/\r$/, "") }
+
+FNR == NR && /^S[123]/ {
+    address_length = (substr($0, 2, 1) + 1) * 2
+    count = hex_to_number(substr($0, 3, 2))
+    address = hex_to_number(substr($0, 5, address_length))
+    data_length = int((count - address_length / 2 - 1) / 4) * 4
+    for (i = 0; i < data_length; i++)
+    {
+        memory[address + i] = hex_to_number(substr($0, 5 + address_length + i * 2, 2))
+    }
+    if ((data_length > 0) && ((low < 0) || (address < low)))
+    {
+        low = address
+    }
+    if (address + data_length > high)
+    {
+        high = address + data_length
+    }
+}
+
+FNR != NR && /^CRC address=/ {
+    for (i = 2; i <= NF; i++)
+    {
+        split($i, field, "=")
+        reply[field[1]] = field[2]
+    }
+    replied = 1
+}
+
+END {
+    if (low < 0)
+    {
+        print "srec_sector_crc.awk: no data record" > "/dev/stderr"
+        exit 1
+    }
+
+    first = int(low / SECTOR_SIZE)
+    last = int((high - 1) / SECTOR_SIZE)
+
+    if (!replied)
+    {
+        printf("#SECTORS %d %d\n", first, last - first + 1)
+        exit 0
+    }
+
+    if ((reply["address"] != first * SECTOR_SIZE) || (reply["step"] != SECTOR_SIZE))
+    {
+        print "srec_sector_crc.awk: the reply is not for the sectors of this image" > "/dev/stderr"
+        exit 1
+    }
+
+    n = split(reply["crc"], board, ",")
+    failed = 0
+    for (sector = first; sector <= last; sector++)
+    {
+        if ((sector - first + 1 > n) || (hex_to_number(board[sector - first + 1]) != sector_crc(sector)))
+        {
+            printf("sector %d (0x%05X): MISMATCH\n", sector, sector * SECTOR_SIZE)
+            failed++
+        }
+    }
+    printf("%d sectors checked, %d mismatch\n", last - first + 1, failed)
+    exit (failed != 0)
+}
@@ -0,0 +1,98 @@
+# Update decision of a board from its "#QUERY" answer
+#
+# Usage: awk -f srec_skip.awk -v query="<QUERY line>" <App.srec>
+#
+# Prints SKIP and exits 0 if the board already holds the image: a valid App
+# whose manifest has the version, load range, entry, CRC-32 and flags of the
+# manifest in the S0 record of the image (srec_manifest.awk). Otherwise prints
+# "UPDATE <reason>" and exits 1. An image or a board without a manifest, or a
+# manifest without its CRC, is always updated: nothing identifies its data.
+# The numbers of the answer are decimal or 0x hex. srec_gang.sh calls it with
+# SKIP_SAME set.
+
+function hex_to_number(str,    i, c, value)
+{
+    value = 0
+    str = tolower(str)
+    sub(/^0x/, "", str)
+    for (i = 1; i <= length(str); i++)
+    {
+        c = index("0123456789abcdef", substr(str, i, 1)) - 1
+        value = value * 16 + c
+    }
+    return value
+}
+
+function to_number(str)
+{
+    return (tolower(substr(str, 1, 2)) == "0x") ? hex_to_number(str) : str + 0
+}
+
+# Longword i of the S0 data, little endian
+function manifest_word(i,    j, value)
+{
+    value = 0
+    for (j = 3; j >= 0; j--)
+    {
+        value = value * 256 + hex_to_number(substr(header, 9 + (i * 4 + j) * 2, 2))
+    }
+    return value
+}
+
+function decide(reason)
+{
+    print (reason == "") ? "SKIP" : ("UPDATE " reason)
+    exit (reason != "")
+}
+
+BEGIN {
+    n = split(query, field, " ")
+    for (i = 1; i <= n; i++)
+    {
+        if (split(field[i], pair, "=") == 2)
+        {
+            board[pair[1]] = pair[2]
+        }
+    }
+    header = ""
+}
+
+{ sub(/\r$/, "") }
+
+/^S0/ {
+    header = $0
+    exit
+}
+
+END {
+    if (!("valid" in board))
+    {
+        decide("no answer")
+    }
+    if ((substr(header, 9, 8) != "4D4E4654") || (length(header) < 8 + 7 * 8 + 2))
+    {
+        decide("image without manifest")
+    }
+    if ((to_number(board["valid"]) != 1) || (to_number(board["manifest"]) != 1))
+    {
+        decide("no valid App with a manifest on the board")
+    }
+    if (manifest_word(6) % 2 != 1)
+    {
+        decide("manifest without CRC")
+    }
+    if (to_number(board["version"]) != manifest_word(1))
+    {
+        decide("version " to_number(board["version"]) " -> " manifest_word(1))
+    }
+    if ((to_number(board["load"]) != manifest_word(2)) || (to_number(board["size"]) != manifest_word(3)) ||
+        (to_number(board["entry"]) != manifest_word(4)))
+    {
+        decide("load range or entry")
+    }
+    if ((to_number(board["crc"]) != manifest_word(5)) || (to_number(board["flags"]) != manifest_word(6)))
+    {
+        decide("CRC or flags")
+    }
+    decide("")
+}
@@ -0,0 +1,153 @@
+# Stack usage report of Custom_Bootloader
+#
+# Usage: awk [-v profile=<build>] -f stack_report.awk <*.su> <objdump -d listing> <map file>
+#
+# The .su files (gcc -fstack-usage) give the frame of each function, the
+# listing gives the call graph (bl instructions) and the map file gives
+# STACK_SIZE. The worst case is the deepest chain from main plus the deepest
+# interrupt handler and its 32-byte exception frame. Exit status is 1 if it
+# does not fit in STACK_SIZE. The .su files must come from a build without
+# -flto, the frames of a link-time optimized image are not in them; profile
+# names that build in the report.
+
+function hex_to_number(str,    i, c, value)
+{
+    value = 0
+    str = tolower(str)
+    sub(/^0x/, "", str)
+    for (i = 1; i <= length(str); i++)
+    {
+        c = index("0123456789abcdef", substr(str, i, 1)) - 1
+        value = value * 16 + c
+    }
+    return value
+}
+
+function depth(func,    list, n, i, d, best)
+{
+    if (func in memo)
+    {
+        return memo[func]
+    }
+    if (func in visiting)
+    {
+        recursive[func] = 1
+        return 0
+    }
+    if (!(func in frame))
+    {
+        unknown[func] = 1
+    }
+
+    visiting[func] = 1
+    best = 0
+    n = split(callees[func], list, " ")
+    for (i = 1; i <= n; i++)
+    {
+        d = depth(list[i])
+        if (d > best)
+        {
+            best = d
+            deepest_callee[func] = list[i]
+        }
+    }
+    delete visiting[func]
+
+    memo[func] = frame[func] + best
+    return memo[func]
+}
+
+function print_path(func,    path)
+{
+    path = func "(" frame[func] ")"
+    while (func in deepest_callee)
+    {
+        func = deepest_callee[func]
+        path = path " > " func "(" frame[func] ")"
+    }
+    return path
+}
+
+{
+    sub(/\r$/, "")
+}
+
+# foo.c:12:6:func<TAB>frame<TAB>static|dynamic|bounded
+FILENAME ~ /\.su$/ {
+    split($0, field, "\t")
+    n = split(field[1], part, ":")
+    frame[part[n]] = field[2] + 0
+    if (field[3] != "static")
+    {
+        dynamic[part[n]] = field[3]
+    }
+    next
+}
+
+FILENAME ~ /\.map$/ {
+    if ($2 == "STACK_SIZE")
+    {
+        stack_size = hex_to_number($1)
+    }
+    next
+}
+
+# 00000410 <main>:
+/^[0-9a-f]+ <[^>]+>:$/ {
+    current = $2
+    gsub(/[<>:]/, "", current)
+    if ((current ~ /_Handler$/) || (current ~ /_IRQHandler$/))
+    {
+        handler[current] = 1
+    }
+    next
+}
+
+# 41a: f000 f8b1  bl  580 <Boot_main>
+/\tbl\t/ {
+    if (match($0, /<[^>+]+>$/))
+    {
+        callees[current] = callees[current] " " substr($0, RSTART + 1, RLENGTH - 2)
+    }
+    next
+}
+
+END {
+    main_depth = depth("main")
+    isr_depth = 0
+    for (h in handler)
+    {
+        d = depth(h)
+        if (d > isr_depth)
+        {
+            isr_depth = d
+            isr_name = h
+        }
+    }
+    if (isr_depth > 0)
+    {
+        isr_depth += 32
+    }
+
+    if (profile != "")
+    {
+        printf("profile     : %s\n", profile)
+    }
+    printf("main path   : %d bytes, %s\n", main_depth, print_path("main"))
+    printf("interrupt   : %d bytes with the exception frame, %s\n", isr_depth, (isr_name != "") ? print_path(isr_name) : "none")
+    for (f in dynamic)
+    {
+        printf("warning     : %s has a %s frame\n", f, dynamic[f])
+    }
+    for (f in recursive)
+    {
+        printf("warning     : %s is recursive, depth counted once\n", f)
+    }
+    for (f in unknown)
+    {
+        printf("note        : no frame size for %s (library or assembly)\n", f)
+    }
+    printf("worst case  : %d of %d bytes (STACK_SIZE)\n", main_depth + isr_depth, stack_size)
+
+    exit ((main_depth + isr_depth) > stack_size) ? 1 : 0
+}
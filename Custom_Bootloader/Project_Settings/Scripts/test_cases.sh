@@ -0,0 +1,213 @@
+#!/bin/sh
+# Check of the Bootloader_TestCases.xlsx test cases against terminal logs
+#
+# Usage: sh test_cases.sh <Bootloader_TestCases.xlsx> <log dir> [<baseline log dir>]
+#        TOLERANCE=10 sh test_cases.sh ...   (percent of update time allowed over the baseline)
+#        sh test_cases.sh -list <Bootloader_TestCases.xlsx>
+#
+# The cases are read from the workbook, it stays the only list of scenarios.
+# Each case is run on the board as its TEST STEPS say, with the terminal
+# captured to <log dir>/<TEST CASE ID>.log. A case passes if its log holds the
+# message quoted in its EXPECTED RESULT (case is ignored), a case without a
+# quoted message is reported MANUAL. The RESULT line of the log gives the
+# outcome of the boot and the STAT line the update time: with a baseline log
+# directory, a case whose time_ms grew more than TOLERANCE percent fails, and
+# so does a case whose outcome changed: the RESULT statuses of its boots and,
+# in the logs of the host board (Tests/test_cases_host.sh), the "test_board:"
+# end of each boot. -list prints one case per line for a runner, tab separated:
+# ID, TEST CASE, TEST STEPS and TEST DATA (rows joined by " | "), EXPECTED RESULT.
+# Exits 1 if a case failed or has no log. Needs unzip.
+
+TOLERANCE=${TOLERANCE:-10}
+
+list=""
+if [ "$1" = "-list" ]; then
+    list=1
+    shift
+fi
+if [ $# -lt 1 ] || [ ! -r "$1" ] || { [ -z "$list" ] && [ ! -d "$2" ]; }; then
+    echo "usage: sh test_cases.sh <Bootloader_TestCases.xlsx> <log dir> [<baseline log dir>]" >&2
+    echo "       sh test_cases.sh -list <Bootloader_TestCases.xlsx>" >&2
+    exit 2
+fi
+
+work=$(mktemp -d) || exit 2
+
+# One shared string per line (line 1 is the XML header), one sheet cell per line
+unzip -p "$1" xl/sharedStrings.xml | tr '\r\n' '  ' | sed 's/<si>/\n/g' > "$work/strings" &&
+unzip -p "$1" xl/worksheets/sheet1.xml | tr '\r\n' '  ' | sed 's/<c /\n<c /g' > "$work/cells" || {
+    echo "test_cases.sh: $1 is not a readable workbook" >&2
+    rm -rf "$work"
+    exit 2
+}
+
+awk -v list="$list" -v logs="$2" -v baseline="$3" -v tolerance="$TOLERANCE" '
+function unescape(str)
+{
+    gsub(/<[^>]*>/, "", str)
+    gsub(/&quot;/, "\"", str)
+    gsub(/&apos;/, "\047", str)
+    gsub(/&lt;/, "<", str)
+    gsub(/&gt;/, ">", str)
+    gsub(/&amp;/, "\\&", str)
+    gsub(/  +/, " ", str)
+    return str
+}
+
+# Read a log: sets log_text (lower case), log_result, log_outcome and log_time, returns 0 if there is no log
+function read_log(file,    line, found)
+{
+    log_text = ""
+    log_result = "-"
+    log_outcome = ""
+    log_time = ""
+    found = 0
+    while ((getline line < file) > 0)
+    {
+        found = 1
+        sub(/\r$/, "", line)
+        log_text = log_text "\n" tolower(line)
+        if (match(line, /RESULT status=[a-z_]+/))
+        {
+            log_result = substr(line, RSTART + 14, RLENGTH - 14)
+            log_outcome = log_outcome " " log_result
+        }
+        if (match(line, /^test_board: .* after [0-9]+ ms/))
+        {
+            log_outcome = log_outcome " [" substr(line, 13, index(line, " after ") - 13) "]"
+        }
+        if (match(line, /^STAT .*time_ms=[0-9]+/))
+        {
+            log_time = substr(line, index(line, "time_ms=") + 8)
+            sub(/ .*/, "", log_time)
+        }
+    }
+    close(file)
+    return found
+}
+
+FNR == NR {
+    string[NR - 2] = unescape($0)
+    next
+}
+
+match($0, /^<c r="[A-Z]+[0-9]+"/) && /t="s"/ && match($0, /<v>[0-9]+<\/v>/) {
+    match($0, /r="[A-Z]+/)
+    column = substr($0, RSTART + 3, RLENGTH - 3)
+    match($0, /r="[A-Z]+[0-9]+/)
+    row = substr($0, RSTART + 3 + length(column), RLENGTH - 3 - length(column)) + 0
+    match($0, /<v>[0-9]+<\/v>/)
+    cell[column, row] = string[substr($0, RSTART + 3, RLENGTH - 7) + 0]
+    if (row > last_row)
+    {
+        last_row = row
+    }
+}
+
+# The text of the rows of a column from a case row to the next one
+function rows(column, first, next_row,    row, text)
+{
+    text = ""
+    for (row = first; row < next_row; row++)
+    {
+        if (cell[column, row] != "")
+        {
+            gsub(/[\t\n]/, " ", cell[column, row])
+            text = text ((text == "") ? "" : " | ") cell[column, row]
+        }
+    }
+    return text
+}
+
+END {
+    if (list != "")
+    {
+        for (row = 1; row <= last_row; row++)
+        {
+            if (cell["B", row] !~ /^TC_/)
+            {
+                continue
+            }
+            for (next_row = row + 1; (next_row <= last_row) && (cell["B", next_row] !~ /^TC_/); next_row++)
+            {
+            }
+            printf("%s\t%s\t%s\t%s\t%s\n", cell["B", row], rows("D", row, next_row), rows("F", row, next_row),
+                   rows("G", row, next_row), rows("H", row, row + 1))
+        }
+        exit 0
+    }
+
+    failed = 0
+    cases = 0
+    for (row = 1; row <= last_row; row++)
+    {
+        id = cell["B", row]
+        if (id !~ /^TC_/)
+        {
+            continue
+        }
+        cases++
+        expected = cell["H", row]
+        message = ""
+        if (match(expected, /"[^"]+"/))
+        {
+            message = tolower(substr(expected, RSTART + 1, RLENGTH - 2))
+        }
+
+        status = "PASS"
+        timing = ""
+        if (!read_log(logs "/" id ".log"))
+        {
+            status = "NO_LOG"
+        }
+        else if (message == "")
+        {
+            status = "MANUAL"
+        }
+        else if (index(log_text, message) == 0)
+        {
+            status = "FAIL"
+        }
+        result = log_result
+        outcome = log_outcome
+        time_ms = log_time
+
+        if ((baseline != "") && (status != "NO_LOG") && read_log(baseline "/" id ".log") && (outcome != log_outcome))
+        {
+            status = "CHANGED"
+            changed = log_outcome
+        }
+
+        if ((baseline != "") && (time_ms != "") && read_log(baseline "/" id ".log") && (log_time != ""))
+        {
+            timing = sprintf("%d ms (baseline %d ms)", time_ms, log_time)
+            if ((time_ms + 0) * 100 > (log_time + 0) * (100 + tolerance))
+            {
+                status = "SLOW"
+            }
+        }
+        else if (time_ms != "")
+        {
+            timing = sprintf("%d ms", time_ms)
+        }
+
+        if ((status != "PASS") && (status != "MANUAL"))
+        {
+            failed++
+        }
+        printf("%-11s %-7s %-14s %-28s %s\n", id, status, result, timing, cell["D", row])
+        if (status == "CHANGED")
+        {
+            printf("%-11s         outcome:%s, baseline:%s\n", "", outcome, changed)
+        }
+        else if (status != "PASS")
+        {
+            printf("%-11s         expected: %s\n", "", expected)
+        }
+    }
+    printf("%d cases, %d failed\n", cases, failed)
+    exit (failed != 0)
+}' "$work/strings" "$work/cells"
+status=$?
+rm -rf "$work"
+exit $status
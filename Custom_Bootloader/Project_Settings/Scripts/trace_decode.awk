@@ -0,0 +1,143 @@
+# Decoder of the trace timelines of a bootloader terminal log
+#
+# Usage: awk -f trace_decode.awk [-v hz=48000000] [-v csv=1] <terminal log>
+#
+# The timeline is sent after "Trace  :" at the end of an update and on
+# "#TRACE". Each one is printed in milliseconds with the delta to the
+# previous phase in microseconds; the param of the address phases (first
+# record, sector, jump) is printed in hex. The core clock is the core_hz= of
+# the INFO or STAT line of the log, 48 MHz if there is none. The cycle count
+# wraps after 2^32 cycles, a delta across the wrap is corrected. With csv=1
+# one "dump,ms,delta_us,phase,param" row is printed per record.
+
+function hex(value,    str, digit)
+{
+    str = ""
+    do
+    {
+        digit = value % 16
+        str = substr("0123456789ABCDEF", digit + 1, 1) str
+        value = (value - digit) / 16
+    } while (value > 0)
+    return "0x" str
+}
+
+function flush_dump(    i, param)
+{
+    if (records == 0)
+    {
+        return
+    }
+    if (!csv)
+    {
+        printf("Trace %d: %d records, core clock %d Hz\n", dump, records - gaps, clock)
+        printf("%12s %12s  %-13s %s\n", "ms", "+us", "phase", "param")
+    }
+    for (i = 1; i <= records; i++)
+    {
+        if (phase[i] == "")
+        {
+            if (!csv)
+            {
+                printf("%12s %12s  ... %d records overwritten\n", "", "", param_of[i])
+            }
+            continue
+        }
+        param = param_of[i]
+        if ((phase[i] == "first record") || (phase[i] == "sector") || (phase[i] == "jump"))
+        {
+            param = hex(param)
+        }
+        if (csv)
+        {
+            printf("%d,%.3f,%.1f,%s,%s\n", dump, cycles[i] * 1000 / clock, delta[i] * 1000000 / clock, phase[i], param)
+        }
+        else
+        {
+            printf("%12.3f %12.1f  %-13s %s\n", cycles[i] * 1000 / clock, delta[i] * 1000000 / clock, phase[i], param)
+        }
+    }
+    if (!csv && (update_bytes != ""))
+    {
+        printf("Update: %d bytes in %.3f ms, %d B/s\n", update_bytes, update_cycles * 1000 / clock,
+               (update_cycles > 0) ? update_bytes * clock / update_cycles : 0)
+    }
+    records = 0
+    gaps = 0
+    update_bytes = ""
+}
+
+BEGIN {
+    clock = (hz != "") ? hz + 0 : 0
+    dump = 0
+    records = 0
+    if (csv)
+    {
+        print "dump,ms,delta_us,phase,param"
+    }
+}
+
+{
+    sub(/\r$/, "")
+}
+
+# The core clock of the log, unless given
+(hz == "") && match($0, /core_hz=[0-9]+/) {
+    clock = substr($0, RSTART + 8, RLENGTH - 8) + 0
+}
+
+/^Trace  : cycles/ {
+    # The clock may only come with the STAT line sent before the timeline
+    if (clock == 0)
+    {
+        clock = 48000000
+    }
+    flush_dump()
+    dump++
+    in_dump = 1
+    wraps = 0
+    next
+}
+
+# "         <cycles>, +<delta>, <phase>, <param>"
+in_dump && /^ +[0-9]+, \+[0-9]+, / {
+    records++
+    split($0, field, ", ")
+    # A timestamp lower than the previous one is past the 32-bit wrap
+    if ((records > 1) && (field[1] + 0 < previous))
+    {
+        wraps += 4294967296
+    }
+    previous = field[1] + 0
+    cycles[records] = previous + wraps
+    delta[records] = substr(field[2], 2) + 0
+    phase[records] = field[3]
+    param_of[records] = field[4]
+    next
+}
+
+in_dump && /^ +\.\.\. [0-9]+ records overwritten/ {
+    records++
+    gaps++
+    phase[records] = ""
+    param_of[records] = $2 + 0
+    next
+}
+
+in_dump && /^Update : [0-9]+ bytes in [0-9]+ cycles/ {
+    update_bytes = $3 + 0
+    update_cycles = $6 + 0
+    next
+}
+
+in_dump {
+    in_dump = 0
+}
+
+END {
+    if (clock == 0)
+    {
+        clock = 48000000
+    }
+    flush_dump()
+}
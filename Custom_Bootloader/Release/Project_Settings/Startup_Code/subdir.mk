@@ -0,0 +1,38 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../Project_Settings/Startup_Code/system_MKL46Z4.c 
+
+S_UPPER_SRCS += \
+../Project_Settings/Startup_Code/startup_MKL46Z4.S 
+
+OBJS += \
+./Project_Settings/Startup_Code/startup_MKL46Z4.o \
+./Project_Settings/Startup_Code/system_MKL46Z4.o 
+
+C_DEPS += \
+./Project_Settings/Startup_Code/system_MKL46Z4.d 
+
+S_UPPER_DEPS += \
+./Project_Settings/Startup_Code/startup_MKL46Z4.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+Project_Settings/Startup_Code/%.o: ../Project_Settings/Startup_Code/%.S
+	@echo 'Building file: $<'
+	@echo 'Invoking: Cross ARM GNU Assembler'
+	arm-none-eabi-gcc -mcpu=cortex-m0plus -mthumb -Os -flto -fmessage-length=0 -fsigned-char -ffunction-sections -fdata-sections  -g -x assembler-with-cpp -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+Project_Settings/Startup_Code/%.o: ../Project_Settings/Startup_Code/%.c
+	@echo 'Building file: $<'
+	@echo 'Invoking: Cross ARM C Compiler'
+	arm-none-eabi-gcc -mcpu=cortex-m0plus -mthumb -Os -flto -fmessage-length=0 -fsigned-char -ffunction-sections -fdata-sections  -g -fstack-usage -I"../Sources" -I"../Includes" -std=c99 -DBASE_APP_ADDRESS=$(APP_BASE_ADDRESS) -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
@@ -0,0 +1,38 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+O_SRCS := 
+CPP_SRCS := 
+C_UPPER_SRCS := 
+C_SRCS := 
+S_UPPER_SRCS := 
+OBJ_SRCS := 
+ASM_SRCS := 
+CXX_SRCS := 
+C++_SRCS := 
+CC_SRCS := 
+C++_DEPS := 
+OBJS := 
+C_DEPS := 
+ASM_DEPS := 
+CC_DEPS := 
+CPP_DEPS := 
+CXX_DEPS := 
+C_UPPER_DEPS := 
+S_UPPER_DEPS := 
+
+# Every subdirectory with source files must be described here
+SUBDIRS := \
+Sources \
+Sources/Srec \
+Sources/Queue \
+Sources/HAL \
+Sources/Driver \
+Sources/Crc \
+Sources/Event \
+Sources/Trace \
+Sources/Update \
+Sources/Command \
+Project_Settings/Startup_Code \
+
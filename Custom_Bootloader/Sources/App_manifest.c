@@ -0,0 +1,54 @@
+/**
+ * @file  : App_manifest.c
+ * @author: Nguyen The Anh.
+ * @brief : Definition of function using in file App_manifest.c
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include "App_manifest.h"
+#include "Flash_layout.h"
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/**
+ * @brief Check that a manifest describes an image this bootloader can write
+ *
+ * @param manifest: Manifest to check
+ *
+ * @return 1 if the manifest is accepted, 0 if not
+ */
+uint8_t App_manifest_check(const app_manifest *manifest)
+{
+    uint8_t ret_val = 0; /*This variable stores the function return value*/
+
+    /*The load range must lie in the App region and hold the vector table. The start is checked
+     *before the size is compared with the room left, so neither the room nor the end can wrap*/
+    if ((0 != manifest) &&
+        (0u == (manifest->flags & ~APP_MANIFEST_FLAG_MASK)) &&
+        (0u != manifest->load_size) &&
+        (manifest->load_address >= BASE_APP_ADDRESS) &&
+        (manifest->load_address < (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE)) &&
+        (manifest->load_size <= (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE - manifest->load_address)) &&
+        (manifest->entry_address >= manifest->load_address) &&
+        (manifest->entry_address - manifest->load_address < manifest->load_size) &&
+        (0u == (manifest->entry_address % VECTOR_TABLE_ALIGNMENT)))
+    {
+        ret_val = 1;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+/*EOF*/
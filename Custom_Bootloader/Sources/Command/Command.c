@@ -0,0 +1,474 @@
+/**
+ * @file  : Command.c
+ * @author: Nguyen The Anh.
+ * @brief : Definition of function using in file Command.c
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include "../Includes/Command/Command.h"
+#include "../Includes/Update/Update.h"
+#include "../Includes/Update/Verify.h"
+#include "../Includes/Driver/Driver_UART0.h"
+#include "../Includes/Queue/Queque.h"
+#include "../Includes/HAL/FLASH.h"
+#include "../Includes/Trace/Trace.h"
+#include "../Includes/Crc/Crc32.h"
+#include "App_manifest.h"
+#include <stddef.h>
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*#PACE 1: each processed S-record line is acknowledged, the host keeps at most the queue depth in flight*/
+static uint8_t s_pace_lines = 0;
+
+/*******************************************************************************
+ * Static functions prototype
+ ******************************************************************************/
+
+/**
+ * @brief Check if a received line is a given host command
+ *
+ * @param line: Received line
+ * @param command: Command name after the prefix
+ *
+ * @return 1 if the line is the command, 0 if not
+ */
+static uint8_t Is_command(const uint8_t *line, const char *command);
+
+/**
+ * @brief Get a numeric argument of a command line, decimal or 0x hexadecimal
+ *
+ * @param line: Received line
+ * @param index: Position of the argument, 0 is the first after the command name
+ * @param value: Pointer to store the argument
+ *
+ * @return 1 if the argument is a number of at most 8 hexadecimal or 10 decimal digits that fits
+ *         in 32 bits, 0 if not
+ */
+static uint8_t Get_command_argument(const uint8_t *line, uint8_t index, uint32_t *value);
+
+/**
+ * @brief Send the CRC-32 of a flash range, or of each sector of a range, of the App region
+ *
+ * @param address: Address of the first byte
+ * @param size: Number of bytes
+ * @param sector_size: Bytes per CRC, size for a single CRC of the range
+ *
+ * @return: This function return nothing
+ */
+static void Print_flash_crc(uint32_t address, uint32_t size, uint32_t sector_size);
+
+/**
+ * @brief Answer a host command line received in boot mode, before any flash work
+ *
+ * @param line: Received line, starting with BOOT_COMMAND_PREFIX
+ * @param info: Boot information block, clocks reported by #INFO
+ *
+ * @return: This function return nothing
+ */
+static void Handle_command(const uint8_t *line, const boot_info *info);
+
+/**
+ * @brief Send the identity of the installed App: manifest, version and CRC
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+static void Print_app_identity(void);
+
+/**
+ * @brief Send the device information and capabilities the host can negotiate with
+ *
+ * @param info: Boot information block, clocks of the bootloader
+ *
+ * @return: This function return nothing
+ */
+static void Print_device_info(const boot_info *info);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/**
+ * @brief Check if a received line is a given host command
+ */
+static uint8_t Is_command(const uint8_t *line, const char *command)
+{
+    uint32_t i = 0; /*i is used for traversaling the loop*/
+
+    /*Compare the name after the prefix, the line ends or the arguments start after it*/
+    while (('\0' != command[i]) && (line[i + 1u] == (uint8_t)command[i]))
+    {
+        i++;
+    }
+
+    return (('\0' == command[i]) && (('\0' == line[i + 1u]) || (' ' == line[i + 1u]))) ? 1u : 0u;
+}
+
+/**
+ * @brief Get a numeric argument of a command line, decimal or 0x hexadecimal
+ */
+static uint8_t Get_command_argument(const uint8_t *line, uint8_t index, uint32_t *value)
+{
+    uint8_t ret_val = 0;      /*This variable stores the function return value*/
+    uint32_t i = 0;           /*i is used for traversaling the line*/
+    uint32_t base = 10;       /*This variable stores the base of the number*/
+    uint32_t digit = 0;       /*This variable stores the value of a digit*/
+    uint32_t digits = 0;      /*This variable counts the digits of the argument*/
+    uint8_t separators = 0;   /*This variable counts the spaces before the argument*/
+
+    /*Find the argument: the command name is followed by space separated arguments*/
+    while (('\0' != line[i]) && (separators <= index))
+    {
+        if (' ' == line[i])
+        {
+            separators++;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+        i++;
+    }
+
+    /*line[i] is the first character after the separator*/
+    if ((separators == (index + 1u)) && ('\0' != line[i]) && (' ' != line[i]))
+    {
+        if (('0' == line[i]) && (('x' == line[i + 1u]) || ('X' == line[i + 1u])))
+        {
+            base = 16;
+            i += 2u;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+
+        *value = 0;
+        ret_val = 1;
+
+        while (('\0' != line[i]) && (' ' != line[i]) && (1u == ret_val))
+        {
+            if ((line[i] >= '0') && (line[i] <= '9'))
+            {
+                digit = line[i] - '0';
+            }
+            else if ((16u == base) && (line[i] >= 'A') && (line[i] <= 'F'))
+            {
+                digit = line[i] - 'A' + 10u;
+            }
+            else if ((16u == base) && (line[i] >= 'a') && (line[i] <= 'f'))
+            {
+                digit = line[i] - 'a' + 10u;
+            }
+            else
+            {
+                digit = base;
+            }
+
+            /*A digit past 8 hexadecimal or 10 decimal ones, or one that carries the value past 32
+             *bits, rejects the argument instead of wrapping it*/
+            digits++;
+            if ((digit < base) && (digits <= ((16u == base) ? 8u : 10u)) &&
+                (*value <= ((0xFFFFFFFFu - digit) / base)))
+            {
+                *value = *value * base + digit;
+            }
+            else
+            {
+                ret_val = 0;
+            }
+            i++;
+        }
+
+        /*A 0x prefix alone is not a number*/
+        if (0u == digits)
+        {
+            ret_val = 0;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Send the CRC-32 of a flash range, or of each sector of a range, of the App region
+ */
+static void Print_flash_crc(uint32_t address, uint32_t size, uint32_t sector_size)
+{
+    uint32_t offset = 0; /*offset is used for traversaling the range*/
+    uint32_t length = 0; /*This variable stores the bytes of the current CRC*/
+
+    /*Only the App information sector and the App region are read back*/
+    if ((address >= APP_INFO_ADDRESS) && (address < (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE)) &&
+        (0u != size) && (size <= (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE - address)))
+    {
+        /*No flash command may run on the range*/
+        Update_wait_background_erase(FLASH_DELETED_VALUE);
+
+        Driver_UART0_send_string("\nCRC address=");
+        Driver_UART0_send_number(address);
+        Driver_UART0_send_string(" size=");
+        Driver_UART0_send_number(size);
+        Driver_UART0_send_string(" step=");
+        Driver_UART0_send_number(sector_size);
+        Driver_UART0_send_string(" crc=");
+
+        for (offset = 0; offset < size; offset += sector_size)
+        {
+            length = ((size - offset) < sector_size) ? (size - offset) : sector_size;
+
+            if (0u != offset)
+            {
+                Driver_UART0_send_string(",");
+            }
+            else
+            {
+                /*Do nothing*/
+            }
+            Driver_UART0_send_hex(Crc32_final(Crc32_update(CRC32_INITIAL_VALUE, (const uint8_t *)(address + offset), length)));
+        }
+    }
+    else
+    {
+        Driver_UART0_send_string("\nERROR range");
+    }
+
+    return;
+}
+
+/**
+ * @brief Answer a host command line received in boot mode, before any flash work
+ */
+static void Handle_command(const uint8_t *line, const boot_info *info)
+{
+    uint32_t address = 0; /*This variable stores the address argument of a command*/
+    uint32_t size = 0;    /*This variable stores the size argument of a command*/
+
+    /*#QUERY: identity of the installed App, the host skips the update if it matches*/
+    if (1u == Is_command(line, "QUERY"))
+    {
+        Print_app_identity();
+    }
+    /*#INFO: layout, formats, buffer sizes and link settings of this bootloader*/
+    else if (1u == Is_command(line, "INFO"))
+    {
+        Print_device_info(info);
+    }
+    /*#PACE <0|1>: acknowledge each processed S-record line, the host sends the next one on the ACK*/
+    else if ((1u == Is_command(line, "PACE")) && (1u == Get_command_argument(line, 0, &address)) && (address <= 1u))
+    {
+        s_pace_lines = (uint8_t)address;
+
+        /*The line being received when the queue wraps must find a free element*/
+        Driver_UART0_send_string("\nPACE on=");
+        Driver_UART0_send_number(s_pace_lines);
+        Driver_UART0_send_string(" window=");
+        Driver_UART0_send_number(MAX_QUEQUE_SIZE - 1u);
+    }
+    /*#AUTOBAUD <errors per 1000 bytes>: step the baud rate down on line errors, 0 to disable. The
+     *host follows the "BAUD <rate>" line sent at the old baud rate before each step-down. The nodes
+     *of a multi-drop line share one baud rate, they do not step down*/
+    else if ((1u == Is_command(line, "AUTOBAUD")) && (1u == Get_command_argument(line, 0, &address)) &&
+             (address <= 1000u) && (0u == BOOT_NODE_ADDRESS))
+    {
+        Driver_UART0_set_error_rate((uint16_t)address);
+
+        Driver_UART0_send_string("\nAUTOBAUD rate=");
+        Driver_UART0_send_number(Driver_UART0_get_error_rate());
+        Driver_UART0_send_string(" window=");
+        Driver_UART0_send_number(UART0_ERROR_WINDOW_BYTES);
+    }
+    /*#TRACE: timeline of the boot and update phases, decoded by trace_decode.awk*/
+    else if (1u == Is_command(line, "TRACE"))
+    {
+        Trace_dump();
+    }
+    /*#STATUS: result of the update, collected from each node of a multi-drop line*/
+    else if (1u == Is_command(line, "STATUS"))
+    {
+        Update_print_status();
+    }
+    /*#CRC <address> <size>: CRC-32 of a flash range*/
+    else if ((1u == Is_command(line, "CRC")) && (1u == Get_command_argument(line, 0, &address)) &&
+             (1u == Get_command_argument(line, 1, &size)))
+    {
+        Print_flash_crc(address, size, size);
+    }
+    /*#SECTORS <first sector> <count>: CRC-32 of each sector*/
+    else if ((1u == Is_command(line, "SECTORS")) && (1u == Get_command_argument(line, 0, &address)) &&
+             (1u == Get_command_argument(line, 1, &size)) && (address < (FLASH_TOTAL_SIZE / FLASH_SECTOR_SIZE)) &&
+             (size <= (FLASH_TOTAL_SIZE / FLASH_SECTOR_SIZE)))
+    {
+        Print_flash_crc(FLASH_BASE_ADDRESS + address * FLASH_SECTOR_SIZE, size * FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE);
+    }
+    else
+    {
+        Driver_UART0_send_string("\nERROR unknown command");
+    }
+
+    Driver_UART0_send_string("\n");
+
+    return;
+}
+
+/**
+ * @brief Send the identity of the installed App: manifest, version and CRC
+ */
+static void Print_app_identity(void)
+{
+    uint8_t manifest = 0; /*This variable indicates if the installed App has a manifest*/
+
+    manifest = (APP_MANIFEST_MAGIC == Read_FlashAddress(APP_HEADER_LOCATION)) ? 1u : 0u;
+
+    /*The fields are cached in the App information sector, nothing is computed over the App*/
+    Driver_UART0_send_string("\nQUERY valid=");
+    Driver_UART0_send_number(Update_is_app_valid());
+    Driver_UART0_send_string(" manifest=");
+    Driver_UART0_send_number(manifest);
+    Driver_UART0_send_string(" entry=");
+    Driver_UART0_send_number(Read_FlashAddress(APP_START_ADDRESS_LOCATION));
+    Driver_UART0_send_string(" sectors=");
+    Driver_UART0_send_number(Read_FlashAddress(APP_SIZE_LOCATION));
+
+    if (1u == manifest)
+    {
+        Driver_UART0_send_string(" version=");
+        Driver_UART0_send_number(Read_FlashAddress(APP_HEADER_LOCATION + offsetof(app_manifest, version)));
+        Driver_UART0_send_string(" load=");
+        Driver_UART0_send_number(Read_FlashAddress(APP_HEADER_LOCATION + offsetof(app_manifest, load_address)));
+        Driver_UART0_send_string(" size=");
+        Driver_UART0_send_number(Read_FlashAddress(APP_HEADER_LOCATION + offsetof(app_manifest, load_size)));
+        Driver_UART0_send_string(" crc=");
+        Driver_UART0_send_hex(Read_FlashAddress(APP_HEADER_LOCATION + offsetof(app_manifest, image_crc)));
+        Driver_UART0_send_string(" flags=");
+        Driver_UART0_send_number(Read_FlashAddress(APP_HEADER_LOCATION + offsetof(app_manifest, flags)));
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/**
+ * @brief Send the device information and capabilities the host can negotiate with
+ */
+static void Print_device_info(const boot_info *info)
+{
+    uint8_t i = 0; /*i is used for traversaling the loop*/
+
+    /*Flash layout*/
+    Driver_UART0_send_string("\nINFO protocol=1 flash=");
+    Driver_UART0_send_number(FLASH_TOTAL_SIZE);
+    Driver_UART0_send_string(" sector=");
+    Driver_UART0_send_number(FLASH_SECTOR_SIZE);
+    Driver_UART0_send_string(" block=");
+    Driver_UART0_send_number(FLASH_BLOCK_SIZE);
+    Driver_UART0_send_string(" app_base=");
+    Driver_UART0_send_number(BASE_APP_ADDRESS);
+    Driver_UART0_send_string(" app_end=");
+    Driver_UART0_send_number(FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE);
+    Driver_UART0_send_string(" info=");
+    Driver_UART0_send_number(APP_INFO_ADDRESS);
+
+    /*Transfer formats and buffers: S-record with 16, 24 or 32 bit addresses, S0 text or manifest*/
+    Driver_UART0_send_string(" formats=S1,S2,S3,manifest commands=QUERY,INFO,CRC,SECTORS,STATUS,COMMIT,PACE,AUTOBAUD,TRACE line=");
+    Driver_UART0_send_number(QUEUE_LINE_SIZE - 1u);
+    Driver_UART0_send_string(" lines=");
+    Driver_UART0_send_number(MAX_QUEQUE_SIZE);
+    Driver_UART0_send_string(" staging=");
+    Driver_UART0_send_number(STAGING_BUFFER_SIZE);
+
+    /*Link and clocks*/
+    Driver_UART0_send_string(" baud=");
+    Driver_UART0_send_number(Driver_UART0_get_baud_rate());
+    Driver_UART0_send_string(" bauds=");
+    for (i = 0; 0u != Driver_UART0_get_supported_baud(i); i++)
+    {
+        if (0u != i)
+        {
+            Driver_UART0_send_string(",");
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+        Driver_UART0_send_number(Driver_UART0_get_supported_baud(i));
+    }
+    Driver_UART0_send_string(" core_hz=");
+    Driver_UART0_send_number(info->core_clock);
+    Driver_UART0_send_string(" uart_hz=");
+    Driver_UART0_send_number(info->peripheral_clock);
+    Driver_UART0_send_string(" node=");
+    Driver_UART0_send_number(BOOT_NODE_ADDRESS);
+
+    return;
+}
+
+/**
+ * @brief Answer a host command line received in boot mode, #COMMIT ends a complete multi-drop update
+ *
+ * @param line: Received line, starting with BOOT_COMMAND_PREFIX
+ * @param info: Boot information block, clocks reported by #INFO
+ *
+ * @return UPDATE_CONTINUE while the update goes on, BOOT_RESULT_SUCCESS once #COMMIT has marked the App valid
+ */
+uint32_t Command_handle(const uint8_t *line, const boot_info *info)
+{
+    uint32_t ret_val = UPDATE_CONTINUE; /*This variable stores the function return value*/
+
+    /*#COMMIT: a multi-drop update ends once the image of this node is complete and good*/
+    if ((1u == Update_is_image_complete()) && (1u == Is_command(line, "COMMIT")))
+    {
+        if (1u == Update_commit())
+        {
+            Driver_UART0_send_string("\nCOMMIT ok\n");
+            ret_val = BOOT_RESULT_SUCCESS;
+        }
+        else
+        {
+            Driver_UART0_send_string("\nCOMMIT failed");
+            Verify_print_map();
+            Driver_UART0_send_string("\n");
+        }
+    }
+    else
+    {
+        Handle_command(line, info);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Get the pace setting of the host
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if each processed S-record line is acknowledged (#PACE 1), 0 if not
+ */
+uint8_t Command_get_pace(void)
+{
+    return s_pace_lines;
+}
+/*EOF*/
@@ -0,0 +1,71 @@
+/**
+ * @file  : Crc32.c
+ * @author: Nguyen The Anh.
+ * @brief : Definition of function using in file Crc32.c
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include "../Includes/Crc/Crc32.h"
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*CRC-32 of each 4-bit value, polynomial 0xEDB88320: two lookups per byte with 64 bytes of table*/
+static const uint32_t s_crc32_nibble_table[16] = {
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu, 0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu, 0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu};
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/**
+ * @brief Add bytes to a CRC-32 (IEEE 802.3, reflected, as zlib crc32)
+ *
+ * @param crc: Running value, CRC32_INITIAL_VALUE for the first bytes
+ * @param data: Bytes to add
+ * @param length: Number of bytes
+ *
+ * @return: Running value to pass to the next call or to Crc32_final
+ */
+uint32_t Crc32_update(uint32_t crc, const uint8_t *data, uint32_t length)
+{
+    uint32_t i = 0; /*i is used for traversaling the loop*/
+
+    /*Check input*/
+    if (0 != data)
+    {
+        for (i = 0; i < length; i++)
+        {
+            crc ^= data[i];
+            crc = (crc >> 4) ^ s_crc32_nibble_table[crc & 0x0Fu];
+            crc = (crc >> 4) ^ s_crc32_nibble_table[crc & 0x0Fu];
+        }
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Get the CRC-32 of the bytes added so far
+ *
+ * @param crc: Running value
+ *
+ * @return: CRC-32
+ */
+uint32_t Crc32_final(uint32_t crc)
+{
+    return crc ^ 0xFFFFFFFFu;
+}
@@ -58,7 +58,7 @@ void Driver_GPIO_init_pin(GPIO_config_info_t *GPIO_info)
             if(PULL_UP == GPIO_info->pull_type)
             {
                 /*Wait until the Pull up finish setting*/
-                while(i < 100000)
+                while(i < GPIO_PULL_UP_SETTLE_COUNT)
                 {
                     i++;
                 }
@@ -162,4 +162,30 @@ void Driver_GPIO_toggle_pin_state(Port_type_enum_t port_type, uint8_t pin)
 
     return;
 }
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_GPIO_deinit_pin
+* Description: Return a GPIO pin to its reset state.
+*
+END***************************************************************************/
+void Driver_GPIO_deinit_pin(Port_type_enum_t port_type, uint8_t pin)
+{
+    if ((PORT_A <= port_type && port_type <= PORT_E) && (pin < 32))
+    {
+        /*Clear the output latch and set the pin as input*/
+        HAL_GPIO_write_PIN(GPIO_port_array[port_type], pin, (uint8_t)LOW_STATE);
+        HAL_GPIO_set_direct_PIN(GPIO_port_array[port_type], pin, (uint8_t)GPIO_INPUT);
+
+        /*Disable the pull resistor and the pin*/
+        Driver_PORT_set_pull_pin(port_type, pin, PULL_DISABLED);
+        Driver_PORT_set_MUX_pin(port_type, pin, MUX_PIN_DISABLED);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
 /*EOF*/
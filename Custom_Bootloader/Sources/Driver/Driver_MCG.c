@@ -14,16 +14,68 @@
 
 #include "../Includes/HAL/HAL_MCG.h"
 #include "../Includes/Driver/Driver_MCG.h"
+#include "../Includes/Driver/Driver_SIM.h"
 #include <stdlib.h>
 
 /*******************************************************************************
  * Variable
  ******************************************************************************/
 
+/*******************************************************************************
+ * Static functions prototype
+ ******************************************************************************/
+
+/**
+ * @brief Check that the PLL locks with the settings of a PEE profile
+ *
+ * @param clock_config is a struct pointer that has the information about the PEE profile.
+ *
+ * @return 1 if the PLL can be used, 0 if the current clock is kept
+ */
+static uint8_t MCG_is_PLL_config_valid(MCG_clock_config_info *clock_config);
+
 /*******************************************************************************
  * Functions
  ******************************************************************************/
 
+/*Functions*********************************************************************
+*
+* Function name: MCG_is_PLL_config_valid
+* Description: Check that the PLL locks with the settings of a PEE profile
+*
+END***************************************************************************/
+static uint8_t MCG_is_PLL_config_valid(MCG_clock_config_info *clock_config)
+{
+    uint32_t PLL_reference = 0; /*This variable stores the PLL reference clock frequency*/
+    uint32_t VCO_frequency = 0; /*This variable stores the VCO output frequency*/
+    uint8_t ret_val = 0;        /*This variable stores the function return value*/
+
+    /*Check input*/
+    if ((NULL != clock_config) && (0u != clock_config->PLL_divider))
+    {
+        PLL_reference = clock_config->crystal_frequency / clock_config->PLL_divider;
+        VCO_frequency = PLL_reference * clock_config->PLL_multiplier;
+
+        /*The PLL only locks with a 2 - 4 MHz reference and a 48 - 100 MHz VCO*/
+        if ((MCG_PLL_REFERENCE_MIN <= PLL_reference) && (PLL_reference <= MCG_PLL_REFERENCE_MAX) &&
+            (MCG_PLL_VCO_MIN <= VCO_frequency) && (VCO_frequency <= MCG_PLL_VCO_MAX) &&
+            (MCG_PLL_MULTIPLIER_BASE <= clock_config->PLL_multiplier))
+        {
+            ret_val = 1;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
 /*Functions*********************************************************************
 *
 * Function name: Driver_MCG_Init_MCGFLLCLK
@@ -199,4 +251,149 @@ void Driver_MCG_select_FLL_output_range(DCO_range_type_enum_t FLL_range)
 
     return;
 }
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_MCG_Init_clock
+* Description: Init the clock tree according to a clock profile
+*
+END***************************************************************************/
+void Driver_MCG_Init_clock(MCG_clock_config_info *clock_config)
+{
+    /*Check input*/
+    if (NULL != clock_config)
+    {
+        /*Set the dividers first so the core and bus clock never exceed their maximum*/
+        Driver_SIM_CLKDIV1_set_dividers(clock_config->core_divider, clock_config->bus_divider);
+
+        /*If the PLL is used*/
+        if ((MCG_PROFILE_PEE == clock_config->profile) && (1u == MCG_is_PLL_config_valid(clock_config)))
+        {
+            Driver_MCG_Init_MCGPLLCLK(clock_config);
+        }
+        /*If the FLL is used, also for PLL settings it can not lock with*/
+        else
+        {
+            Driver_MCG_Init_MCGFLLCLK(&clock_config->FLL_config);
+        }
+    }
+    /*Any invalid input will be ignored*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_MCG_Init_MCGPLLCLK
+* Description: Init the MCGPLLCLK and switch MCGOUTCLK to the PLL
+*
+END***************************************************************************/
+void Driver_MCG_Init_MCGPLLCLK(MCG_clock_config_info *clock_config)
+{
+    /*Settings the PLL does not lock with keep the current clock*/
+    if (1u == MCG_is_PLL_config_valid(clock_config))
+    {
+        /*FEI -> FBE: start the crystal oscillator and use it as MCGOUTCLK*/
+        HAL_MCG_C2_set_RANGE0(MCG_CRYSTAL_RANGE_HIGH);
+        HAL_MCG_C2_set_EREFS0(1u);
+        HAL_MCG_C1_set_FRDIV(MCG_FLL_EXTERNAL_DIVIDER_256);
+        HAL_MCG_C1_set_IREFS(0u);
+        HAL_MCG_C1_set_CLKS(MCG_CLKS_EXTERNAL);
+
+        /*Wait for the oscillator, the reference switch and the clock switch*/
+        while (0u == HAL_MCG_S_read_OSCINIT0())
+        {
+            /*Do nothing*/
+        }
+        while (0u != HAL_MCG_S_read_IREFST())
+        {
+            /*Do nothing*/
+        }
+        while (MCG_CLKST_EXTERNAL != HAL_MCG_S_read_CLKST())
+        {
+            /*Do nothing*/
+        }
+
+        /*FBE -> PBE: configure and enable the PLL while MCGOUTCLK still bypasses it*/
+        HAL_MCG_C5_set_PRDIV0(clock_config->PLL_divider - 1u);
+        HAL_MCG_C6_set_VDIV0(clock_config->PLL_multiplier - MCG_PLL_MULTIPLIER_BASE);
+        Driver_MCG_select_MCG_source(PLL_SELECTED);
+
+        /*Wait for the PLL to be selected and locked*/
+        while (0u == HAL_MCG_S_read_PLLST())
+        {
+            /*Do nothing*/
+        }
+        while (0u == HAL_MCG_S_read_LOCK0())
+        {
+            /*Do nothing*/
+        }
+
+        /*PBE -> PEE: use the PLL output as MCGOUTCLK*/
+        HAL_MCG_C1_set_CLKS(MCG_CLKS_FLL_PLL);
+        while (MCG_CLKST_PLL != HAL_MCG_S_read_CLKST())
+        {
+            /*Do nothing*/
+        }
+
+        /*Enable MCGPLLCLK for the peripherals*/
+        HAL_MCG_C5_set_PLLCLKEN0((uint8_t)MCGPLLCLK_ACTIVE);
+    }
+    /*Any invalid input will be ignored*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_MCG_get_clock_frequency
+* Description: Calculate the frequencies of the clock tree for a clock profile
+*
+END***************************************************************************/
+void Driver_MCG_get_clock_frequency(MCG_clock_config_info *clock_config, MCG_clock_frequency_info *frequency)
+{
+    /*Check input, the dividers are the ones Driver_SIM_CLKDIV1_set_dividers accepts*/
+    if ((NULL != clock_config) && (NULL != frequency) && (1u <= clock_config->core_divider) &&
+        (clock_config->core_divider <= 16u) && (1u <= clock_config->bus_divider) && (clock_config->bus_divider <= 8u))
+    {
+        /*If the PLL is used, Driver_MCG_Init_clock runs the FLL on PLL settings it can not lock with*/
+        if ((MCG_PROFILE_PEE == clock_config->profile) && (1u == MCG_is_PLL_config_valid(clock_config)))
+        {
+            frequency->MCGFLLCLK = 0;
+            frequency->MCGPLLCLK = (clock_config->crystal_frequency / clock_config->PLL_divider) * clock_config->PLL_multiplier;
+            frequency->MCGOUTCLK = frequency->MCGPLLCLK;
+            /*UART0 is supplied by MCGPLLCLK/2*/
+            frequency->peripheral_clock = frequency->MCGPLLCLK / 2u;
+        }
+        /*If the FLL is used*/
+        else
+        {
+            frequency->MCGFLLCLK = Driver_MCG_get_MCGFLLCLK_frequency(&clock_config->FLL_config);
+            frequency->MCGPLLCLK = 0;
+            frequency->MCGOUTCLK = frequency->MCGFLLCLK;
+            /*UART0 is supplied by MCGFLLCLK*/
+            frequency->peripheral_clock = frequency->MCGFLLCLK;
+        }
+
+        /*Calculate the core and bus clock*/
+        frequency->core_clock = frequency->MCGOUTCLK / clock_config->core_divider;
+        frequency->bus_clock = frequency->core_clock / clock_config->bus_divider;
+    }
+    /*Any invalid input will be ignored*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
 /*EOF*/
@@ -56,7 +56,7 @@ END***************************************************************************/
 void Driver_PORT_set_pull_pin(Port_type_enum_t port_type, uint8_t pin, Pull_type_enum_t pull_type)
 {
     /*Set pull for pin*/
-    if ((pin < 32) && (PORT_A <= port_type && port_type <= PORT_E) && (PULL_DOWN <= pull_type && pull_type <= PULL_UP))
+    if ((pin < 32) && (PORT_A <= port_type && port_type <= PORT_E) && ((PULL_DISABLED == pull_type) || (PULL_DOWN <= pull_type && pull_type <= PULL_UP)))
     {
         HAL_PORT_PCR_set_Pull_pin(port_array[port_type], pin, pull_type);
     }
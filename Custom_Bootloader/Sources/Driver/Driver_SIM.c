@@ -223,4 +223,28 @@ void Driver_SIM_SCGC5_set_PORTn_clock_gate(Port_type_enum_t port, clock_gate_sta
     return;
 }
 
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_SIM_CLKDIV1_set_dividers
+* Description: Set the core clock and bus clock dividers
+*
+END***************************************************************************/
+void Driver_SIM_CLKDIV1_set_dividers(uint8_t core_divider, uint8_t bus_divider)
+{
+    /*Check input. Core clock is divided by 1 -> 16, bus clock is divided by 1 -> 8*/
+    if ((1u <= core_divider) && (core_divider <= 16u) && (1u <= bus_divider) && (bus_divider <= 8u))
+    {
+        /*Write the divider values (divide factor - 1)*/
+        HAL_SIM_CLKDIV1_set_OUTDIV(core_divider - 1u, bus_divider - 1u);
+    }
+    /*Any invalid input will be ignored*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
 /*EOF*/
@@ -17,6 +17,7 @@
 #include "../Includes/HAL/HAL_UART0.h"
 #include "../Includes/Driver/Driver_SIM.h"
 #include "../Includes/Queue/Queque.h"
+#include "../Includes/Event/Event.h"
 #include "MKL46Z4.h"
 #include <stdlib.h>
 
@@ -33,10 +34,223 @@ static volatile uint16_t Rx_buff_index = 0;
 /*This variable stores the byte received from UART0*/
 static volatile uint8_t received_byte;
 
+/*This struct stores the line-quality counters*/
+static volatile uart0_error_counter_info s_error_counters;
+
+/*This struct stores the receive statistics*/
+static volatile uart0_rx_statistic_info s_rx_statistics;
+
+/*These variables store the line errors and the received bytes of the current error rate window*/
+static volatile uint16_t s_window_errors = 0;
+static volatile uint16_t s_window_bytes = 0;
+
+/*This variable stores the line errors per 1000 received bytes that trigger a baud rate step-down,
+ *0 disables it*/
+static uint16_t s_error_rate = 0;
+
+/*This flag indicates the error rate has been crossed, the step-down waits for Driver_UART0_step_down*/
+static volatile uint8_t s_step_down_pending = 0;
+
+/*These variables store the current baud configuration, used to re-calculate the divisor*/
+static uint32_t s_baud_rate = 0;
+static uint32_t s_clock_frequency = 0;
+static uint8_t s_OSR = 0;
+
+/*These variables store the Rx/Tx pins, released by the de-init*/
+static Port_type_enum_t s_Tx_Rx_port = PORT_A;
+static uint8_t s_Tx_pin = 0;
+static uint8_t s_Rx_pin = 0;
+
+/*Multi-drop line: address match mode enabled, address of this node and of all nodes,
+ *transmitter silent because the last address frame was not the node address*/
+static uint8_t s_address_match = 0;
+static uint8_t s_node_address = 0;
+static uint8_t s_broadcast_address = 0;
+static volatile uint8_t s_tx_muted = 0;
+
+/*Baud rates used for automatic step-down, in descending order*/
+static const uint32_t s_step_down_baud[UART0_STEP_DOWN_BAUD_COUNT] = {460800, 230400, 115200, 57600, 38400, 9600};
+
+/*******************************************************************************
+ * Static functions prototype
+ ******************************************************************************/
+
+/**
+ * @brief Count the line errors of each type
+ *
+ * @param error_flags is the OR, NF, FE and PF flags read from S1 register
+ *
+ * @return: This function return nothing
+ */
+static void UART0_handle_line_errors(uint8_t error_flags);
+
+/**
+ * @brief Measure the line error rate over a window of received bytes, a step-down is requested
+ *        once the window holds the error rate
+ *
+ * @param error_flags is the OR, NF, FE and PF flags read from S1 register
+ * @param received is 1 if a byte has been received
+ *
+ * @return: This function return nothing
+ */
+static void UART0_update_error_rate(uint8_t error_flags, uint8_t received);
+
+/**
+ * @brief Get the next lower baud rate in the step-down table
+ *
+ * @param: This function has no parameter
+ *
+ * @return the next lower baud rate, 0 if the baud rate is already the lowest
+ */
+static uint32_t UART0_get_lower_baud_rate(void);
+
+/**
+ * @brief Count the ready lines in the queue and update the peak occupancy
+ *
+ * @param: This function has no param
+ *
+ * @return: This function return nothing
+ */
+static void UART0_update_queue_occupancy(void);
+
 /*******************************************************************************
  * Functions
  ******************************************************************************/
 
+/*Functions*********************************************************************
+*
+* Function name: UART0_handle_line_errors
+* Description: Count the line errors of each type
+*
+END***************************************************************************/
+static void UART0_handle_line_errors(uint8_t error_flags)
+{
+    /*Count each error type*/
+    if (0 != (error_flags & UART0_S1_OR_MASK))
+    {
+        s_error_counters.overrun_count++;
+    }
+    if (0 != (error_flags & UART0_S1_NF_MASK))
+    {
+        s_error_counters.noise_count++;
+    }
+    if (0 != (error_flags & UART0_S1_FE_MASK))
+    {
+        s_error_counters.framing_count++;
+    }
+    if (0 != (error_flags & UART0_S1_PF_MASK))
+    {
+        s_error_counters.parity_count++;
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: UART0_update_error_rate
+* Description: Measure the line error rate over a window of received bytes
+*
+END***************************************************************************/
+static void UART0_update_error_rate(uint8_t error_flags, uint8_t received)
+{
+    if (0 != error_flags)
+    {
+        s_window_errors++;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+    s_window_bytes += received;
+
+    /*A burst of errors crosses the rate before the window is full, an error every few windows never does*/
+    if ((0 != s_error_rate) && (((uint32_t)s_window_errors * 1000u) >= ((uint32_t)s_error_rate * UART0_ERROR_WINDOW_BYTES)))
+    {
+        s_step_down_pending = 1;
+        s_window_errors = 0;
+        s_window_bytes = 0;
+    }
+    else if (s_window_bytes >= UART0_ERROR_WINDOW_BYTES)
+    {
+        s_window_errors = 0;
+        s_window_bytes = 0;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: UART0_get_lower_baud_rate
+* Description: Get the next lower baud rate in the step-down table
+*
+END***************************************************************************/
+static uint32_t UART0_get_lower_baud_rate(void)
+{
+    uint32_t ret_val = 0; /*This variable stores the function return value*/
+    uint8_t i = 0;        /*i is used for traversaling the loop*/
+
+    /*Find the first baud rate lower than the current one*/
+    while ((i < UART0_STEP_DOWN_BAUD_COUNT) && (s_step_down_baud[i] >= s_baud_rate))
+    {
+        i++;
+    }
+
+    /*If there is a lower baud rate*/
+    if (i < UART0_STEP_DOWN_BAUD_COUNT)
+    {
+        ret_val = s_step_down_baud[i];
+    }
+    /*Already at the lowest baud rate*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Count the ready lines in the queue and update the peak occupancy
+ *
+ * @param: This function has no param
+ *
+ * @return: This function return nothing
+ */
+static void UART0_update_queue_occupancy(void)
+{
+    uint8_t i = 0;         /*i is used for traversaling the loop*/
+    uint8_t occupancy = 0; /*This variable stores the number of ready lines*/
+
+    for (i = 0; i < MAX_QUEQUE_SIZE; i++)
+    {
+        if (QUEUE_ELEMENT_READY == queue.queue_state[i])
+        {
+            occupancy++;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+
+    if (occupancy > s_rx_statistics.peak_queue_occupancy)
+    {
+        s_rx_statistics.peak_queue_occupancy = occupancy;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
 /*Functions*********************************************************************
 *
 * Function name: UART0_IRQHandler
@@ -46,11 +260,42 @@ END***************************************************************************/
 
 void UART0_IRQHandler(void)
 {
+    uint8_t error_flags = 0; /*This variable stores the OR, NF, FE and PF flags*/
+    uint8_t received = 0;    /*This flag indicates if a byte has been received*/
+
+    /*Get the line error flags*/
+    error_flags = HAL_UART0_S1_read_error_flags();
+
+    /*An address frame selects the node the following data is for, it is not part of a line.
+     *The ninth bit must be read before the data register*/
+    if ((0u != s_address_match) && HAL_UART0_S1_read_RDRF() && (1u == HAL_UART0_C3_read_R8()))
+    {
+        received_byte = HAL_UART0_D_read_data();
+        s_rx_statistics.received_bytes++;
+        received = 1;
+
+        /*Only the node address lets this node answer, a partial line is dropped*/
+        s_tx_muted = (s_node_address == received_byte) ? 0u : 1u;
+        Rx_buff_index = 0;
+
+        /*The match address mode discards every data frame: it is left for the data that follows
+         *the node or broadcast address, the address of another node turns it on again*/
+        if ((s_node_address == received_byte) || (s_broadcast_address == received_byte))
+        {
+            HAL_UART0_C4_set_MAEN(0);
+        }
+        else
+        {
+            HAL_UART0_C4_set_MAEN(1);
+        }
+    }
     /*If receiver send interrupt request*/
-    if (HAL_UART0_S1_read_RDRF())
+    else if (HAL_UART0_S1_read_RDRF())
     {
         /*Get the data byte*/
         received_byte = HAL_UART0_D_read_data();
+        s_rx_statistics.received_bytes++;
+        received = 1;
 
         if (Queue_IsEmpty(&queue) == 1)
         {
@@ -64,8 +309,23 @@ void UART0_IRQHandler(void)
         /*Check the received data*/
         if (('\r' != received_byte) && ('\n' != received_byte) && ('\0' != received_byte))
         {
-            /*Add the received data to end element in queue*/
-            queue.record[queue.end][Rx_buff_index++] = received_byte;
+            /*Add the received data to end element in queue, the end of a too long line is dropped
+             *and the truncated line fails its check*/
+            if (Rx_buff_index < (QUEUE_LINE_SIZE - 1u))
+            {
+                queue.record[queue.end][Rx_buff_index++] = received_byte;
+            }
+            else
+            {
+                s_rx_statistics.dropped_bytes++;
+            }
+        }
+        /*The end element is the only free one, the others hold lines that have not been read: the
+         *line is dropped, queueing it would move the end index onto the first line*/
+        else if ((received_byte == '\n') && (((queue.end + 1u) % MAX_QUEQUE_SIZE) == queue.first))
+        {
+            s_rx_statistics.dropped_bytes += Rx_buff_index + 1u;
+            Rx_buff_index = 0;
         }
         /*If received data is NULL character*/
         else if (received_byte == '\n')
@@ -77,7 +337,13 @@ void UART0_IRQHandler(void)
             /*Set element state to 1 to indicate a line has been fully received*/
             queue.queue_state[queue.end] = 1;
 
+            /*Update the peak number of lines waiting to be read*/
+            UART0_update_queue_occupancy();
+
             Queue_Enqueue(&queue);
+
+            /*Wake the main loop to process the line*/
+            Event_post(EVENT_UART_RX);
         }
         else
         {
@@ -89,6 +355,22 @@ void UART0_IRQHandler(void)
         /*Do nothing*/
     }
 
+    /*If there is any line error*/
+    if (0 != error_flags)
+    {
+        /*Count the errors*/
+        UART0_handle_line_errors(error_flags);
+        /*Clear the flags, the receiver is blocked while OR is set*/
+        HAL_UART0_S1_clear_error_flags(error_flags);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    /*The error rate counts the errors against the received bytes*/
+    UART0_update_error_rate(error_flags, received);
+
     return;
 }
 
@@ -136,6 +418,19 @@ void Driver_UART0_init(uart0_config_info *uart0_config, uint32_t clock_frequency
         Driver_UART0_select_Rx_IRQ_state(uart0_config->receiver_IRQ);
         /*Set the UART0 transmitter interrupt request to be disabled to prevent always jump to IRQ handler*/
         Driver_UART0_select_Tx_IRQ_state(TRANSMIT_IRQ_DISABLED);
+        /*Error interrupts follow the receiver interrupt so an overrun never stalls reception*/
+        HAL_UART0_C3_set_error_IRQ((uint8_t)uart0_config->receiver_IRQ);
+
+        /*Store the baud configuration for the automatic step-down*/
+        s_baud_rate = uart0_config->baud_rate;
+        s_OSR = uart0_config->OSR;
+        s_clock_frequency = clock_frequency;
+        s_error_rate = uart0_config->error_rate;
+
+        /*Store the pins for the de-init*/
+        s_Tx_Rx_port = uart0_config->Tx_Rx_port;
+        s_Tx_pin = uart0_config->Tx_pin;
+        s_Rx_pin = uart0_config->Rx_pin;
     }
     /*Any invalid input will be ignored*/
     else
@@ -146,6 +441,50 @@ void Driver_UART0_init(uart0_config_info *uart0_config, uint32_t clock_frequency
     return;
 }
 
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_deinit
+* Description: De-init the UART0 module and release its pins and clock
+*
+END***************************************************************************/
+void Driver_UART0_deinit(void)
+{
+    /*Wait until the last character has been shifted out*/
+    while (0 == HAL_UART0_S1_read_TC())
+    {
+        /*Do nothing*/
+    }
+
+    /*Disable the UART0 interrupt in NVIC and the interrupt requests in UART0*/
+    NVIC_DisableIRQ(UART0_IRQn);
+    Driver_UART0_select_Rx_IRQ_state(RECEIVE_IRQ_DISABLED);
+    Driver_UART0_select_Tx_IRQ_state(TRANSMIT_IRQ_DISABLED);
+    HAL_UART0_C3_set_error_IRQ(0);
+
+    /*Disable the receiver and the transmitter*/
+    Driver_UART0_select_Rx_state(RECEIVER_DISABLED);
+    Driver_UART0_select_Tx_state(TRANSMITTER_DISABLED);
+
+    /*Leave the multi-drop mode*/
+    HAL_UART0_C4_set_MAEN(0);
+    Driver_UART0_select_data_length(DATA_8BITS);
+    s_address_match = 0;
+    s_tx_muted = 0;
+
+    /*Clear the line error flags and the pending interrupt*/
+    HAL_UART0_S1_clear_error_flags(HAL_UART0_S1_read_error_flags());
+    NVIC_ClearPendingIRQ(UART0_IRQn);
+
+    /*Release the Rx and Tx pins*/
+    Driver_PORT_set_MUX_pin(s_Tx_Rx_port, s_Rx_pin, MUX_PIN_DISABLED);
+    Driver_PORT_set_MUX_pin(s_Tx_Rx_port, s_Tx_pin, MUX_PIN_DISABLED);
+
+    /*Disable clock gate for UART0*/
+    Driver_SIM_SCGC4_set_UART0_clock_gate(DISABLED);
+
+    return;
+}
+
 /*Functions*********************************************************************
 *
 * Function name: Driver_UART0_select_data_length
@@ -420,12 +759,20 @@ uint8_t Driver_UART0_receive_data_byte(void)
 END***************************************************************************/
 void Driver_UART0_send_data_byte(uint8_t byte_data)
 {
-    while (!Driver_UART0_Is_transmit_ready())
+    /*On a multi-drop line only the addressed node transmits*/
+    if (0u == s_tx_muted)
     {
-        /*Wait for the transmit register is ready*/
+        while (!Driver_UART0_Is_transmit_ready())
+        {
+            /*Wait for the transmit register is ready*/
+        }
+        /*Write data to the data register*/
+        HAL_UART0_D_write_data(byte_data);
+    }
+    else
+    {
+        /*Do nothing*/
     }
-    /*Write data to the data register*/
-    HAL_UART0_D_write_data(byte_data);
 
     return;
 }
@@ -476,6 +823,339 @@ void Driver_UART0_send_string(uint8_t *str)
     return;
 }
 
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_send_number
+* Description: Send an unsigned decimal number by UART0
+*
+END***************************************************************************/
+void Driver_UART0_send_number(uint32_t number)
+{
+    uint8_t digits[11] = {0}; /*This array stores the decimal digits in reverse order*/
+    uint8_t i = 0;            /*This variable is used to traversal the array*/
+
+    /*Get the digits from the lowest one*/
+    do
+    {
+        digits[i++] = '0' + (number % 10u);
+        number /= 10u;
+    } while (0u != number);
+
+    /*Send the digits from the highest one*/
+    while (0u != i)
+    {
+        Driver_UART0_send_data_byte(digits[--i]);
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_send_number64
+* Description: Send an unsigned 64-bit decimal number by UART0
+*
+END***************************************************************************/
+void Driver_UART0_send_number64(uint64_t number)
+{
+    uint8_t digits[20] = {0}; /*This array stores the decimal digits in reverse order*/
+    uint8_t i = 0;            /*This variable is used to traversal the array*/
+
+    /*Get the digits from the lowest one*/
+    do
+    {
+        digits[i++] = '0' + (uint8_t)(number % 10u);
+        number /= 10u;
+    } while (0u != number);
+
+    /*Send the digits from the highest one*/
+    while (0u != i)
+    {
+        Driver_UART0_send_data_byte(digits[--i]);
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_send_hex
+* Description: Send a 32-bit number by UART0 as 0x and 8 hexadecimal digits
+*
+END***************************************************************************/
+void Driver_UART0_send_hex(uint32_t number)
+{
+    uint8_t i = 0; /*This variable is used to traversal the digits*/
+
+    Driver_UART0_send_data_byte('0');
+    Driver_UART0_send_data_byte('x');
+
+    /*Send the digits from the highest one*/
+    for (i = 0; i < 8u; i++)
+    {
+        Driver_UART0_send_data_byte((uint8_t)"0123456789ABCDEF"[(number >> (28u - 4u * i)) & 0xFu]);
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_get_error_counters
+* Description: Get the line-quality counters of UART0
+*
+END***************************************************************************/
+void Driver_UART0_get_error_counters(uart0_error_counter_info *counters)
+{
+    /*Check input*/
+    if (NULL != counters)
+    {
+        counters->overrun_count = s_error_counters.overrun_count;
+        counters->noise_count = s_error_counters.noise_count;
+        counters->framing_count = s_error_counters.framing_count;
+        counters->parity_count = s_error_counters.parity_count;
+        counters->step_down_count = s_error_counters.step_down_count;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_reset_error_counters
+* Description: Reset the line-quality counters of UART0
+*
+END***************************************************************************/
+void Driver_UART0_reset_error_counters(void)
+{
+    s_error_counters.overrun_count = 0;
+    s_error_counters.noise_count = 0;
+    s_error_counters.framing_count = 0;
+    s_error_counters.parity_count = 0;
+    s_error_counters.step_down_count = 0;
+    s_window_errors = 0;
+    s_window_bytes = 0;
+    s_step_down_pending = 0;
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_get_baud_rate
+* Description: Get the current baud rate of UART0
+*
+END***************************************************************************/
+uint32_t Driver_UART0_get_baud_rate(void)
+{
+    return s_baud_rate;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_get_supported_baud
+* Description: Get a baud rate of the step-down list
+*
+END***************************************************************************/
+uint32_t Driver_UART0_get_supported_baud(uint8_t index)
+{
+    uint32_t ret_val = 0; /*This variable stores the function return value*/
+
+    /*Check input*/
+    if (index < UART0_STEP_DOWN_BAUD_COUNT)
+    {
+        ret_val = s_step_down_baud[index];
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_set_error_rate
+* Description: Set the line error rate that triggers a baud rate step-down
+*
+END***************************************************************************/
+void Driver_UART0_set_error_rate(uint16_t error_rate)
+{
+    /*Check input*/
+    if (error_rate <= 1000u)
+    {
+        s_error_rate = error_rate;
+        s_window_errors = 0;
+        s_window_bytes = 0;
+        s_step_down_pending = 0;
+    }
+    /*Any invalid input will be ignored*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_get_error_rate
+* Description: Get the line error rate that triggers a baud rate step-down
+*
+END***************************************************************************/
+uint16_t Driver_UART0_get_error_rate(void)
+{
+    return s_error_rate;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_get_step_down_baud
+* Description: Get the baud rate a pending step-down switches to
+*
+END***************************************************************************/
+uint32_t Driver_UART0_get_step_down_baud(void)
+{
+    uint32_t ret_val = 0; /*This variable stores the function return value*/
+
+    if (0u != s_step_down_pending)
+    {
+        ret_val = UART0_get_lower_baud_rate();
+
+        /*Already at the lowest baud rate, there is nothing to step down to*/
+        if (0u == ret_val)
+        {
+            s_step_down_pending = 0;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_step_down
+* Description: Switch UART0 to the baud rate of the pending step-down
+*
+END***************************************************************************/
+void Driver_UART0_step_down(void)
+{
+    uint32_t baud_rate = Driver_UART0_get_step_down_baud(); /*This variable stores the new baud rate*/
+
+    if (0u != baud_rate)
+    {
+        /*The announcement sent at the old baud rate must be out before the switch*/
+        while (0 == HAL_UART0_S1_read_TC())
+        {
+            /*Do nothing*/
+        }
+
+        /*The baud rate divisor must be updated while receiver and transmitter are disabled*/
+        Driver_UART0_select_Rx_state(RECEIVER_DISABLED);
+        Driver_UART0_select_Tx_state(TRANSMITTER_DISABLED);
+        Driver_UART0_update_Baud_div(baud_rate, s_OSR, s_clock_frequency);
+        Driver_UART0_select_Rx_state(RECEIVER_ENABLED);
+        Driver_UART0_select_Tx_state(TRANSMITTER_ENABLED);
+
+        s_baud_rate = baud_rate;
+        s_error_counters.step_down_count++;
+        s_step_down_pending = 0;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_get_rx_statistics
+* Description: Get the receive statistics of UART0
+*
+END***************************************************************************/
+void Driver_UART0_get_rx_statistics(uart0_rx_statistic_info *statistics)
+{
+    /*Check input*/
+    if (NULL != statistics)
+    {
+        statistics->received_bytes = s_rx_statistics.received_bytes;
+        statistics->dropped_bytes = s_rx_statistics.dropped_bytes;
+        statistics->peak_queue_occupancy = s_rx_statistics.peak_queue_occupancy;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_reset_rx_statistics
+* Description: Reset the receive statistics of UART0
+*
+END***************************************************************************/
+void Driver_UART0_reset_rx_statistics(void)
+{
+    s_rx_statistics.received_bytes = 0;
+    s_rx_statistics.dropped_bytes = 0;
+    s_rx_statistics.peak_queue_occupancy = 0;
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: Driver_UART0_enable_address_match
+* Description: Share the line with other nodes using the match address mode
+*
+END***************************************************************************/
+void Driver_UART0_enable_address_match(uint8_t node_address, uint8_t broadcast_address)
+{
+    /*Check input*/
+    if (node_address != broadcast_address)
+    {
+        s_node_address = node_address;
+        s_broadcast_address = broadcast_address;
+        s_tx_muted = 1;
+
+        /*The frame format must be changed while receiver and transmitter are disabled*/
+        Driver_UART0_select_Rx_state(RECEIVER_DISABLED);
+        Driver_UART0_select_Tx_state(TRANSMITTER_DISABLED);
+        Driver_UART0_select_data_length(DATA_9BITS);
+        HAL_UART0_MA_set_addresses(broadcast_address, node_address);
+        HAL_UART0_C4_set_MAEN(1);
+        Driver_UART0_select_Rx_state(RECEIVER_ENABLED);
+        Driver_UART0_select_Tx_state(TRANSMITTER_ENABLED);
+
+        s_address_match = 1;
+    }
+    /*Any invalid input will be ignored*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
 /*Functions*********************************************************************
 *
 * Function name: Driver_UART0_check_first_buffer
@@ -484,8 +1164,20 @@ void Driver_UART0_send_string(uint8_t *str)
 END***************************************************************************/
 uint8_t Driver_UART0_check_first_buffer(void)
 {
-    /*Return a flag that indicate the first element is ready to read*/
-    return queue.queue_state[queue.first];
+    uint8_t ret_val = 0; /*This variable stores the function return value*/
+
+    /*An empty queue has no first element, its index is the empty mark*/
+    if (0u == Queue_IsEmpty(&queue))
+    {
+        /*Return a flag that indicate the first element is ready to read*/
+        ret_val = queue.queue_state[queue.first];
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
 }
 
 /*Functions*********************************************************************
@@ -496,10 +1188,10 @@ uint8_t Driver_UART0_check_first_buffer(void)
 END***************************************************************************/
 void Driver_UART0_receive_string(uint8_t *str)
 {
-    uint8_t i = 0; /*This variable is used to traversal the array*/
+    uint32_t i = 0; /*This variable is used to traversal the array*/
 
-    /*Loop until meet the NULL character*/
-    while ('\0' != queue.record[queue.first][i])
+    /*Loop until meet the NULL character, at most a queue line*/
+    while (('\0' != queue.record[queue.first][i]) && (i < (QUEUE_LINE_SIZE - 1u)))
     {
         /*Copy Rx buffer element to str*/
         str[i] = queue.record[queue.first][i];
@@ -1,6 +1,14 @@
 #include "../Includes/Driver/Driver_core.h"
+#include "../Includes/Event/Event.h"
 #include "MKL46Z4.h"
 
+/*Stack limits defined by the linker file*/
+extern uint32_t __StackLimit;
+extern uint32_t __StackTop;
+
+/*This variable counts the SysTick reloads, it extends the 24-bit counter to 32 bits*/
+static volatile uint32_t s_systick_overflow = 0;
+
 void Driver_Disable_current_IRQs(void)
 {
     __disable_irq();
@@ -15,6 +23,32 @@ void Driver_Enable_current_IRQs(void)
     return;
 }
 
+uint32_t Driver_Save_and_disable_IRQs(void)
+{
+    uint32_t primask = __get_PRIMASK(); /*This variable stores the interrupt state to restore*/
+
+    __disable_irq();
+
+    return primask;
+}
+
+void Driver_Restore_IRQs(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+
+    return;
+}
+
+void Driver_Wait_for_interrupt(void)
+{
+    /*Normal sleep (WAIT mode), not deep sleep: the clocks of SysTick, UART0 and flash stay on*/
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+    __DSB();
+    __WFI();
+
+    return;
+}
+
 void Driver_Set_MSP(uint32_t MSP_value)
 {
     __set_MSP(MSP_value);
@@ -42,4 +76,110 @@ void Driver_Set_VectorTable_offset(uint32_t offset_value)
 
     return;
 }
+
+void SysTick_Handler(void)
+{
+    s_systick_overflow++;
+
+    /*Periodic wake-up of the main loop, every 2^24 core clock cycles*/
+    Event_post(EVENT_TICK);
+
+    return;
+}
+
+void Driver_SysTick_start(void)
+{
+    s_systick_overflow = 0;
+
+    SysTick->LOAD = SYSTICK_RELOAD_VALUE;
+    SysTick->VAL = 0;
+    /*Core clock source, reload interrupt enabled, counter enabled*/
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    return;
+}
+
+uint64_t Driver_SysTick_get_ticks64(void)
+{
+    uint32_t overflow = 0; /*This variable stores the reload count*/
+    uint32_t value = 0;    /*This variable stores the current counter value*/
+    uint32_t pending = 0;  /*This variable stores 1 if a reload has not been counted by the handler*/
+
+    /*Read again if the handler counted a reload meanwhile*/
+    do
+    {
+        overflow = s_systick_overflow;
+        value = SysTick->VAL;
+
+        /*With the interrupts masked a reload waits pending and the counter has started again from
+         *the top: its period is added, the counter is read again as it may have reloaded after the
+         *first read. Only one period can wait, the interrupts must not stay masked for 2^24 cycles*/
+        pending = (0u != (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)) ? 1u : 0u;
+        if (1u == pending)
+        {
+            value = SysTick->VAL;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    } while (overflow != s_systick_overflow);
+
+    return (((uint64_t)overflow + pending) << 24u) + (SYSTICK_RELOAD_VALUE - value);
+}
+
+uint32_t Driver_SysTick_get_ticks(void)
+{
+    return (uint32_t)Driver_SysTick_get_ticks64();
+}
+
+void Driver_SysTick_stop(void)
+{
+    SysTick->CTRL = 0;
+    /*Clear a pending SysTick exception*/
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+
+    return;
+}
+
+void Driver_NVIC_clear_all_IRQs(void)
+{
+    /*Disable all interrupts then clear all pending flags*/
+    NVIC->ICER[0] = 0xFFFFFFFFu;
+    NVIC->ICPR[0] = 0xFFFFFFFFu;
+
+    return;
+}
+
+void Driver_Stack_paint(void)
+{
+    uint32_t *word = &__StackLimit;                          /*This pointer points to the word to paint*/
+    uint32_t *stack_pointer = (uint32_t *)__get_MSP() - 16u; /*Keep a margin below the current frame*/
+
+    while (word < stack_pointer)
+    {
+        *word = STACK_PAINT_PATTERN;
+        word++;
+    }
+
+    return;
+}
+
+uint32_t Driver_Stack_get_used(void)
+{
+    uint32_t *word = &__StackLimit; /*This pointer points to the word to check*/
+
+    /*The deepest use is the first word that is no longer painted*/
+    while ((word < &__StackTop) && (STACK_PAINT_PATTERN == *word))
+    {
+        word++;
+    }
+
+    return (uint32_t)&__StackTop - (uint32_t)word;
+}
+
+uint32_t Driver_Stack_get_size(void)
+{
+    return (uint32_t)&__StackTop - (uint32_t)&__StackLimit;
+}
 /*EOF*/
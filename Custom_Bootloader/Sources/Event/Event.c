@@ -0,0 +1,206 @@
+/**
+ * @file  : Event.c
+ * @author: Nguyen The Anh.
+ * @brief : Definition of function using in file Event.c
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include "../Includes/Event/Event.h"
+#include "../Includes/Driver/Driver_core.h"
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*This variable stores the EVENT_MASK of the pending events, set by the interrupts*/
+static volatile uint32_t s_event_pending = 0;
+
+/*This table stores the handler of each event*/
+static event_handler_t s_event_handler[EVENT_COUNT];
+
+/*This struct stores the sleep statistics*/
+static event_statistic_info s_event_statistics;
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/**
+ * @brief Clear the pending events, the handler table and the statistics
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Event_init(void)
+{
+    uint32_t i = 0; /*i is used for traversaling loop*/
+
+    for (i = 0; i < EVENT_COUNT; i++)
+    {
+        s_event_handler[i] = 0;
+    }
+
+    s_event_statistics.sleep_cycles = 0;
+    s_event_statistics.sleep_count = 0;
+    s_event_statistics.dispatched = 0;
+    s_event_pending = 0;
+
+    return;
+}
+
+/**
+ * @brief Set the handler of an event, 0 to remove it
+ *
+ * @param event: Event to handle
+ * @param handler: Function run by Event_dispatch when the event is pending
+ *
+ * @return: This function return nothing
+ */
+void Event_register(event_id_enum_t event, event_handler_t handler)
+{
+    /*Check input*/
+    if (event < EVENT_COUNT)
+    {
+        s_event_handler[event] = handler;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/**
+ * @brief Mark an event pending, called from the interrupt handlers
+ *
+ * @param event: Event that has happened
+ *
+ * @return: This function return nothing
+ */
+void Event_post(event_id_enum_t event)
+{
+    uint32_t primask = 0; /*This variable stores the interrupt state to restore*/
+
+    /*Check input*/
+    if (event < EVENT_COUNT)
+    {
+        /*The ISRs of different priorities and Event_dispatch modify the same word*/
+        primask = Driver_Save_and_disable_IRQs();
+        s_event_pending |= EVENT_MASK(event);
+        Driver_Restore_IRQs(primask);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/**
+ * @brief Take the pending events and run their handlers, in event order
+ *
+ * @param: This function has no parameter
+ *
+ * @return the EVENT_MASK of the events taken, 0 if none was pending
+ */
+uint32_t Event_dispatch(void)
+{
+    uint32_t primask = 0; /*This variable stores the interrupt state to restore*/
+    uint32_t events = 0;  /*This variable stores the events taken*/
+    uint32_t i = 0;       /*i is used for traversaling loop*/
+
+    /*Take all the pending events at once, an event posted meanwhile is taken by the next dispatch*/
+    primask = Driver_Save_and_disable_IRQs();
+    events = s_event_pending;
+    s_event_pending = 0;
+    Driver_Restore_IRQs(primask);
+
+    for (i = 0; i < EVENT_COUNT; i++)
+    {
+        if ((0u != (events & EVENT_MASK(i))) && (0 != s_event_handler[i]))
+        {
+            s_event_handler[i]();
+            s_event_statistics.dispatched++;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+
+    return events;
+}
+
+/**
+ * @brief Sleep until an event is pending, return at once if one already is
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Event_wait(void)
+{
+    uint32_t primask = 0;                                /*This variable stores the interrupt state to restore*/
+    uint64_t sleep_start = Driver_SysTick_get_ticks64(); /*Read with the interrupts on, a reload is counted*/
+    uint8_t slept = 0;                                   /*This flag indicates if the core went to sleep*/
+
+    /*The check and the sleep run with the interrupts disabled, else an event posted between them
+     *would only be seen after the next interrupt. The pending interrupt still ends the WFI*/
+    primask = Driver_Save_and_disable_IRQs();
+    if (0u == s_event_pending)
+    {
+        Driver_Wait_for_interrupt();
+        slept = 1;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+    Driver_Restore_IRQs(primask);
+
+    /*The end is read once the waking ISR has run, as the start*/
+    if (1u == slept)
+    {
+        s_event_statistics.sleep_cycles += Driver_SysTick_get_ticks64() - sleep_start;
+        s_event_statistics.sleep_count++;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/**
+ * @brief Get the sleep statistics
+ *
+ * @param statistics: Struct to fill
+ *
+ * @return: This function return nothing
+ */
+void Event_get_statistics(event_statistic_info *statistics)
+{
+    /*Check input*/
+    if (0 != statistics)
+    {
+        *statistics = s_event_statistics;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+/*EOF*/
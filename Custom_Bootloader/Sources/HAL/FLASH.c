@@ -4,120 +4,389 @@
 #include <stdint.h>
 #include "MKL46Z4.h"
 #include "../Includes/HAL/FLASH.h"
+#include "Flash_layout.h"
+#include "../Includes/Event/Event.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/* Error flags of a finished command: access error, protection violation, verify fail */
+#define FLASH_FSTAT_ERROR_MASK  (FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK | FTFA_FSTAT_MGSTAT0_MASK)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/* FCCOB4 - FCCOBB registers in command parameter order */
+static __IO uint8_t *const s_fccob_data[FLASH_COMMAND_DATA_SIZE] =
+{
+    &FTFA->FCCOB4, &FTFA->FCCOB5, &FTFA->FCCOB6, &FTFA->FCCOB7,
+    &FTFA->FCCOB8, &FTFA->FCCOB9, &FTFA->FCCOBA, &FTFA->FCCOBB
+};
+
+/* 1 while a command launched by Flash_Start_Command has not been collected */
+static uint8_t s_background_command = 0;
+
+/* Block of the command running in background */
+static uint8_t s_background_block = 0;
+
+/* 0 once a background command failed */
+static uint8_t s_background_result = 1;
+
+/* Background erase: start of the running erase, next address to launch and end of the range */
+static uint32_t s_background_erase_last = 0;
+static uint32_t s_background_erase_next = 0;
+static uint32_t s_background_erase_end = 0;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/* Launch the loaded command and wait for it from RAM: no fetch from the block under command */
+static void Flash_Execute_from_RAM(void) __attribute__((section(".ramfunc"), long_call, noinline));
 
 /*******************************************************************************
  * Codes
  ******************************************************************************/
 
+/* Launch the loaded command and wait until it finishes, runs from RAM */
+static void Flash_Execute_from_RAM(void)
+{
+    /* Clear CCIF to launch the command */
+    FTFA->FSTAT = FTFA_FSTAT_CCIF_MASK;
+    /* wait cmd finish */
+    while ((FTFA->FSTAT & FTFA_FSTAT_CCIF_MASK) == 0x00);
+}
+
+/* Wait the running command and collect its result */
+static uint8_t Flash_Complete_Command(void)
+{
+    uint8_t ret_val = 0;
+
+    /* wait previous cmd finish */
+    while ((FTFA->FSTAT & FTFA_FSTAT_CCIF_MASK) == 0x00);
+
+    ret_val = ((FTFA->FSTAT & FLASH_FSTAT_ERROR_MASK) == 0x00) ? 1 : 0;
+
+    /* keep the result of a background command before the next launch clears it */
+    if(s_background_command != 0)
+    {
+        s_background_result &= ret_val;
+        s_background_command = 0;
+        FTFA->FCNFG &= ~FTFA_FCNFG_CCIE_MASK;
+    }
+
+    return ret_val;
+}
+
+/* Load a command in the FCCOB registers once the previous one is finished */
+static void Flash_Load_Command(flash_command_info *Command)
+{
+    uint8_t i;
+
+    Flash_Complete_Command();
+
+    /* clear previous cmd error */
+    FTFA->FSTAT = FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK;
+
+    /* fill command */
+    FTFA->FCCOB0 = Command->Cmd;
+
+    /* fill Address */
+    FTFA->FCCOB1 = (uint8_t)(Command->Addr >> 16);
+    FTFA->FCCOB2 = (uint8_t)(Command->Addr >> 8);
+    FTFA->FCCOB3 = (uint8_t)(Command->Addr >> 0);
+
+    /* fill parameters */
+    for(i = 0; i < Command->DataCount; i++)
+    {
+        *s_fccob_data[i] = Command->Data[i];
+    }
+}
+
+/* Command complete of a background command: wake the main loop to collect it */
+void FTFA_IRQHandler(void)
+{
+    /* CCIF stays set until the next launch, the interrupt is enabled again by then */
+    FTFA->FCNFG &= ~FTFA_FCNFG_CCIE_MASK;
+    Event_post(EVENT_FLASH_DONE);
+}
+
+/* Get the program flash block of an address */
+uint8_t Flash_Get_Block(uint32_t Addr)
+{
+    return (uint8_t)((Addr - FLASH_BASE_ADDRESS) / FLASH_BLOCK_SIZE);
+}
+
+/* Launch a flash command and wait until it finishes */
+uint8_t Flash_Launch_Command(flash_command_info *Command)
+{
+    uint32_t primask;
+    uint8_t ret_val = 0;
+
+    if((Command != 0) && (Command->DataCount <= FLASH_COMMAND_DATA_SIZE))
+    {
+        Flash_Load_Command(Command);
+
+        if(Flash_Get_Block(Command->Addr) == FLASH_BOOT_BLOCK)
+        {
+            /* the code and ISRs run from this block: mask the interrupts during the command */
+            primask = __get_PRIMASK();
+            __disable_irq();
+            Flash_Execute_from_RAM();
+            __set_PRIMASK(primask);
+        }
+        else
+        {
+            /* read while write: the bootloader and its ISRs keep running */
+            Flash_Execute_from_RAM();
+        }
+
+        ret_val = Flash_Complete_Command();
+    }
+
+    return ret_val;
+}
+
+/* Launch a flash command, without waiting when it targets the other block */
+uint8_t Flash_Start_Command(flash_command_info *Command)
+{
+    uint8_t ret_val = 0;
+
+    if((Command != 0) && (Command->DataCount <= FLASH_COMMAND_DATA_SIZE))
+    {
+        if(Flash_Get_Block(Command->Addr) == FLASH_BOOT_BLOCK)
+        {
+            ret_val = Flash_Launch_Command(Command);
+        }
+        else
+        {
+            Flash_Load_Command(Command);
+
+            /* Clear CCIF to launch the command */
+            FTFA->FSTAT = FTFA_FSTAT_CCIF_MASK;
+            s_background_block = Flash_Get_Block(Command->Addr);
+            s_background_command = 1;
+
+            /* post EVENT_FLASH_DONE when it finishes */
+            FTFA->FCNFG |= FTFA_FCNFG_CCIE_MASK;
+            NVIC_EnableIRQ(FTFA_IRQn);
+
+            ret_val = 1;
+        }
+    }
+
+    return ret_val;
+}
+
 /* Read a byte in flash*/
 uint8_t Read_Flash_byte(uint32_t Addr)
 {
+    /* a block can not be read while a command runs on it */
+    if((s_background_command != 0) && (Flash_Get_Block(Addr) == s_background_block))
+    {
+        Flash_Complete_Command();
+    }
+
     return *(__IO uint8_t*)Addr;
 }
 
 /* Get address*/
 uint32_t Read_FlashAddress(uint32_t Addr)
 {
+    /* a block can not be read while a command runs on it */
+    if((s_background_command != 0) && (Flash_Get_Block(Addr) == s_background_block))
+    {
+        Flash_Complete_Command();
+    }
+
     return *(__IO uint32_t*)Addr;
 }
 
 /* Program Address and Data (8bit pointer) into Flash Memory */
 uint8_t Program_LongWord_8B(uint32_t Addr,uint8_t *Data)
 {
-    /* wait previous cmd finish */
-    while (FTFA->FSTAT == 0x00);
-
-    /* clear previous cmd error */
-    if(FTFA->FSTAT != 0x80)
+    /* Program 4 bytes in a program flash block, FCCOB4 is the most significant byte */
+    flash_command_info command =
     {
-        FTFA->FSTAT = 0x30;
-    }
-    /* Program 4 bytes in a program flash block */
-    FTFA->FCCOB0 = CMD_PROGRAM_LONGWORD;
+        .Cmd = CMD_PROGRAM_LONGWORD,
+        .Addr = Addr,
+        .Data = {Data[3], Data[2], Data[1], Data[0]},
+        .DataCount = 4,
+    };
 
-    /* fill Address */
-    FTFA->FCCOB1 = (uint8_t)(Addr >> 16);
-    FTFA->FCCOB2 = (uint8_t)(Addr >> 8);
-    FTFA->FCCOB3 = (uint8_t)(Addr >> 0);
-
-    /* fill Data */
-    FTFA->FCCOB4 = (uint8_t)(Data[3]);
-    FTFA->FCCOB5 = (uint8_t)(Data[2]);
-    FTFA->FCCOB6 = (uint8_t)(Data[1]);
-    FTFA->FCCOB7 = (uint8_t)(Data[0]);
-
-    /* Clear CCIF */
-    FTFA->FSTAT = 0x80;
-    /* wait cmd finish */
-    while (FTFA->FSTAT == 0x00);
-    return 1;
+    return Flash_Launch_Command(&command);
 }
 
 /* Program Address and Data (32bit) into Flash Memory */
 uint8_t Program_LongWord(uint32_t Addr, uint32_t Data)
 {
-    /* wait previous cmd finish */
-    while (FTFA->FSTAT == 0x00);
+    /* Program 4 bytes in a program flash block */
+    flash_command_info command =
+    {
+        .Cmd = CMD_PROGRAM_LONGWORD,
+        .Addr = Addr,
+        .Data = {(uint8_t)(Data >> 24), (uint8_t)(Data >> 16), (uint8_t)(Data >> 8), (uint8_t)(Data >> 0)},
+        .DataCount = 4,
+    };
 
-    /* clear previous cmd error */
-    if(FTFA->FSTAT != 0x80)
+    return Flash_Launch_Command(&command);
+}
+
+/* Check a programmed longword at a margin read level */
+uint8_t Program_Check_LongWord(uint32_t Addr, uint32_t Data, uint8_t Margin)
+{
+    /* FCCOB4 is the margin choice, FCCOB8 the most significant byte of the expected data */
+    flash_command_info command =
     {
-        FTFA->FSTAT = 0x30;
-    }
-    /* Program 4 bytes in a program flash block */
-    FTFA->FCCOB0 = CMD_PROGRAM_LONGWORD;
+        .Cmd = CMD_PROGRAM_CHECK,
+        .Addr = Addr,
+        .Data = {Margin, 0, 0, 0, (uint8_t)(Data >> 24), (uint8_t)(Data >> 16), (uint8_t)(Data >> 8), (uint8_t)(Data >> 0)},
+        .DataCount = 8,
+    };
 
-    /* fill Address */
-    FTFA->FCCOB1 = (uint8_t)(Addr >> 16);
-    FTFA->FCCOB2 = (uint8_t)(Addr >> 8);
-    FTFA->FCCOB3 = (uint8_t)(Addr >> 0);
-
-    /* fill Data */
-    FTFA->FCCOB4 = (uint8_t)(Data >> 24);
-    FTFA->FCCOB5 = (uint8_t)(Data >> 16);
-    FTFA->FCCOB6 = (uint8_t)(Data >> 8);
-    FTFA->FCCOB7 = (uint8_t)(Data >> 0);
-
-    /* Clear CCIF */
-    FTFA->FSTAT = 0x80;
-    /* wait cmd finish */
-    while (FTFA->FSTAT == 0x00);
-    return 1;
+    return Flash_Launch_Command(&command);
 }
 
 /* Erase a flash Sector */
 uint8_t  Erase_Sector(uint32_t Addr)
 {
-    /* wait previous cmd finish */
-    while (FTFA->FSTAT == 0x00);
+    /* Erase all bytes in a program flash sector */
+    flash_command_info command =
+    {
+        .Cmd = CMD_ERASE_FLASH_SECTOR,
+        .Addr = Addr,
+        .DataCount = 0,
+    };
 
-    /* clear previous cmd error */
-    if(FTFA->FSTAT != 0x80)
+    return Flash_Launch_Command(&command);
+}
+
+/* Erase a flash block */
+uint8_t  Erase_Block(uint32_t Addr)
+{
+    /* Erase all bytes in a program flash block */
+    flash_command_info command =
+    {
+        .Cmd = CMD_ERASE_FLASH_BLOCK,
+        .Addr = Addr,
+        .DataCount = 0,
+    };
+    uint8_t ret_val = 0;
+
+    /* the bootloader executes from the boot block */
+    if(Flash_Get_Block(Addr) != FLASH_BOOT_BLOCK)
     {
-        FTFA->FSTAT = 0x30;
+        ret_val = Flash_Launch_Command(&command);
     }
-    /* Erase all bytes in a program flash sector */
-    FTFA->FCCOB0 = CMD_ERASE_FLASH_SECTOR;
 
-    /* fill Address */
-    FTFA->FCCOB1 = (uint8_t)(Addr >> 16);
-    FTFA->FCCOB2 = (uint8_t)(Addr >> 8);
-    FTFA->FCCOB3 = (uint8_t)(Addr >> 0);
+    return ret_val;
+}
 
-    /* Clear CCIF */
-    FTFA->FSTAT = 0x80;
-    /* wait cmd finish */
-    while (FTFA->FSTAT == 0x00);
-    return 1;
+/* Check if a whole block outside the boot block starts at Addr and lies before End */
+static uint8_t Flash_Is_Whole_Block(uint32_t Addr, uint32_t End)
+{
+    return (((Addr - FLASH_BASE_ADDRESS) % FLASH_BLOCK_SIZE == 0) &&
+            ((End - Addr) >= FLASH_BLOCK_SIZE) &&
+            (Flash_Get_Block(Addr) != FLASH_BOOT_BLOCK)) ? 1 : 0;
 }
 
 /* Erase all flash sector */
-uint8_t  Erase_Multi_Sector(uint32_t Addr,uint8_t Size)
+uint8_t  Erase_Multi_Sector(uint32_t Addr,uint32_t Size)
 {
-    uint8_t i;
-    for(i = 0; i < Size; i++)
+    uint32_t End = Addr + Size*FLASH_SECTOR_SIZE;
+    uint8_t ret_val = 1;
+
+    while(Addr < End)
     {
-        Erase_Sector(Addr + i*1024);
+        if(Flash_Is_Whole_Block(Addr, End) != 0)
+        {
+            ret_val &= Erase_Block(Addr);
+            Addr += FLASH_BLOCK_SIZE;
+        }
+        else
+        {
+            ret_val &= Erase_Sector(Addr);
+            Addr += FLASH_SECTOR_SIZE;
+        }
     }
-    return 1;
+    return ret_val;
+}
+
+/* Erase multi sectors, in background outside the boot block */
+uint8_t Erase_Multi_Sector_Background(uint32_t Addr, uint32_t Size)
+{
+    uint32_t i;
+    uint8_t ret_val = 1;
+
+    /* a new range starts after the previous one */
+    Flash_Background_Erase_wait(FLASH_DELETED_VALUE);
+    s_background_result = 1;
+
+    /* the boot block sectors can only be erased with the bootloader stalled */
+    for(i = 0; (i < Size) && (Flash_Get_Block(Addr + i*FLASH_SECTOR_SIZE) == FLASH_BOOT_BLOCK); i++)
+    {
+        ret_val &= Erase_Sector(Addr + i*FLASH_SECTOR_SIZE);
+    }
+
+    s_background_erase_next = Addr + i*FLASH_SECTOR_SIZE;
+    s_background_erase_end = Addr + Size*FLASH_SECTOR_SIZE;
+    Flash_Background_Erase_poll();
+
+    return ret_val;
+}
+
+/* Collect the finished background erase and launch the next sector or block */
+uint32_t Flash_Background_Erase_poll(void)
+{
+    flash_command_info command =
+    {
+        .Cmd = CMD_ERASE_FLASH_SECTOR,
+        .DataCount = 0,
+    };
+
+    if((FTFA->FSTAT & FTFA_FSTAT_CCIF_MASK) != 0x00)
+    {
+        if(s_background_command != 0)
+        {
+            Flash_Complete_Command();
+        }
+
+        if(s_background_erase_next < s_background_erase_end)
+        {
+            command.Addr = s_background_erase_next;
+            s_background_erase_last = s_background_erase_next;
+
+            if(Flash_Is_Whole_Block(s_background_erase_next, s_background_erase_end) != 0)
+            {
+                command.Cmd = CMD_ERASE_FLASH_BLOCK;
+                s_background_erase_next += FLASH_BLOCK_SIZE;
+            }
+            else
+            {
+                s_background_erase_next += FLASH_SECTOR_SIZE;
+            }
+
+            s_background_result &= Flash_Start_Command(&command);
+        }
+    }
+
+    return ((s_background_erase_end - s_background_erase_next) / FLASH_SECTOR_SIZE) + s_background_command;
+}
+
+/* Finish the background erase up to the sector of an address */
+uint8_t Flash_Background_Erase_wait(uint32_t Addr)
+{
+    /* launch the erases up to the one holding Addr */
+    while((s_background_erase_next < s_background_erase_end) && (s_background_erase_next <= Addr))
+    {
+        Flash_Complete_Command();
+        Flash_Background_Erase_poll();
+    }
+
+    /* the running erase may hold Addr */
+    if((s_background_command != 0) && (Addr >= s_background_erase_last))
+    {
+        Flash_Complete_Command();
+    }
+
+    return s_background_result;
 }
@@ -22,6 +22,155 @@
  * Functions
  ******************************************************************************/
 
+/* ----------------------------------------------------------------------------
+   -- MCG_C1 register bit setting functions group
+   ---------------------------------------------------------------------------- */
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_C1_set_CLKS
+* Description: Select the MCGOUTCLK source (FLL/PLL, internal or external reference)
+*
+END***************************************************************************/
+void HAL_MCG_C1_set_CLKS(uint8_t CLKS_value)
+{
+    /*Check input*/
+    if (CLKS_value <= 2u)
+    {
+        /*Clear the CLKS bit field*/
+        MCG->C1 &= ~(MCG_C1_CLKS_MASK);
+        /*Write CLKS value to the CLKS bit field*/
+        MCG->C1 |= MCG_C1_CLKS(CLKS_value);
+    }
+    /*Any invalid write will be ignored, the bit field will hold its previous value*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_C1_set_FRDIV
+* Description: Select the FLL external reference divider
+*
+END***************************************************************************/
+void HAL_MCG_C1_set_FRDIV(uint8_t FRDIV_value)
+{
+    /*Check input*/
+    if (FRDIV_value <= 7u)
+    {
+        /*Clear the FRDIV bit field*/
+        MCG->C1 &= ~(MCG_C1_FRDIV_MASK);
+        /*Write FRDIV value to the FRDIV bit field*/
+        MCG->C1 |= MCG_C1_FRDIV(FRDIV_value);
+    }
+    /*Any invalid write will be ignored, the bit field will hold its previous value*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_C1_set_IREFS
+* Description: Select the internal or external reference clock for the FLL
+*
+END***************************************************************************/
+void HAL_MCG_C1_set_IREFS(uint8_t IREFS_value)
+{
+    /*If the slow internal reference clock is selected*/
+    if (1 == IREFS_value)
+    {
+        /*Write 1 to IREFS bit field*/
+        MCG->C1 |= MCG_C1_IREFS_MASK;
+    }
+    /*If the external reference clock is selected*/
+    else if (0 == IREFS_value)
+    {
+        /*Write 0 to IREFS bit field*/
+        MCG->C1 &= ~(MCG_C1_IREFS_MASK);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*!
+ * @}
+ */
+/* end of group MCG_C1 register bit setting functions */
+
+/* ----------------------------------------------------------------------------
+   -- MCG_C2 register bit setting functions group
+   ---------------------------------------------------------------------------- */
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_C2_set_RANGE0
+* Description: Select the frequency range of the crystal oscillator
+*
+END***************************************************************************/
+void HAL_MCG_C2_set_RANGE0(uint8_t RANGE0_value)
+{
+    /*Check input*/
+    if (RANGE0_value <= 2u)
+    {
+        /*Clear the RANGE0 bit field*/
+        MCG->C2 &= ~(MCG_C2_RANGE0_MASK);
+        /*Write RANGE0 value to the RANGE0 bit field*/
+        MCG->C2 |= MCG_C2_RANGE0(RANGE0_value);
+    }
+    /*Any invalid write will be ignored, the bit field will hold its previous value*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_C2_set_EREFS0
+* Description: Select external clock or crystal oscillator as external reference
+*
+END***************************************************************************/
+void HAL_MCG_C2_set_EREFS0(uint8_t EREFS0_value)
+{
+    /*If the crystal oscillator is requested*/
+    if (1 == EREFS0_value)
+    {
+        /*Write 1 to EREFS0 bit field*/
+        MCG->C2 |= MCG_C2_EREFS0_MASK;
+    }
+    /*If an external clock is requested*/
+    else if (0 == EREFS0_value)
+    {
+        /*Write 0 to EREFS0 bit field*/
+        MCG->C2 &= ~(MCG_C2_EREFS0_MASK);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*!
+ * @}
+ */
+/* end of group MCG_C2 register bit setting functions */
+
 /* ----------------------------------------------------------------------------
    -- MCG_C4 register bit setting functions group
    ---------------------------------------------------------------------------- */
@@ -141,6 +290,31 @@ void HAL_MCG_C5_set_PLLCLKEN0(uint8_t PLLCLKEN0_value)
     return;
 }
 
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_C5_set_PRDIV0
+* Description: Set the PLL external reference divider (divide factor - 1)
+*
+END***************************************************************************/
+void HAL_MCG_C5_set_PRDIV0(uint8_t PRDIV0_value)
+{
+    /*Check input*/
+    if (PRDIV0_value <= 24u)
+    {
+        /*Clear the PRDIV0 bit field*/
+        MCG->C5 &= ~(MCG_C5_PRDIV0_MASK);
+        /*Write PRDIV0 value to the PRDIV0 bit field*/
+        MCG->C5 |= MCG_C5_PRDIV0(PRDIV0_value);
+    }
+    /*Any invalid write will be ignored, the bit field will hold its previous value*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
 /*!
  * @}
  */
@@ -178,9 +352,103 @@ void HAL_MCG_C6_set_PLLS(uint8_t PLLS_value)
     return;
 }
 
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_C6_set_VDIV0
+* Description: Set the VCO multiplier of the PLL (multiply factor - 24)
+*
+END***************************************************************************/
+void HAL_MCG_C6_set_VDIV0(uint8_t VDIV0_value)
+{
+    /*Check input*/
+    if (VDIV0_value <= 31u)
+    {
+        /*Clear the VDIV0 bit field*/
+        MCG->C6 &= ~(MCG_C6_VDIV0_MASK);
+        /*Write VDIV0 value to the VDIV0 bit field*/
+        MCG->C6 |= MCG_C6_VDIV0(VDIV0_value);
+    }
+    /*Any invalid write will be ignored, the bit field will hold its previous value*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
 /*!
  * @}
  */
 /* end of group MCG_C5 register bit setting functions */
 
+/* ----------------------------------------------------------------------------
+   -- MCG_S register bit reading functions group
+   ---------------------------------------------------------------------------- */
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_S_read_CLKST
+* Description: Read the current MCGOUTCLK source
+*
+END***************************************************************************/
+uint8_t HAL_MCG_S_read_CLKST(void)
+{
+    /*Get the value of CLKST bit field*/
+    return (MCG->S & MCG_S_CLKST_MASK) >> MCG_S_CLKST_SHIFT;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_S_read_IREFST
+* Description: Read the current FLL reference clock source
+*
+END***************************************************************************/
+uint8_t HAL_MCG_S_read_IREFST(void)
+{
+    /*Get the state of IREFST bit field*/
+    return (MCG->S & MCG_S_IREFST_MASK) ? 1u : 0u;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_S_read_OSCINIT0
+* Description: Read whether the crystal oscillator is initialized
+*
+END***************************************************************************/
+uint8_t HAL_MCG_S_read_OSCINIT0(void)
+{
+    /*Get the state of OSCINIT0 bit field*/
+    return (MCG->S & MCG_S_OSCINIT0_MASK) ? 1u : 0u;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_S_read_PLLST
+* Description: Read whether the PLLS clock is the PLL output
+*
+END***************************************************************************/
+uint8_t HAL_MCG_S_read_PLLST(void)
+{
+    /*Get the state of PLLST bit field*/
+    return (MCG->S & MCG_S_PLLST_MASK) ? 1u : 0u;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_MCG_S_read_LOCK0
+* Description: Read whether the PLL has locked
+*
+END***************************************************************************/
+uint8_t HAL_MCG_S_read_LOCK0(void)
+{
+    /*Get the state of LOCK0 bit field*/
+    return (MCG->S & MCG_S_LOCK0_MASK) ? 1u : 0u;
+}
+
+/*!
+ * @}
+ */
+/* end of group MCG_S register bit reading functions */
+
 /*EOF*/
@@ -113,7 +113,7 @@ void HAL_SIM_SCGC4_set_clock_UART0(uint8_t UART0_gate_value)
     else if (0 == UART0_gate_value)
     {
         /*Write 0 to UART0 bit field*/
-        SIM->SCGC4 &= ~(1u << UART0_gate_value);
+        SIM->SCGC4 &= ~SIM_SCGC4_UART0_MASK;
     }
     else
     {
@@ -150,7 +150,7 @@ void HAL_SIM_SCGC5_set_clock_PORTA(uint8_t portA_gate_value)
     else if (0 == portA_gate_value)
     {
         /*Write 0 to the bit field PORTA to disable clock source*/
-        SIM->SCGC5 &= ~(1u << portA_gate_value);
+        SIM->SCGC5 &= ~SIM_SCGC5_PORTA_MASK;
     }
     else
     {
@@ -178,7 +178,7 @@ void HAL_SIM_SCGC5_set_clock_PORTB(uint8_t portB_gate_value)
     else if (0 == portB_gate_value)
     {
         /*Write 0 to the bit field PORTB to disable clock source*/
-        SIM->SCGC5 &= ~(1u << portB_gate_value);
+        SIM->SCGC5 &= ~SIM_SCGC5_PORTB_MASK;
     }
     else
     {
@@ -206,7 +206,7 @@ void HAL_SIM_SCGC5_set_clock_PORTC(uint8_t portC_gate_value)
     else if (0 == portC_gate_value)
     {
         /*Write 0 to the bit field PORTC to disable clock source*/
-        SIM->SCGC5 &= ~(1u << portC_gate_value);
+        SIM->SCGC5 &= ~SIM_SCGC5_PORTC_MASK;
     }
     else
     {
@@ -234,7 +234,7 @@ void HAL_SIM_SCGC5_set_clock_PORTD(uint8_t portD_gate_value)
     else if (0 == portD_gate_value)
     {
         /*Write 0 to the bit field PORTD to disable clock source*/
-        SIM->SCGC5 &= ~(1u << portD_gate_value);
+        SIM->SCGC5 &= ~SIM_SCGC5_PORTD_MASK;
     }
     else
     {
@@ -262,7 +262,7 @@ void HAL_SIM_SCGC5_set_clock_PORTE(uint8_t portE_gate_value)
     else if (0 == portE_gate_value)
     {
         /*Write 0 to the bit field PORTE to disable clock source*/
-        SIM->SCGC5 &= ~(1u << portE_gate_value);
+        SIM->SCGC5 &= ~SIM_SCGC5_PORTE_MASK;
     }
     else
     {
@@ -276,4 +276,36 @@ void HAL_SIM_SCGC5_set_clock_PORTE(uint8_t portE_gate_value)
  * @}
  */
 /* end of group SCGC5 register bit setting function */
+
+/* ----------------------------------------------------------------------------
+   -- CLKDIV1 register bit setting function group
+   ---------------------------------------------------------------------------- */
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_SIM_CLKDIV1_set_OUTDIV
+* Description: Set the core/platform (OUTDIV1) and bus/flash (OUTDIV4) dividers
+*
+END***************************************************************************/
+void HAL_SIM_CLKDIV1_set_OUTDIV(uint8_t OUTDIV1_value, uint8_t OUTDIV4_value)
+{
+    /*Check input. OUTDIV1 has 4 bits width and OUTDIV4 has 3 bits width*/
+    if ((OUTDIV1_value <= 15u) && (OUTDIV4_value <= 7u))
+    {
+        /*Both dividers are written at once so the bus clock never exceeds its maximum*/
+        SIM->CLKDIV1 = SIM_CLKDIV1_OUTDIV1(OUTDIV1_value) | SIM_CLKDIV1_OUTDIV4(OUTDIV4_value);
+    }
+    /*Any invalid write will be ignore, the bit field will hold its previous value*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*!
+ * @}
+ */
+/* end of group CLKDIV1 register bit setting function */
 /*EOF*/
@@ -335,6 +335,55 @@ void HAL_UART0_C2_set_RE(uint8_t RE_value)
  */
 /* end of group UART0_C2 register bit setting functions */
 
+/* ----------------------------------------------------------------------------
+   -- UART0_C3 register bit setting functions group
+   ---------------------------------------------------------------------------- */
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_UART0_C3_set_error_IRQ
+* Description: Set overrun, noise, framing and parity error interrupt state
+*
+END***************************************************************************/
+void HAL_UART0_C3_set_error_IRQ(uint8_t error_IRQ_value)
+{
+    /*If error interrupts are enabled*/
+    if (1 == error_IRQ_value)
+    {
+        /*Write 1 to ORIE, NEIE, FEIE and PEIE bit fields*/
+        UART0->C3 |= (UART0_C3_ORIE_MASK | UART0_C3_NEIE_MASK | UART0_C3_FEIE_MASK | UART0_C3_PEIE_MASK);
+    }
+    /*If error interrupts are disabled*/
+    else if (0 == error_IRQ_value)
+    {
+        /*Write 0 to ORIE, NEIE, FEIE and PEIE bit fields*/
+        UART0->C3 &= ~(UART0_C3_ORIE_MASK | UART0_C3_NEIE_MASK | UART0_C3_FEIE_MASK | UART0_C3_PEIE_MASK);
+    }
+    /*Any invalid input will be ignored*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_UART0_C3_read_R8
+* Description: Read the ninth bit of the received character
+*
+END***************************************************************************/
+uint8_t HAL_UART0_C3_read_R8(void)
+{
+    return (UART0->C3 & UART0_C3_R8T9_MASK) >> UART0_C3_R8T9_SHIFT;
+}
+
+/*!
+ * @}
+ */
+/* end of group UART0_C3 register bit setting functions */
+
 /* ----------------------------------------------------------------------------
    -- UART0_C4 register bit setting functions group
    ---------------------------------------------------------------------------- */
@@ -366,11 +415,64 @@ void HAL_UART0_C4_set_OSR(uint8_t OSR_value)
     return;
 }
 
+/*Functions*********************************************************************
+*
+* Function name: HAL_UART0_C4_set_MAEN
+* Description: Set match address mode state for MA1 and MA2
+*
+END***************************************************************************/
+void HAL_UART0_C4_set_MAEN(uint8_t MAEN_value)
+{
+    /*If match address mode is enabled*/
+    if (1 == MAEN_value)
+    {
+        /*Write 1 to MAEN1 and MAEN2 bit fields*/
+        UART0->C4 |= (UART0_C4_MAEN1_MASK | UART0_C4_MAEN2_MASK);
+    }
+    /*If match address mode is disabled*/
+    else if (0 == MAEN_value)
+    {
+        /*Write 0 to MAEN1 and MAEN2 bit fields*/
+        UART0->C4 &= ~(UART0_C4_MAEN1_MASK | UART0_C4_MAEN2_MASK);
+    }
+    /*Any invalid input will be ignored*/
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
 /*!
  * @}
  */
 /* end of group UART0_C4 register bit setting functions */
 
+/* ----------------------------------------------------------------------------
+   -- UART0_MA1 and UART0_MA2 register bit setting functions group
+   ---------------------------------------------------------------------------- */
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_UART0_MA_set_addresses
+* Description: Set the match addresses for UART0
+*
+END***************************************************************************/
+void HAL_UART0_MA_set_addresses(uint8_t MA1_value, uint8_t MA2_value)
+{
+    /*Write the addresses to MA1 and MA2 registers*/
+    UART0->MA1 = UART0_MA1_MA(MA1_value);
+    UART0->MA2 = UART0_MA2_MA(MA2_value);
+
+    return;
+}
+
+/*!
+ * @}
+ */
+/* end of group UART0_MA1 and UART0_MA2 register bit setting functions */
+
 /* ----------------------------------------------------------------------------
    -- UART0_S1 register bit setting functions group
    ---------------------------------------------------------------------------- */
@@ -399,6 +501,44 @@ uint8_t HAL_UART0_S1_read_RDRF(void)
     return UART0->S1 & UART0_S1_RDRF_MASK;
 }
 
+/*Functions*********************************************************************
+*
+* Function name: HAL_UART0_S1_read_TC
+* Description: Read the transmission complete flag(Transmitter is idle)
+*
+END***************************************************************************/
+uint8_t HAL_UART0_S1_read_TC(void)
+{
+    /*Get the state of TC bit field*/
+    return UART0->S1 & UART0_S1_TC_MASK;
+}
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_UART0_S1_read_error_flags
+* Description: Read the overrun, noise, framing and parity error flags
+*
+END***************************************************************************/
+uint8_t HAL_UART0_S1_read_error_flags(void)
+{
+    /*Get the state of OR, NF, FE and PF bit fields*/
+    return UART0->S1 & (UART0_S1_OR_MASK | UART0_S1_NF_MASK | UART0_S1_FE_MASK | UART0_S1_PF_MASK);
+}
+
+/*Functions*********************************************************************
+*
+* Function name: HAL_UART0_S1_clear_error_flags
+* Description: Clear the selected error flags (write 1 to clear)
+*
+END***************************************************************************/
+void HAL_UART0_S1_clear_error_flags(uint8_t error_flags)
+{
+    /*Write 1 to the selected flags only, other bit fields are not affected by writing 0*/
+    UART0->S1 = error_flags & (UART0_S1_OR_MASK | UART0_S1_NF_MASK | UART0_S1_FE_MASK | UART0_S1_PF_MASK);
+
+    return;
+}
+
 /*!
  * @}
  */
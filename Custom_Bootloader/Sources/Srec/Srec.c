@@ -51,6 +51,27 @@ static uint32_t get_string_length(uint8_t *str);
  */
 static uint64_t convert_hex_string_to_decimal(uint8_t *hex_str, uint32_t hex_digit_count);
 
+/**
+ * @brief Sum the bytes of a hex string, the checksum covers each byte of a field
+ *
+ * @param hex_str: Hex string
+ * @param byte_count: Number of bytes (2 hex digits each)
+ *
+ * @return Sum of the bytes
+ */
+static uint32_t get_hex_bytes_sum(uint8_t *hex_str, uint32_t byte_count);
+
+/**
+ * @brief Check that a line holds all its fields: hex digits, the length given by its byte count,
+ *        the address of its type and the checksum. Only S0 to S3 carry data, S4 is reserved
+ *
+ * @param line: Srec record
+ * @param line_length: Length of the line
+ *
+ * @return 1 if the fields can be read, 0 if not
+ */
+static uint8_t is_line_well_formed(uint8_t *line, uint32_t line_length);
+
 /*******************************************************************************
  * Functions
  ******************************************************************************/
@@ -117,19 +138,126 @@ static uint64_t convert_hex_string_to_decimal(uint8_t *hex_str, uint32_t hex_dig
 {
     uint32_t i = 0;            /*i is used for traversaling the loop*/
     uint8_t decimal_value = 0; /*This variable stores decimal value of a hex digit*/
-    uint32_t hex_length = 0;   /*This variable stores the length of hex string*/
     uint64_t ret_val = 0;      /*This variable stores function return value*/
 
-    /*Get length of hex string*/
-    hex_length = get_string_length(hex_str);
-
     /*Traversal the hex string*/
     for (i = 0; i < hex_digit_count; i++)
     {
         /*Get deciaml value of each hex digit*/
         decimal_value = convert_hex_to_decimal(hex_str[i]);
         /*Calculate the decimal value*/
-        ret_val += decimal_value << (4 * (hex_digit_count - 1 - i));
+        ret_val += (uint64_t)decimal_value << (4 * (hex_digit_count - 1 - i));
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Sum the bytes of a hex string, the checksum covers each byte of a field
+ *
+ * @param hex_str: Hex string
+ * @param byte_count: Number of bytes (2 hex digits each)
+ *
+ * @return Sum of the bytes
+ */
+static uint32_t get_hex_bytes_sum(uint8_t *hex_str, uint32_t byte_count)
+{
+    uint32_t i = 0;       /*i is used for traversaling the loop*/
+    uint32_t ret_val = 0; /*This variable stores function return value*/
+
+    for (i = 0; i < byte_count; i++)
+    {
+        ret_val += convert_hex_string_to_decimal(hex_str + (i * 2u), 2u);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Check that a line holds all its fields: hex digits, the length given by its byte count,
+ *        the address of its type and the checksum. Only S0 to S3 carry data, S4 is reserved
+ *
+ * @param line: Srec record
+ * @param line_length: Length of the line
+ *
+ * @return 1 if the fields can be read, 0 if not
+ */
+static uint8_t is_line_well_formed(uint8_t *line, uint32_t line_length)
+{
+    uint8_t ret_val = 1;        /*This variable stores the function return value*/
+    uint32_t i = 0;             /*i is used for traversaling the loop*/
+    uint32_t address_width = 0; /*This variable stores the address field width of the record type*/
+    uint8_t type = 0;           /*This variable stores the record type*/
+    uint32_t byte_count = 0;    /*This variable stores the byte count of the line*/
+
+    /*Check the length before reading the byte count*/
+    if ((line_length < SREC_MIN_LINE_LENGTH) || (line_length > SREC_MAX_LINE_LENGTH))
+    {
+        ret_val = 0;
+    }
+    else
+    {
+        /*Every character after the start code is a hex digit*/
+        for (i = RECORD_TYPE_OFFSET; i < line_length; i++)
+        {
+            if (!((('0' <= line[i]) && (line[i] <= '9')) || (('A' <= line[i]) && (line[i] <= 'F'))))
+            {
+                ret_val = 0;
+            }
+            else
+            {
+                /*Do nothing*/
+            }
+        }
+    }
+
+    if (1u == ret_val)
+    {
+        type = convert_hex_to_decimal(line[RECORD_TYPE_OFFSET]);
+        byte_count = convert_hex_string_to_decimal(line + BYTE_COUNT_OFFSET, 2u);
+
+        /*Get the address field width of the record type*/
+        switch (type)
+        {
+        case S2:
+        case S6:
+        case S8:
+        {
+            address_width = ADDRESS_24BIT_WIDTH;
+            break;
+        }
+        case S3:
+        case S7:
+        {
+            address_width = ADDRESS_32BIT_WIDTH;
+            break;
+        }
+        default:
+        {
+            address_width = ADDRESS_16BIT_WIDTH;
+            break;
+        }
+        }
+
+        /*The byte count gives the line length and covers at least the address and the checksum*/
+        if ((line_length != (byte_count + 2u) * 2u) || (byte_count < (address_width / 2u + 1u)))
+        {
+            ret_val = 0;
+        }
+        /*The checksum of a count or termination record only covers its address: bytes after it
+         *would not be checked. The reserved type has no known layout*/
+        else if ((S4 == type) || ((type > S3) && (byte_count != (address_width / 2u + 1u))))
+        {
+            ret_val = 0;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+    else
+    {
+        /*Do nothing*/
     }
 
     return ret_val;
@@ -138,7 +266,7 @@ static uint64_t convert_hex_string_to_decimal(uint8_t *hex_str, uint32_t hex_dig
 /**
  * @brief Check srec line
  *
- * @param record: Struct pointer has infomation about a srec line
+ * @param record: Struct pointer has infomation about a srec line, parsed from line by parse_Srecord_line
  * @param line: Srec record
  *
  * @return 0 if no error, 1 if error
@@ -146,30 +274,28 @@ static uint64_t convert_hex_string_to_decimal(uint8_t *hex_str, uint32_t hex_dig
 uint8_t check_srec_line(srec_line *record, uint8_t *line)
 {
     uint8_t ret_val = 0;        /*This variable stores the function return value*/
-    uint8_t record_length = 0;  /*This variable stores length of a raw record*/
-    uint8_t check_sum_read = 0; /*This variable stores the check sum read from raw record*/
+    uint32_t record_length = 0; /*This variable stores length of a raw record*/
 
-    /*Get record length from parsed record*/
+    /*Get record length from parsed record, the parse checked it is the line length*/
     record_length = (record->byte_count + 2u) * 2u;
-    /*Get check sum from raw record*/
-    check_sum_read = convert_hex_string_to_decimal(line + record_length - 2u, 2u);
 
-    /*Check start code*/
-    if ('S' != record->start_code)
+    /*A line that does not hold its fields has been parsed as the reserved type, a well-formed line
+     *is never of that type: the line is not scanned again*/
+    if (S4 == record->type)
     {
         ret_val = 1;
     }
-    else if (record->type > S9)
+    /*Check start code*/
+    else if ('S' != record->start_code)
     {
         ret_val = 1;
     }
-    /*Check check sum value*/
-    else if (check_sum_read != record->check_sum)
+    else if (record->type > S9)
     {
         ret_val = 1;
     }
-    /*Check record length*/
-    else if (record_length != get_string_length(line))
+    /*Check check sum value, the last byte of the line*/
+    else if (convert_hex_string_to_decimal(line + record_length - 2u, 2u) != record->check_sum)
     {
         ret_val = 1;
     }
@@ -185,97 +311,121 @@ uint8_t check_srec_line(srec_line *record, uint8_t *line)
  * @brief Parse a srec record
  *
  * @param record_line: Input srec record
+ * @param record: Struct pointer to store the parsed record
  *
- * @return a parsed record struct
+ * @return: This function return nothing
  */
-srec_line parse_Srecord_line(uint8_t *record_line)
+void parse_Srecord_line(uint8_t *record_line, srec_line *record)
 {
-    srec_line record = {0};          /*This struct stores the function return value*/
     uint32_t i = 0;                  /*i is used for traversaling loop*/
     uint32_t data_size = 0;          /*This variable stores length of data field*/
     uint8_t *data_pointer = NULL;    /*This pointer stores address of data field in raw record*/
     uint8_t *address_pointer = NULL; /*This pointer stores address of address field in raw record*/
+    uint8_t well_formed = 0;         /*This variable indicates if the fields of the line can be read*/
+
+    /*Clear the fields that are not set by every record type*/
+    record->address = 0;
+    record->check_sum = 0;
+    record->data_word = 0;
 
     /*Get address field pointer*/
     address_pointer = record_line + ADDRESS_FIELD_OFFSET;
 
+    /*A line that does not hold its fields is decoded as the reserved type: no field is read past
+     *the line and check_srec_line rejects it*/
+    well_formed = is_line_well_formed(record_line, get_string_length(record_line));
+
     /*Get start code*/
-    record.start_code = record_line[START_CODE_OFFSET];
+    record->start_code = record_line[START_CODE_OFFSET];
     /*Get record type*/
-    record.type = convert_hex_to_decimal(record_line[RECORD_TYPE_OFFSET]);
+    record->type = (1u == well_formed) ? convert_hex_to_decimal(record_line[RECORD_TYPE_OFFSET]) : S4;
     /*Get byte count value*/
-    record.byte_count = convert_hex_string_to_decimal(record_line + BYTE_COUNT_OFFSET, 2u);
+    record->byte_count = (1u == well_formed) ? convert_hex_string_to_decimal(record_line + BYTE_COUNT_OFFSET, 2u) : 0u;
 
     /*Evaluate record type*/
-    switch (record.type)
+    switch (record->type)
     {
     /*If record is header record*/
     case S0:
     {
         /*Get data field pointer*/
         data_pointer = record_line + S0_DATA_OFFSET;
-        /*Calculate record checksum*/
-        record.check_sum = record.byte_count + (record.address >> 8) + (record.address & 0xFF);
+        /*Calculate record checksum, the address field is usually 0000*/
+        record->check_sum = record->byte_count + get_hex_bytes_sum(address_pointer, ADDRESS_16BIT_WIDTH / 2u);
         /*Get data field length*/
-        data_size = record.byte_count - S0_NOT_DATA_COUNT;
+        data_size = record->byte_count - S0_NOT_DATA_COUNT;
         /*Get data field size in word align to write to flash*/
-        record.data_word = data_size / WORD_ALIGN;
+        record->data_word = (data_size + WORD_ALIGN - 1u) / WORD_ALIGN;
         break;
     }
     /*Data record 16 bits address*/
     case S1:
     {
         /*Get address value*/
-        record.address = convert_hex_string_to_decimal(address_pointer, ADDRESS_16BIT_WIDTH);
+        record->address = convert_hex_string_to_decimal(address_pointer, ADDRESS_16BIT_WIDTH);
         /*Get data field pointer*/
         data_pointer = record_line + S1_DATA_OFFSET;
         /*Calculate checksum*/
-        record.check_sum = record.byte_count + (record.address >> 8u) + (record.address & 0xFFu);
+        record->check_sum = record->byte_count + get_hex_bytes_sum(address_pointer, ADDRESS_16BIT_WIDTH / 2u);
         /*Get data field length*/
-        data_size = record.byte_count - S1_NOT_DATA_COUNT;
+        data_size = record->byte_count - S1_NOT_DATA_COUNT;
         /*Get data field size in word align to write to flash*/
-        record.data_word = data_size / WORD_ALIGN;
+        record->data_word = (data_size + WORD_ALIGN - 1u) / WORD_ALIGN;
         break;
     }
     /*Data record with 24 bits address*/
     case S2:
     {
         /*Get address value*/
-        record.address = convert_hex_string_to_decimal(address_pointer, ADDRESS_24BIT_WIDTH);
+        record->address = convert_hex_string_to_decimal(address_pointer, ADDRESS_24BIT_WIDTH);
         /*Calculate record checksum*/
-        record.check_sum = record.byte_count + (record.address >> 12u) + (record.address >> 8u) + (record.address & 0xFFu);
+        record->check_sum = record->byte_count + get_hex_bytes_sum(address_pointer, ADDRESS_24BIT_WIDTH / 2u);
         /*Get data field pointer*/
         data_pointer = record_line + S2_DATA_OFFSET;
         /*Get data field length*/
-        data_size = record.byte_count - S2_NOT_DATA_COUNT;
+        data_size = record->byte_count - S2_NOT_DATA_COUNT;
         /*Get data field length in word align to write to flash*/
-        record.data_word = data_size / WORD_ALIGN;
+        record->data_word = (data_size + WORD_ALIGN - 1u) / WORD_ALIGN;
         break;
     }
     /*Data record with 32 bits address*/
     case S3:
     {
         /*Get address value*/
-        record.address = convert_hex_string_to_decimal(address_pointer, ADDRESS_32BIT_WIDTH);
+        record->address = convert_hex_string_to_decimal(address_pointer, ADDRESS_32BIT_WIDTH);
         /*Calculate record checksum*/
-        record.check_sum = record.byte_count + (record.address >> 16u) + (record.address >> 12u) + (record.address >> 8u) + (record.address & 0xFFu);
+        record->check_sum = record->byte_count + get_hex_bytes_sum(address_pointer, ADDRESS_32BIT_WIDTH / 2u);
         /*Get data field pointer*/
         data_pointer = record_line + S3_DATA_OFFSET;
         /*Get data size in byte align*/
-        data_size = record.byte_count - S3_NOT_DATA_COUNT;
+        data_size = record->byte_count - S3_NOT_DATA_COUNT;
         /*Get data size in word align to write to flash*/
-        record.data_word = data_size / WORD_ALIGN;
+        record->data_word = (data_size + WORD_ALIGN - 1u) / WORD_ALIGN;
+        break;
+    }
+    /*Count record, the address field holds the number of data records sent before it*/
+    case S5:
+    case S6:
+    {
+        /*Get count value*/
+        record->address = convert_hex_string_to_decimal(address_pointer, (S5 == record->type) ? ADDRESS_16BIT_WIDTH : ADDRESS_24BIT_WIDTH);
+        /*Calculate record checksum*/
+        record->check_sum = record->byte_count + get_hex_bytes_sum(address_pointer, ((S5 == record->type) ? ADDRESS_16BIT_WIDTH : ADDRESS_24BIT_WIDTH) / 2u);
+        /*Get data size in word align*/
+        record->data_word = 0;
+        /*Get data size in byte align*/
+        data_size = 0;
         break;
     }
     /*Termination record for S3 series*/
     case S7:
     {
         /*Get address value*/
-        record.address = convert_hex_string_to_decimal(address_pointer, ADDRESS_32BIT_WIDTH);
+        record->address = convert_hex_string_to_decimal(address_pointer, ADDRESS_32BIT_WIDTH);
         /*Calculate record checksum*/
-        record.check_sum = record.byte_count + (record.address >> 16u) + (record.address >> 12u) + (record.address >> 8u) + (record.address & 0xFFu);
+        record->check_sum = record->byte_count + get_hex_bytes_sum(address_pointer, ADDRESS_32BIT_WIDTH / 2u);
         /*Get data size in word align*/
-        record.data_word = 0;
+        record->data_word = 0;
         /*Get data size in byte align*/
         data_size = 0;
         break;
@@ -284,11 +434,11 @@ srec_line parse_Srecord_line(uint8_t *record_line)
     case S8:
     {
         /*Get address value*/
-        record.address = convert_hex_string_to_decimal(address_pointer, ADDRESS_24BIT_WIDTH);
+        record->address = convert_hex_string_to_decimal(address_pointer, ADDRESS_24BIT_WIDTH);
         /*Calculate record checksum*/
-        record.check_sum = record.byte_count + (record.address >> 12u) + (record.address >> 8u) + (record.address & 0xFFu);
+        record->check_sum = record->byte_count + get_hex_bytes_sum(address_pointer, ADDRESS_24BIT_WIDTH / 2u);
         /*Get data size in word align*/
-        record.data_word = 0;
+        record->data_word = 0;
         /*Get data size in byte align*/
         data_size = 0;
         break;
@@ -297,11 +447,11 @@ srec_line parse_Srecord_line(uint8_t *record_line)
     case S9:
     {
         /*Get address value*/
-        record.address = convert_hex_string_to_decimal(address_pointer, ADDRESS_16BIT_WIDTH);
+        record->address = convert_hex_string_to_decimal(address_pointer, ADDRESS_16BIT_WIDTH);
         /*Calculate checksum*/
-        record.check_sum = record.byte_count + (record.address >> 8) + (record.address & 0xFF);
+        record->check_sum = record->byte_count + get_hex_bytes_sum(address_pointer, ADDRESS_16BIT_WIDTH / 2u);
         /*Get data size in word align*/
-        record.data_word = 0;
+        record->data_word = 0;
         /*Get data size in byte align*/
         data_size = 0;
         break;
@@ -316,13 +466,19 @@ srec_line parse_Srecord_line(uint8_t *record_line)
     for (i = 0; i < data_size; i++)
     {
         /*Get decimal value of each 2-hex digits*/
-        record.data[i] = convert_hex_string_to_decimal(data_pointer + (i * 2u), 2u);
+        record->data[i] = convert_hex_string_to_decimal(data_pointer + (i * 2u), 2u);
         /*Get checksum*/
-        record.check_sum += record.data[i];
+        record->check_sum += record->data[i];
+    }
+    record->check_sum = ~record->check_sum;
+
+    /*A partial last word is completed with the erased value of the flash*/
+    for (i = data_size; i < (record->data_word * WORD_ALIGN); i++)
+    {
+        record->data[i] = 0xFFu;
     }
-    record.check_sum = ~record.check_sum;
 
-    return record;
+    return;
 }
 
 /*EOF*/
@@ -0,0 +1,178 @@
+/**
+ * @file  : Trace.c
+ * @author: Nguyen The Anh.
+ * @brief : Definition of function using in file Trace.c
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include "../Includes/Trace/Trace.h"
+#include "../Includes/Driver/Driver_core.h"
+#include "../Includes/Driver/Driver_UART0.h"
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*This array stores the kept records then the ring of the later ones*/
+static trace_record s_trace_ring[TRACE_PINNED_SIZE + TRACE_BUFFER_SIZE];
+
+/*This variable stores the total number of records*/
+static uint32_t s_trace_count = 0;
+
+/*Name of each event type in the dumped timeline*/
+static const char *const s_trace_event_name[TRACE_EVENT_COUNT] = {
+    "switch", "clock", "uart", "banner", "erase start", "erase end",
+    "first record", "sector", "last record", "jump", "commit"};
+
+/*******************************************************************************
+ * Static functions prototype
+ ******************************************************************************/
+
+/**
+ * @brief Get the slot of a record
+ *
+ * @param index: Number of records added before it
+ *
+ * @return the slot, in the kept records or in the ring
+ */
+static trace_record *Trace_get_slot(uint32_t index);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/**
+ * @brief Get the slot of a record
+ */
+static trace_record *Trace_get_slot(uint32_t index)
+{
+    trace_record *record = &s_trace_ring[index]; /*This pointer points to the slot*/
+
+    /*Past the kept records the low bits of the index select the ring slot*/
+    if (index >= TRACE_PINNED_SIZE)
+    {
+        record = &s_trace_ring[TRACE_PINNED_SIZE + ((index - TRACE_PINNED_SIZE) & (TRACE_BUFFER_SIZE - 1u))];
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return record;
+}
+
+/**
+ * @brief Clear the trace ring
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Trace_init(void)
+{
+    s_trace_count = 0;
+
+    return;
+}
+
+/**
+ * @brief Add a timestamped record to the trace ring
+ *
+ * @param event: Event type
+ * @param param: Event parameter
+ *
+ * @return: This function return nothing
+ */
+void Trace_record(trace_event_enum_t event, uint32_t param)
+{
+    trace_record *record = Trace_get_slot(s_trace_count); /*Slot of the new record*/
+
+    record->timestamp = Driver_SysTick_get_ticks();
+    record->param = param;
+    record->event = (uint32_t)event;
+    s_trace_count++;
+
+    return;
+}
+
+/**
+ * @brief Send the trace records over UART0 as a timeline with the delta between phases
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Trace_dump(void)
+{
+    uint32_t i = 0;            /*i is used for traversaling the loop*/
+    uint32_t previous = 0;     /*This variable stores the timestamp of the previous record*/
+    uint32_t update_start = 0; /*This variable stores the timestamp of the first data record*/
+    trace_record *record = 0;  /*This pointer points to the record being sent*/
+
+    Driver_UART0_send_string("\nTrace  : cycles, +delta, phase, param");
+
+    for (i = 0; i < s_trace_count; i++)
+    {
+        /*If the ring has wrapped, go on after the kept records from the oldest record of the ring*/
+        if ((TRACE_PINNED_SIZE == i) && (s_trace_count > (TRACE_PINNED_SIZE + TRACE_BUFFER_SIZE)))
+        {
+            i = s_trace_count - TRACE_BUFFER_SIZE;
+            Driver_UART0_send_string("\n         ... ");
+            Driver_UART0_send_number(i - TRACE_PINNED_SIZE);
+            Driver_UART0_send_string(" records overwritten");
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+
+        record = Trace_get_slot(i);
+
+        Driver_UART0_send_string("\n         ");
+        Driver_UART0_send_number(record->timestamp);
+        Driver_UART0_send_string(", +");
+        Driver_UART0_send_number((0u == i) ? 0u : (record->timestamp - previous));
+        Driver_UART0_send_string(", ");
+        if (record->event < TRACE_EVENT_COUNT)
+        {
+            Driver_UART0_send_string((uint8_t *)s_trace_event_name[record->event]);
+        }
+        else
+        {
+            Driver_UART0_send_string("?");
+        }
+        Driver_UART0_send_string(", ");
+        Driver_UART0_send_number(record->param);
+
+        /*Update throughput: programmed bytes over the first to the last record time*/
+        if (TRACE_EVENT_RECORD_FIRST == record->event)
+        {
+            update_start = record->timestamp;
+        }
+        else if ((TRACE_EVENT_RECORD_LAST == record->event) && (0u != update_start))
+        {
+            Driver_UART0_send_string("\nUpdate : ");
+            Driver_UART0_send_number(record->param);
+            Driver_UART0_send_string(" bytes in ");
+            Driver_UART0_send_number(record->timestamp - update_start);
+            Driver_UART0_send_string(" cycles");
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+
+        previous = record->timestamp;
+    }
+
+    return;
+}
+
+/*EOF*/
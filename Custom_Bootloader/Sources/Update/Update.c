@@ -0,0 +1,1519 @@
+/**
+ * @file  : Update.c
+ * @author: Nguyen The Anh.
+ * @brief : Definition of function using in file Update.c
+ * @version: 0.0
+ *
+ * Nothing is erased before the image comes: the host commands are answered on the installed App.
+ * An image known to fit in STAGING_BUFFER_SIZE is received in RAM, checked, and the old App is
+ * erased and replaced after the termination record, when the host has sent everything. An erase
+ * masks the interrupts and loses the frames received meanwhile, so the rest depends on the host:
+ * - A paced host sends its first line alone. Unless that line is the manifest S0 of an image that
+ *   fits, the old App is erased before it is acknowledged and the records are streamed to flash.
+ * - An unpaced host, a terminal, is staged. An image that overflows the staging buffer, or whose
+ *   manifest tells it does, is rejected before flash is touched.
+ * On a multi-drop line a bad line is skipped, and the update ends with #COMMIT once the host has
+ * retransmitted the records this node missed.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include "../Includes/Update/Update.h"
+#include "../Includes/Update/Verify.h"
+#include "../Includes/Driver/Driver_UART0.h"
+#include "../Includes/Driver/Driver_core.h"
+#include "../Includes/HAL/FLASH.h"
+#include "../Includes/Trace/Trace.h"
+#include "../Includes/Event/Event.h"
+#include "../Includes/Crc/Crc32.h"
+#include "App_manifest.h"
+#include <stddef.h>
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*This struct stores the statistics of the last update*/
+static update_statistic_info s_update_statistics;
+
+/*This variable stores the timestamp at which the current update stage started*/
+static uint64_t s_stage_start = 0;
+
+/*This variable stores the timestamp of the update start*/
+static uint64_t s_update_start = 0;
+
+/*This struct stores the sleep statistics at the update start*/
+static event_statistic_info s_sleep_start;
+
+/*Background erase of the old App: start timestamp, time blocked waiting for it, still running flag*/
+static uint64_t s_background_erase_start = 0;
+static uint64_t s_background_erase_blocked = 0;
+static uint8_t s_background_erase_active = 0;
+
+/*Staged update image*/
+static staging_image_info s_staging __attribute__((aligned(4)));
+
+/*Image of the update being received*/
+static update_image_info s_image;
+
+/*Manifest of the image being received, valid if s_manifest_valid is 1*/
+static app_manifest s_manifest;
+static uint8_t s_manifest_valid = 0;
+
+/*The termination record of a multi-drop update has been received, #COMMIT ends the update*/
+static uint8_t s_image_complete = 0;
+
+/*The update has erased the old App: a failed update no longer leaves it in place*/
+static uint8_t s_flash_written = 0;
+
+/*******************************************************************************
+ * Static functions prototype
+ ******************************************************************************/
+
+/**
+ * @brief Erase the App information sector and the sectors of the App: the range of the old App
+ *        and the load range of the manifest of the new App
+ *
+ * @param new_start: Start of the load range of the manifest, 0 without a manifest
+ * @param new_end: End of the load range of the manifest, 0 without a manifest
+ *
+ * @return: This function return nothing
+ */
+static void Erase_Old_Application(uint32_t new_start, uint32_t new_end);
+
+/**
+ * @brief Get the number of sectors an App range occupies
+ *
+ * @param start_address: Address of the first App byte
+ * @param end_address: Address after the last App byte
+ *
+ * @return App size in sector
+ */
+static uint32_t Get_App_size_sector(uint32_t start_address, uint32_t end_address);
+
+/**
+ * @brief Copy the manifest of a S0 record
+ *
+ * @param record: Parsed S0 record
+ *
+ * @return 1 if the record holds a manifest, 0 if it is a text header
+ */
+static uint8_t Read_manifest(srec_line *record);
+
+/**
+ * @brief Compute the CRC-32 of a flash range
+ *
+ * @param address: Address of the first byte
+ * @param size: Number of bytes
+ *
+ * @return CRC-32 of the range
+ */
+static uint32_t Get_flash_crc(uint32_t address, uint32_t size);
+
+/**
+ * @brief Add the time since the current stage started to a stage counter and start the next stage
+ *
+ * @param stage_cycles: Counter of the stage that has just finished
+ *
+ * @return: This function return nothing
+ */
+static void Account_update_stage(uint64_t *stage_cycles);
+
+/**
+ * @brief Continue the background erase and record its overlap once it is done, run by the flash
+ *        and tick events during an update
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+static void Account_background_erase(void);
+
+/**
+ * @brief Erase the old App, in the foreground for the sectors of the boot block, and start the
+ *        background erase accounting
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+static void Start_flash_update(void);
+
+/**
+ * @brief Copy a data record into the staged image
+ *
+ * @param record: Parsed data record
+ *
+ * @return 1 if staged, 0 if the record is outside the staging buffer
+ */
+static uint8_t Stage_record(srec_line *record);
+
+/**
+ * @brief Get the offset in the staging buffer of the data received for a flash address
+ *
+ * @param address: Flash address
+ *
+ * @return Byte offset in s_staging.image
+ */
+static uint32_t Get_staging_offset(uint32_t address);
+
+/**
+ * @brief Get the value a programmed longword must hold: its received data while its sector is
+ *        kept, the erased value for a longword without a record
+ *
+ * @param address: Address of the longword
+ *
+ * @return Value of the longword
+ */
+static uint32_t Get_staged_longword(uint32_t address);
+
+/**
+ * @brief Keep the data of a record in the slots of its sectors until they are verified. A slot
+ *        that holds another sector is taken once that sector has been verified
+ *
+ * @param record: Parsed data record
+ *
+ * @return: This function return nothing
+ */
+static void Keep_record(srec_line *record);
+
+/**
+ * @brief Program a longword of the update, a failed command fails the sector of the longword
+ *
+ * @param address: Flash address of the longword
+ * @param data: 4 bytes to program
+ *
+ * @return: This function return nothing
+ */
+static void Program_update_longword(uint32_t address, uint8_t *data);
+
+/**
+ * @brief Check a complete staged image against the CRC of its manifest before flash is touched
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if the image matches or its manifest has no CRC, 0 otherwise
+ */
+static uint8_t Check_staged_image(void);
+
+/**
+ * @brief Erase the old App then write the staged header and image to flash
+ *
+ * @param start_address: Start address of the new App, 0 if no data record yet
+ *
+ * @return: This function return nothing
+ */
+static void Commit_staged_image(uint32_t start_address);
+
+/**
+ * @brief Verify the rest of a received image and check it against the CRC of its manifest
+ *
+ * @param start_address is the address of the first App byte
+ * @param end_address is the address after the last App byte
+ *
+ * @return 1 if the image is good, 0 if a sector or the CRC failed
+ */
+static uint8_t Check_received_image(uint32_t start_address, uint32_t end_address);
+
+/**
+ * @brief Process a S0 record: the manifest, checked before any flash work, or a text header
+ *
+ * @param record: Parsed S0 record
+ * @param paced: 1 if the host waits for the acknowledge of each line, 0 if not
+ *
+ * @return UPDATE_CONTINUE while the update goes on, the boot_result_t of its end otherwise
+ */
+static uint32_t Receive_header_record(srec_line *record, uint8_t paced);
+
+/**
+ * @brief Process a termination record: write a staged image, verify the image and mark it valid
+ *
+ * @param: This function has no parameter
+ *
+ * @return UPDATE_CONTINUE on a multi-drop node, the boot_result_t of the end of the update otherwise
+ */
+static uint32_t Receive_termination_record(void);
+
+/**
+ * @brief Process a data record: stage it, or program and verify it once the image is streamed
+ *
+ * @param record: Parsed data record
+ * @param paced: 1 if the host waits for the acknowledge of each line, 0 if not
+ *
+ * @return UPDATE_CONTINUE while the update goes on, the boot_result_t of its end otherwise
+ */
+static uint32_t Receive_data_record(srec_line *record, uint8_t paced);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/**
+ * @brief Erase old application code in flash
+ */
+static void Erase_Old_Application(uint32_t new_start, uint32_t new_end)
+{
+    uint32_t app_start_addr = 0;  /*This variable stores old application start address*/
+    uint32_t app_size_sector = 0; /*This variable stores old application size in sector*/
+    uint32_t erase_start = 0;     /*This variable stores the first erased address*/
+    uint32_t erase_end = 0;       /*This variable stores the address after the erased range*/
+
+    /*Get Application start address, the load range of its manifest if it has one*/
+    if (APP_MANIFEST_MAGIC == Read_FlashAddress(APP_HEADER_LOCATION))
+    {
+        app_start_addr = Read_FlashAddress(APP_HEADER_LOCATION + offsetof(app_manifest, load_address));
+    }
+    else
+    {
+        app_start_addr = Read_FlashAddress(APP_START_ADDRESS_LOCATION);
+    }
+
+    /*Get Application size*/
+    app_size_sector = Read_FlashAddress(APP_SIZE_LOCATION);
+
+    Trace_record(TRACE_EVENT_ERASE_START, app_size_sector);
+
+    /*Erase Application information sector*/
+    Erase_Sector(APP_START_ADDRESS_LOCATION);
+
+    /*Check if there is an old App in the App region*/
+    if ((app_start_addr >= BASE_APP_ADDRESS) && (app_start_addr < (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE)))
+    {
+        erase_start = app_start_addr & ~(FLASH_SECTOR_SIZE - 1u);
+
+        /*A size left erased by a failed update covers the rest of the region*/
+        if (app_size_sector > ((FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE - erase_start) / FLASH_SECTOR_SIZE))
+        {
+            app_size_sector = (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE - erase_start) / FLASH_SECTOR_SIZE;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+
+        erase_end = erase_start + app_size_sector * FLASH_SECTOR_SIZE;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    /*A checked manifest gives the sectors of the new App, in the App region. The erase covers
+     *them and the old App: an old App larger than the new one leaves no programmed sector behind*/
+    if (new_end > new_start)
+    {
+        new_start = new_start & ~(FLASH_SECTOR_SIZE - 1u);
+        new_end = new_start + Get_App_size_sector(new_start, new_end) * FLASH_SECTOR_SIZE;
+
+        if (erase_end > erase_start)
+        {
+            erase_start = (new_start < erase_start) ? new_start : erase_start;
+            erase_end = (new_end > erase_end) ? new_end : erase_end;
+        }
+        else
+        {
+            erase_start = new_start;
+            erase_end = new_end;
+        }
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    if (erase_end > erase_start)
+    {
+        /*Erase old App, its sectors in the other flash block are erased while receiving*/
+        Erase_Multi_Sector_Background(erase_start, (erase_end - erase_start) / FLASH_SECTOR_SIZE);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    Trace_record(TRACE_EVENT_ERASE_END, 0);
+
+    return;
+}
+
+/**
+ * @brief Get the number of sectors an App range occupies
+ */
+static uint32_t Get_App_size_sector(uint32_t start_address, uint32_t end_address)
+{
+    uint32_t ret_val = 0; /*This variable stores the function return value*/
+
+    if (end_address > start_address)
+    {
+        ret_val = (((end_address + FLASH_SECTOR_SIZE - 1u) & ~(FLASH_SECTOR_SIZE - 1u)) -
+                   (start_address & ~(FLASH_SECTOR_SIZE - 1u))) / FLASH_SECTOR_SIZE;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Copy the manifest of a S0 record
+ */
+static uint8_t Read_manifest(srec_line *record)
+{
+    uint8_t ret_val = 0;                         /*This variable stores the function return value*/
+    uint32_t i = 0;                              /*i is used for traversaling the loop*/
+    uint8_t *manifest = (uint8_t *)&s_manifest;  /*Byte view of the manifest*/
+
+    /*Check if the data is long enough and starts with the manifest magic*/
+    if ((record->data_word * 4 >= sizeof(app_manifest)) &&
+        (APP_MANIFEST_MAGIC == ((uint32_t)record->data[0] | ((uint32_t)record->data[1] << 8) |
+                                ((uint32_t)record->data[2] << 16) | ((uint32_t)record->data[3] << 24))))
+    {
+        for (i = 0; i < sizeof(app_manifest); i++)
+        {
+            manifest[i] = record->data[i];
+        }
+
+        ret_val = 1;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Compute the CRC-32 of a flash range
+ */
+static uint32_t Get_flash_crc(uint32_t address, uint32_t size)
+{
+    /*The caller makes sure no flash command runs on the range*/
+    return Crc32_final(Crc32_update(CRC32_INITIAL_VALUE, (const uint8_t *)address, size));
+}
+
+/**
+ * @brief Add the time since the current stage started to a stage counter and start the next stage
+ */
+static void Account_update_stage(uint64_t *stage_cycles)
+{
+    uint64_t now = Driver_SysTick_get_ticks64(); /*This variable stores the end of the stage*/
+
+    *stage_cycles += now - s_stage_start;
+    s_stage_start = now;
+
+    return;
+}
+
+/**
+ * @brief Continue the background erase and record its overlap once it is done
+ */
+static void Account_background_erase(void)
+{
+    if ((0u != s_background_erase_active) && (0u == Flash_Background_Erase_poll()))
+    {
+        s_update_statistics.overlap_cycles = Driver_SysTick_get_ticks64() - s_background_erase_start -
+                                             s_background_erase_blocked;
+        s_background_erase_active = 0;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/**
+ * @brief Erase the old App and start the background erase accounting
+ */
+static void Start_flash_update(void)
+{
+    s_flash_written = 1;
+
+    /*Erase the old App, with the load range of a manifest checked when its S0 was received. The
+     *old range is the load range of the old manifest or its App size, so the sectors past the
+     *new App are left erased for the next update*/
+    if (1u == s_manifest_valid)
+    {
+        Erase_Old_Application(s_manifest.load_address, s_manifest.load_address + s_manifest.load_size);
+    }
+    else
+    {
+        Erase_Old_Application(0, 0);
+    }
+    Account_update_stage(&s_update_statistics.erase_cycles);
+
+    /*Sectors of the other flash block left to the background erase*/
+    s_update_statistics.background_sectors = Flash_Background_Erase_poll();
+    s_background_erase_start = s_stage_start;
+    s_background_erase_blocked = 0;
+    s_background_erase_active = (0u != s_update_statistics.background_sectors) ? 1u : 0u;
+
+    return;
+}
+
+/**
+ * @brief Copy a data record into the staged image
+ */
+static uint8_t Stage_record(srec_line *record)
+{
+    uint8_t ret_val = 0;     /*This variable stores the function return value*/
+    uint32_t record_end = 0; /*This variable stores the address after the record*/
+
+    record_end = record->address + record->data_word * 4;
+
+    /*Check if the record lies in the staging buffer, the manifest or the first record fixes its window*/
+    if ((record->address >= s_staging.base_address) &&
+        (record_end <= (s_staging.base_address + STAGING_BUFFER_SIZE)))
+    {
+        Keep_record(record);
+
+        if (record_end > s_staging.end_address)
+        {
+            s_staging.end_address = record_end;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+
+        ret_val = 1;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Get the offset in the staging buffer of the data received for a flash address
+ */
+static uint32_t Get_staging_offset(uint32_t address)
+{
+    /*The subtraction wraps for an address below the window, 2^32 is a multiple of the buffer size*/
+    return (address - s_staging.base_address) % STAGING_BUFFER_SIZE;
+}
+
+/**
+ * @brief Get the value a programmed longword must hold
+ */
+static uint32_t Get_staged_longword(uint32_t address)
+{
+    uint32_t ret_val = FLASH_DELETED_VALUE; /*This variable stores the function return value*/
+
+    /*The received data of the sector is kept until it is verified, a sector without a record stays erased*/
+    if (s_staging.sector_address[Get_staging_offset(address) / FLASH_SECTOR_SIZE] ==
+        (address & ~(FLASH_SECTOR_SIZE - 1u)))
+    {
+        ret_val = s_staging.image[Get_staging_offset(address) / 4u];
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Keep the data of a record in the slots of its sectors until they are verified
+ */
+static void Keep_record(srec_line *record)
+{
+    uint32_t i = 0;                              /*i is used for traversaling the loop*/
+    uint32_t j = 0;                              /*j is used for traversaling the loop*/
+    uint32_t address = 0;                        /*This variable stores the address of a record byte*/
+    uint32_t slot = 0;                           /*This variable stores the slot of the sector of the byte*/
+    uint8_t *image = (uint8_t *)s_staging.image; /*Byte view of the staged image*/
+
+    for (i = 0; i < record->data_word * 4u; i++)
+    {
+        address = record->address + i;
+        slot = Get_staging_offset(address) / FLASH_SECTOR_SIZE;
+
+        if (s_staging.sector_address[slot] != (address & ~(FLASH_SECTOR_SIZE - 1u)))
+        {
+            /*The data of the sector in the slot is the reference of its verification: finish it first*/
+            if (0u != s_staging.sector_address[slot])
+            {
+                Verify_until(s_staging.sector_address[slot] + FLASH_SECTOR_SIZE);
+            }
+            else
+            {
+                /*Do nothing*/
+            }
+
+            for (j = 0; j < (FLASH_SECTOR_SIZE / 4u); j++)
+            {
+                s_staging.image[(slot * FLASH_SECTOR_SIZE / 4u) + j] = FLASH_DELETED_VALUE;
+            }
+            s_staging.sector_address[slot] = address & ~(FLASH_SECTOR_SIZE - 1u);
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+
+        image[Get_staging_offset(address)] = record->data[i];
+    }
+
+    return;
+}
+
+/**
+ * @brief Program a longword of the update, a failed command fails the sector of the longword
+ */
+static void Program_update_longword(uint32_t address, uint8_t *data)
+{
+    if (0u == Program_LongWord_8B(address, data))
+    {
+        Verify_mark_failed(address);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/**
+ * @brief Check a complete staged image against the CRC of its manifest before flash is touched
+ */
+static uint8_t Check_staged_image(void)
+{
+    uint8_t ret_val = 1; /*This variable stores the function return value*/
+
+    /*The manifest range lies in the staging window, the sectors without a record read erased*/
+    if ((1u == s_manifest_valid) && (0u != (s_manifest.flags & APP_MANIFEST_FLAG_CRC)) &&
+        (s_manifest.image_crc !=
+         Crc32_final(Crc32_update(CRC32_INITIAL_VALUE,
+                                  (const uint8_t *)s_staging.image + Get_staging_offset(s_manifest.load_address),
+                                  s_manifest.load_size))))
+    {
+        Verify_set_crc_failed(1);
+        ret_val = 0;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+    Account_update_stage(&s_update_statistics.verify_cycles);
+
+    return ret_val;
+}
+
+/**
+ * @brief Erase the old App then write the staged header and image to flash
+ */
+static void Commit_staged_image(uint32_t start_address)
+{
+    uint32_t i = 0;          /*i is used for traversaling the loop*/
+    uint32_t image_words = 0; /*This variable stores the number of staged words*/
+
+    Trace_record(TRACE_EVENT_COMMIT, s_staging.end_address - s_staging.base_address);
+
+    /*The old App is erased only now: a transfer that fails before has not touched flash*/
+    Account_update_stage(&s_update_statistics.program_cycles);
+    Start_flash_update();
+
+    if ((0u != start_address) && (0u == Program_LongWord(APP_START_ADDRESS_LOCATION, start_address)))
+    {
+        Verify_mark_failed(APP_START_ADDRESS_LOCATION);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    for (i = 0; i < s_staging.header_words; i++)
+    {
+        Program_update_longword(APP_HEADER_LOCATION + i * 4, &s_staging.header[i * 4]);
+    }
+
+    if (0u != s_staging.end_address)
+    {
+        /*Burst: the whole range is erased first, erased words need no programming*/
+        Account_update_stage(&s_update_statistics.program_cycles);
+        Update_wait_background_erase(s_staging.end_address - 1u);
+        Account_update_stage(&s_update_statistics.erase_cycles);
+
+        image_words = (s_staging.end_address - s_staging.base_address + 3u) / 4u;
+        for (i = 0; i < image_words; i++)
+        {
+            if (FLASH_DELETED_VALUE != s_staging.image[i])
+            {
+                Program_update_longword(s_staging.base_address + i * 4, (uint8_t *)&s_staging.image[i]);
+            }
+            else
+            {
+                /*Do nothing*/
+            }
+        }
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    Account_update_stage(&s_update_statistics.program_cycles);
+
+    return;
+}
+
+/**
+ * @brief Verify the rest of a received image and check it against the CRC of its manifest
+ */
+static uint8_t Check_received_image(uint32_t start_address, uint32_t end_address)
+{
+    Verify_ready(start_address, end_address);
+    Verify_until(FLASH_DELETED_VALUE);
+
+    /*The image must match the CRC of its manifest, read once no erase runs. It is checked again
+     *after the records a multi-drop host has retransmitted*/
+    Update_wait_background_erase(FLASH_DELETED_VALUE);
+    if ((1u == s_manifest_valid) && (0u != (s_manifest.flags & APP_MANIFEST_FLAG_CRC)) &&
+        (s_manifest.image_crc != Get_flash_crc(s_manifest.load_address, s_manifest.load_size)))
+    {
+        Verify_set_crc_failed(1);
+    }
+    else
+    {
+        Verify_set_crc_failed(0);
+    }
+    Account_update_stage(&s_update_statistics.verify_cycles);
+
+    return Verify_is_passed();
+}
+
+/**
+ * @brief Process a S0 record
+ */
+static uint32_t Receive_header_record(srec_line *record, uint8_t paced)
+{
+    uint32_t ret_val = UPDATE_CONTINUE; /*This variable stores the function return value*/
+    uint32_t i = 0;                     /*i is used for traversaling the loop*/
+
+    /*A manifest is checked before any flash work*/
+    if (1u == Read_manifest(record))
+    {
+        if (0u == App_manifest_check(&s_manifest))
+        {
+            /*Return error value*/
+            ret_val = BOOT_RESULT_BAD_MANIFEST;
+        }
+        else
+        {
+            s_manifest_valid = 1;
+            s_image.start_address = s_manifest.entry_address;
+            s_image.load_address = s_manifest.load_address;
+            s_image.end_address = s_manifest.load_address + s_manifest.load_size;
+            s_staging.base_address = s_manifest.load_address & ~(FLASH_SECTOR_SIZE - 1u);
+        }
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    if (UPDATE_CONTINUE == ret_val)
+    {
+        /*Keep header data for the commit of the staged image*/
+        if (1u == s_image.staging)
+        {
+            for (i = 0; (i < record->data_word * 4) && (i < APP_HEADER_MAX_SIZE); i++)
+            {
+                s_staging.header[i] = record->data[i];
+            }
+            s_staging.header_words = i / 4;
+        }
+        /*Write header data to the App header location in flash, a retransmitted header
+         *only fills the longwords left erased*/
+        else
+        {
+            for (i = 0; i < record->data_word; i++)
+            {
+                if ((0u == s_image_complete) ||
+                    (FLASH_DELETED_VALUE == Read_FlashAddress(APP_HEADER_LOCATION + i * 4)))
+                {
+                    Program_update_longword(APP_HEADER_LOCATION + i * 4, &record->data[i * 4]);
+                }
+                else
+                {
+                    /*Do nothing*/
+                }
+            }
+        }
+        Account_update_stage(&s_update_statistics.program_cycles);
+
+        /*Only a manifest tells the image fits in RAM. A paced host waits for the acknowledge
+         *of its first line: for any other image the old App is erased meanwhile and the
+         *records are streamed. An unpaced host keeps sending, an image its manifest tells
+         *too large is rejected before any erase*/
+        if ((1u == s_manifest_valid) &&
+            ((s_image.end_address - s_staging.base_address) <= STAGING_BUFFER_SIZE))
+        {
+            /*Do nothing*/
+        }
+        else if ((1u == s_image.staging) && (1u == paced) && (0u == s_image.data_records))
+        {
+            Commit_staged_image(s_image.start_address);
+            s_image.staging = 0;
+        }
+        else if ((1u == s_image.staging) && (0u == paced) && (1u == s_manifest_valid))
+        {
+            /*Return error value*/
+            ret_val = BOOT_RESULT_TOO_LARGE;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Process a termination record
+ */
+static uint32_t Receive_termination_record(void)
+{
+    uint32_t ret_val = UPDATE_CONTINUE; /*This variable stores the function return value*/
+    uint32_t sector_size = 0;           /*This variable stores size of new Application in sector*/
+
+    sector_size = Get_App_size_sector(s_image.load_address, s_image.end_address);
+
+    Trace_record(TRACE_EVENT_RECORD_LAST, s_image.byte_size);
+    s_update_statistics.transfer_cycles = Driver_SysTick_get_ticks64() - s_update_start;
+
+    /*The whole image has been received: check it, then erase the old App and write the
+     *image in one burst. A node of a multi-drop line gets the records it missed later*/
+    if ((1u == s_image.staging) && (0u == BOOT_NODE_ADDRESS) && (0u == Check_staged_image()))
+    {
+        /*Return error value*/
+        ret_val = BOOT_RESULT_VERIFY_FAILED;
+    }
+    else
+    {
+        if (1u == s_image.staging)
+        {
+            Commit_staged_image(s_image.start_address);
+            s_update_statistics.staged = 1;
+        }
+        else
+        {
+            s_update_statistics.staged = 0;
+        }
+
+        s_image.staging = 0;
+
+        /*Verify the rest of the image before marking it valid*/
+        if (0u != BOOT_NODE_ADDRESS)
+        {
+            /*The host collects the result of each node and retransmits what it missed*/
+            Check_received_image(s_image.load_address, s_image.end_address);
+            s_image_complete = 1;
+        }
+        /*Program App size and updated flag to App information region*/
+        else if ((1u == Check_received_image(s_image.load_address, s_image.end_address)) &&
+                 (1u == Program_LongWord(APP_SIZE_LOCATION, sector_size)) &&
+                 (1u == Program_LongWord(APP_UPDATED_FLAG_LOCATION, APP_UPDATE_SUCCESS)))
+        {
+            Account_update_stage(&s_update_statistics.program_cycles);
+
+            ret_val = BOOT_RESULT_SUCCESS;
+        }
+        else
+        {
+            /*A failed check or write leaves the update flag erased, the App is not launched*/
+            ret_val = BOOT_RESULT_VERIFY_FAILED;
+        }
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Process a data record
+ */
+static uint32_t Receive_data_record(srec_line *record, uint8_t paced)
+{
+    uint32_t ret_val = UPDATE_CONTINUE; /*This variable stores the function return value*/
+    uint32_t i = 0;                     /*i is used for traversaling the loop*/
+
+    /*A record past the end of flash, outside the load range of the manifest, or that does not
+     *start a longword (its words are programmed whole) rejects the image. The end is compared
+     *as a size so that it can not wrap*/
+    if ((record->address >= (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE)) ||
+        ((record->data_word * 4u) > (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE - record->address)) ||
+        (0u != (record->address % 4u)))
+    {
+        /*Return error value*/
+        ret_val = BOOT_RESULT_BAD_ADDRESS;
+    }
+    else if ((1u == s_manifest_valid) && ((record->address < s_manifest.load_address) ||
+             ((record->address + record->data_word * 4u) > ((s_image.end_address + 3u) & ~3u))))
+    {
+        /*Return error value*/
+        ret_val = BOOT_RESULT_BAD_ADDRESS;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    /*Get new App start address, the first record fixes the flash window of the staging buffer*/
+    if ((UPDATE_CONTINUE == ret_val) && (0u == s_image.load_address))
+    {
+        s_image.start_address = record->address;
+        s_image.load_address = record->address;
+        s_staging.base_address = record->address & ~(FLASH_SECTOR_SIZE - 1u);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    if ((UPDATE_CONTINUE == ret_val) && (0u == s_image.byte_size))
+    {
+        Trace_record(TRACE_EVENT_RECORD_FIRST, record->address);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    /*A paced host sent the first line alone: with no manifest the old App is erased before it
+     *is acknowledged and the image is streamed. Streamed after a text header, the first record
+     *gives the start address*/
+    if ((UPDATE_CONTINUE == ret_val) && (0u == s_image.data_records) && (0u == s_manifest_valid))
+    {
+        if ((1u == s_image.staging) && (1u == paced))
+        {
+            Commit_staged_image(s_image.start_address);
+            s_image.staging = 0;
+        }
+        else if ((0u == s_image.staging) &&
+                 (0u == Program_LongWord(APP_START_ADDRESS_LOCATION, s_image.start_address)))
+        {
+            Verify_mark_failed(APP_START_ADDRESS_LOCATION);
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    /*Stage the record. An image that overflows the staging buffer is rejected before flash is
+     *touched: the unpaced host has lines in flight, an erase now would lose them*/
+    if ((UPDATE_CONTINUE == ret_val) && (1u == s_image.staging) && (0u == Stage_record(record)))
+    {
+        /*Return error value*/
+        ret_val = BOOT_RESULT_TOO_LARGE;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    if (UPDATE_CONTINUE == ret_val)
+    {
+        /*Trace the first record of each sector*/
+        if ((record->address & ~(FLASH_SECTOR_SIZE - 1u)) != s_image.program_sector)
+        {
+            s_image.program_sector = record->address & ~(FLASH_SECTOR_SIZE - 1u);
+            Trace_record(TRACE_EVENT_SECTOR_PROGRAM, s_image.program_sector);
+
+            /*The sectors below the new one are complete, verify them while receiving*/
+            if (0u == s_image.staging)
+            {
+                Verify_ready(s_image.load_address, s_image.program_sector);
+            }
+            else
+            {
+                /*Do nothing*/
+            }
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+
+        if (0u == s_image.staging)
+        {
+            /*The sectors of the record must be erased before programming*/
+            Account_update_stage(&s_update_statistics.program_cycles);
+            Update_wait_background_erase(record->address + record->data_word * 4 - 1u);
+            Account_update_stage(&s_update_statistics.erase_cycles);
+
+            /*Keep the data of the record, its sector is verified against it*/
+            if (0u == s_image_complete)
+            {
+                Keep_record(record);
+            }
+            else
+            {
+                /*Do nothing*/
+            }
+
+            /*Program data record to flash, a record retransmitted once the image is complete
+             *only fills the longwords left erased and is verified at once*/
+            for (i = 0; i < record->data_word; i++)
+            {
+                if ((0u == s_image_complete) ||
+                    (FLASH_DELETED_VALUE == Read_FlashAddress(record->address + i * 4)))
+                {
+                    Program_update_longword(record->address + i * 4, &record->data[i * 4]);
+                }
+                else
+                {
+                    /*Do nothing*/
+                }
+            }
+
+            if (1u == s_image_complete)
+            {
+                Verify_record(record);
+            }
+            else
+            {
+                /*Do nothing*/
+            }
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+
+        s_image.data_records++;
+        s_image.byte_size += record->data_word * 4;
+        if ((record->address + record->data_word * 4) > s_image.end_address)
+        {
+            s_image.end_address = record->address + record->data_word * 4;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+        Account_update_stage(&s_update_statistics.program_cycles);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Start an update: clear its statistics, the staged image, the manifest and the
+ *        verification, nothing is erased
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_start(void)
+{
+    uint32_t i = 0; /*i is used for traversaling the loop*/
+
+    /*Start the statistics of this update*/
+    s_update_statistics.erase_cycles = 0;
+    s_update_statistics.parse_cycles = 0;
+    s_update_statistics.program_cycles = 0;
+    s_update_statistics.idle_cycles = 0;
+    s_update_statistics.overlap_cycles = 0;
+    s_update_statistics.background_sectors = 0;
+    s_update_statistics.transfer_cycles = 0;
+    s_update_statistics.commit_cycles = 0;
+    s_update_statistics.staged = 0;
+    s_update_statistics.verify_cycles = 0;
+    s_update_statistics.rejected_lines = 0;
+    s_background_erase_active = 0;
+    Driver_UART0_reset_rx_statistics();
+    Event_get_statistics(&s_sleep_start);
+    s_stage_start = Driver_SysTick_get_ticks64();
+    s_update_start = s_stage_start;
+
+    /*No record received yet, the image is received in RAM*/
+    s_image.start_address = 0;
+    s_image.load_address = 0;
+    s_image.end_address = 0;
+    s_image.byte_size = 0;
+    s_image.data_records = 0;
+    s_image.program_sector = 0;
+    s_image.staging = 1;
+
+    /*Start with an empty staged image*/
+    s_staging.base_address = 0;
+    s_staging.end_address = 0;
+    s_staging.header_words = 0;
+    for (i = 0; i < (STAGING_BUFFER_SIZE / 4u); i++)
+    {
+        s_staging.image[i] = FLASH_DELETED_VALUE;
+    }
+    for (i = 0; i < (STAGING_BUFFER_SIZE / FLASH_SECTOR_SIZE); i++)
+    {
+        s_staging.sector_address[i] = 0;
+    }
+
+    /*No manifest received yet*/
+    s_manifest_valid = 0;
+    s_image_complete = 0;
+    s_flash_written = 0;
+
+    /*Nothing verified yet, a longword is checked against the data kept for its sector*/
+    Verify_reset(Get_staged_longword);
+
+    /*A finished background erase sector launches the next one. The tick polls it as well, a missed
+     *completion costs one tick at most*/
+    Event_register(EVENT_FLASH_DONE, Account_background_erase);
+    Event_register(EVENT_TICK, Account_background_erase);
+
+    return;
+}
+
+/**
+ * @brief Process a received S-record line
+ *
+ * @param record: Parsed S-record line
+ * @param line_error: 1 if the line failed its format or checksum check, 0 if not
+ * @param paced: 1 if the host waits for the acknowledge of each line (#PACE 1), 0 if not
+ *
+ * @return UPDATE_CONTINUE while the update goes on, the boot_result_t of its end otherwise
+ */
+uint32_t Update_record(srec_line *record, uint8_t line_error, uint8_t paced)
+{
+    uint32_t ret_val = UPDATE_CONTINUE;          /*This variable stores the function return value*/
+    uart0_rx_statistic_info rx_statistics = {0}; /*This struct stores the UART0 receive statistics*/
+
+    /*A count record must match the data records received before it, a lost line fails the update*/
+    if ((0u == line_error) && ((S5 == record->type) || (S6 == record->type)) &&
+        (record->address != s_image.data_records))
+    {
+        line_error = 1;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    /*A line dropped on a full receive queue leaves a hole without a count record: the update fails
+     *at its termination record. A multi-drop host finds the hole and sends its records again*/
+    if ((0u == line_error) && ((S9 == record->type) || (S8 == record->type) || (S7 == record->type)) &&
+        (0u == BOOT_NODE_ADDRESS))
+    {
+        Driver_UART0_get_rx_statistics(&rx_statistics);
+        line_error = (0u != rx_statistics.dropped_bytes) ? 1u : 0u;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+    Account_update_stage(&s_update_statistics.parse_cycles);
+
+    /*If srec record is good*/
+    if (0u == line_error)
+    {
+        /*If record is header*/
+        if (S0 == record->type)
+        {
+            ret_val = Receive_header_record(record, paced);
+        }
+        /*If record is a termination record*/
+        else if ((S9 == record->type) || (S8 == record->type) || (S7 == record->type))
+        {
+            ret_val = Receive_termination_record();
+        }
+        /*If record is a count record, checked with the line*/
+        else if ((S5 == record->type) || (S6 == record->type))
+        {
+            /*Do nothing*/
+        }
+        /*If record is data record and has address greater or equal to base app address*/
+        else if (record->address >= BASE_APP_ADDRESS)
+        {
+            ret_val = Receive_data_record(record, paced);
+        }
+        /*If record address is smaller than base App address*/
+        else
+        {
+            /*Return error value*/
+            ret_val = BOOT_RESULT_BAD_ADDRESS;
+        }
+    }
+    /*On a multi-drop line the host retransmits a bad line later, the update goes on*/
+    else if (0u != BOOT_NODE_ADDRESS)
+    {
+        s_update_statistics.rejected_lines++;
+    }
+    /*If the received srec line is error*/
+    else
+    {
+        /*Erase all written memory of new App, a staged image has not touched flash*/
+        if (0u == s_image.staging)
+        {
+            Update_wait_background_erase(FLASH_DELETED_VALUE);
+            Erase_Multi_Sector(s_image.load_address & ~(FLASH_SECTOR_SIZE - 1u),
+                               Get_App_size_sector(s_image.load_address, s_image.end_address));
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+        Account_update_stage(&s_update_statistics.erase_cycles);
+
+        ret_val = BOOT_RESULT_BAD_LINE;
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief End a multi-drop update once the host has retransmitted the records this node missed
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if the App has been marked valid, 0 if not
+ */
+uint8_t Update_commit(void)
+{
+    uint8_t ret_val = 0; /*This variable stores the function return value*/
+
+    /*The retransmitted records have been verified as they were programmed, check the CRC again*/
+    if ((1u == Check_received_image(s_image.load_address, s_image.end_address)) &&
+        (1u == Program_LongWord(APP_SIZE_LOCATION, Get_App_size_sector(s_image.load_address, s_image.end_address))) &&
+        (1u == Program_LongWord(APP_UPDATED_FLAG_LOCATION, APP_UPDATE_SUCCESS)))
+    {
+        Account_update_stage(&s_update_statistics.program_cycles);
+
+        ret_val = 1;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Add the time since the last stage to the line processing of the update
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_account_line(void)
+{
+    Account_update_stage(&s_update_statistics.parse_cycles);
+
+    return;
+}
+
+/**
+ * @brief Verify the completed sectors while no line is received, sleep once nothing is left
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_idle(void)
+{
+    Account_update_stage(&s_update_statistics.idle_cycles);
+
+    /*Verify the completed sectors meanwhile, sleep once nothing is left to verify until a line,
+     *a flash command or a tick wakes the core*/
+    if (0u == Verify_step(VERIFY_WORDS_PER_STEP))
+    {
+        Account_update_stage(&s_update_statistics.verify_cycles);
+        Event_wait();
+        Account_update_stage(&s_update_statistics.idle_cycles);
+    }
+    else
+    {
+        Account_update_stage(&s_update_statistics.verify_cycles);
+    }
+
+    return;
+}
+
+/**
+ * @brief End an update: wait for the flash work left and complete its statistics
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_finish(void)
+{
+    event_statistic_info sleep_end = {0}; /*This struct stores the sleep statistics at the update end*/
+
+    /*The handlers use the state of this update*/
+    Event_register(EVENT_FLASH_DONE, 0);
+    Event_register(EVENT_TICK, 0);
+
+    /*No flash command left running when the update ends*/
+    Update_wait_background_erase(FLASH_DELETED_VALUE);
+
+    s_update_statistics.total_cycles = Driver_SysTick_get_ticks64() - s_update_start;
+    Event_get_statistics(&sleep_end);
+    s_update_statistics.sleep_cycles = sleep_end.sleep_cycles - s_sleep_start.sleep_cycles;
+    s_update_statistics.sleep_count = sleep_end.sleep_count - s_sleep_start.sleep_count;
+
+    /*No termination record: the whole update was transfer*/
+    if (0u == s_update_statistics.transfer_cycles)
+    {
+        s_update_statistics.transfer_cycles = s_update_statistics.total_cycles;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+    s_update_statistics.commit_cycles = s_update_statistics.total_cycles - s_update_statistics.transfer_cycles;
+    s_update_statistics.programmed_bytes = s_image.byte_size;
+
+    return;
+}
+
+/**
+ * @brief Check if the termination record of a multi-drop update has been received
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if #COMMIT can end the update, 0 if not
+ */
+uint8_t Update_is_image_complete(void)
+{
+    return s_image_complete;
+}
+
+/**
+ * @brief Check if the update has erased the old App
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if a failed update no longer leaves the old App in place, 0 if not
+ */
+uint8_t Update_is_flash_written(void)
+{
+    return s_flash_written;
+}
+
+/**
+ * @brief Wait until the background erase has passed an address
+ *
+ * @param address: Address that must be erased, FLASH_DELETED_VALUE for the whole erase
+ *
+ * @return: This function return nothing
+ */
+void Update_wait_background_erase(uint32_t address)
+{
+    uint64_t wait_start = Driver_SysTick_get_ticks64(); /*This variable stores the start of the wait*/
+
+    Flash_Background_Erase_wait(address);
+    s_background_erase_blocked += Driver_SysTick_get_ticks64() - wait_start;
+
+    Account_background_erase();
+
+    return;
+}
+
+/**
+ * @brief Check if a valid application is available in flash
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if the application is valid, 0 if not
+ */
+uint8_t Update_is_app_valid(void)
+{
+    uint8_t ret_val = 0; /*This variable stores the function return value*/
+
+    /*The App is valid if it has a start address and its update has finished*/
+    if ((FLASH_DELETED_VALUE != Read_FlashAddress(APP_START_ADDRESS_LOCATION)) &&
+        (APP_UPDATE_SUCCESS == Read_FlashAddress(APP_UPDATED_FLAG_LOCATION)))
+    {
+        ret_val = 1;
+    }
+    else
+    {
+        ret_val = 0;
+    }
+
+    /*An App with a manifest must start at its entry, its CRC was checked when it was written*/
+    if ((1u == ret_val) && (APP_MANIFEST_MAGIC == Read_FlashAddress(APP_HEADER_LOCATION)) &&
+        (Read_FlashAddress(APP_HEADER_LOCATION + offsetof(app_manifest, entry_address)) !=
+         Read_FlashAddress(APP_START_ADDRESS_LOCATION)))
+    {
+        ret_val = 0;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Erase failed update application code in flash
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_erase_failed_app(void)
+{
+    uint32_t i = 0; /*i is used for traversaling the loop*/
+
+    while (Read_FlashAddress(BASE_APP_ADDRESS + (i * FLASH_SECTOR_SIZE)) != FLASH_DELETED_VALUE)
+    {
+        i++;
+    }
+
+    /*Erase failed application code*/
+    Erase_Multi_Sector(APP_START_ADDRESS_LOCATION, i + 1);
+
+    return;
+}
+
+/**
+ * @brief Print the statistics of the last update as one key=value line
+ *
+ * @param core_clock: Core clock in Hz, converts the cycles to ms
+ *
+ * @return: This function return nothing
+ */
+void Update_print_statistics(uint32_t core_clock)
+{
+    uart0_rx_statistic_info rx_statistics = {0}; /*This struct stores the UART0 receive statistics*/
+    uint32_t time_ms = 0;                        /*This variable stores the update time in ms*/
+    uint32_t wire_rate = 0;                      /*This variable stores the received bytes per second*/
+    uint32_t idle_percent = 0;                   /*This variable stores the share of the update spent idle*/
+    uint32_t sleep_percent = 0;                  /*This variable stores the share of the update spent sleeping*/
+
+    Driver_UART0_get_rx_statistics(&rx_statistics);
+
+    /*Divide the total first, the cycle counters are too large to be multiplied by 100*/
+    if (s_update_statistics.total_cycles >= 100u)
+    {
+        idle_percent = (uint32_t)(s_update_statistics.idle_cycles / (s_update_statistics.total_cycles / 100u));
+        sleep_percent = (uint32_t)(s_update_statistics.sleep_cycles / (s_update_statistics.total_cycles / 100u));
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    /*Convert the cycles to ms with the core clock reported to the App*/
+    if (core_clock >= 1000u)
+    {
+        time_ms = (uint32_t)(s_update_statistics.total_cycles / (core_clock / 1000u));
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    if (0u != time_ms)
+    {
+        wire_rate = (rx_statistics.received_bytes / time_ms) * 1000u +
+                    ((rx_statistics.received_bytes % time_ms) * 1000u) / time_ms;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    Driver_UART0_send_string("\nSTAT bytes=");
+    Driver_UART0_send_number(s_update_statistics.programmed_bytes);
+    Driver_UART0_send_string(" wire_bytes=");
+    Driver_UART0_send_number(rx_statistics.received_bytes);
+    Driver_UART0_send_string(" time_ms=");
+    Driver_UART0_send_number(time_ms);
+    Driver_UART0_send_string(" wire_Bps=");
+    Driver_UART0_send_number(wire_rate);
+    Driver_UART0_send_string(" total=");
+    Driver_UART0_send_number64(s_update_statistics.total_cycles);
+    Driver_UART0_send_string(" erase=");
+    Driver_UART0_send_number64(s_update_statistics.erase_cycles);
+    Driver_UART0_send_string(" parse=");
+    Driver_UART0_send_number64(s_update_statistics.parse_cycles);
+    Driver_UART0_send_string(" program=");
+    Driver_UART0_send_number64(s_update_statistics.program_cycles);
+    Driver_UART0_send_string(" idle=");
+    Driver_UART0_send_number64(s_update_statistics.idle_cycles);
+    Driver_UART0_send_string(" staged=");
+    Driver_UART0_send_number(s_update_statistics.staged);
+    Driver_UART0_send_string(" transfer=");
+    Driver_UART0_send_number64(s_update_statistics.transfer_cycles);
+    Driver_UART0_send_string(" commit=");
+    Driver_UART0_send_number64(s_update_statistics.commit_cycles);
+    Driver_UART0_send_string(" verify=");
+    Driver_UART0_send_number64(s_update_statistics.verify_cycles);
+    Driver_UART0_send_string(" rejected=");
+    Driver_UART0_send_number(s_update_statistics.rejected_lines);
+    Driver_UART0_send_string(" sleep=");
+    Driver_UART0_send_number64(s_update_statistics.sleep_cycles);
+    Driver_UART0_send_string(" wakeups=");
+    Driver_UART0_send_number(s_update_statistics.sleep_count);
+    Driver_UART0_send_string(" idle_pct=");
+    Driver_UART0_send_number(idle_percent);
+    Driver_UART0_send_string(" sleep_pct=");
+    Driver_UART0_send_number(sleep_percent);
+    Driver_UART0_send_string(" bg_sectors=");
+    Driver_UART0_send_number(s_update_statistics.background_sectors);
+    Driver_UART0_send_string(" bg_overlap=");
+    Driver_UART0_send_number64(s_update_statistics.overlap_cycles);
+    Driver_UART0_send_string(" peak_queue=");
+    Driver_UART0_send_number(rx_statistics.peak_queue_occupancy);
+    Driver_UART0_send_string(" dropped=");
+    Driver_UART0_send_number(rx_statistics.dropped_bytes);
+    Driver_UART0_send_string(" core_hz=");
+    Driver_UART0_send_number(core_clock);
+    Driver_UART0_send_string(" baud=");
+    Driver_UART0_send_number(Driver_UART0_get_baud_rate());
+    Driver_UART0_send_string(" stack=");
+    Driver_UART0_send_number(Driver_Stack_get_used());
+    Driver_UART0_send_string(" stack_size=");
+    Driver_UART0_send_number(Driver_Stack_get_size());
+
+    return;
+}
+
+/**
+ * @brief Send the result of the update on this node
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Update_print_status(void)
+{
+    Driver_UART0_send_string("\nSTATUS node=");
+    Driver_UART0_send_number(BOOT_NODE_ADDRESS);
+    Driver_UART0_send_string(" complete=");
+    Driver_UART0_send_number(s_image_complete);
+    Driver_UART0_send_string(" rejected=");
+    Driver_UART0_send_number(s_update_statistics.rejected_lines);
+    Verify_print_map();
+
+    return;
+}
+/*EOF*/
@@ -0,0 +1,255 @@
+/**
+ * @file  : Verify.c
+ * @author: Nguyen The Anh.
+ * @brief : Definition of function using in file Verify.c
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include "../Includes/Update/Verify.h"
+#include "../Includes/Driver/Driver_UART0.h"
+#include "../Includes/HAL/FLASH.h"
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*Verification of the last update*/
+static verify_state_info s_verify;
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/**
+ * @brief Restart the verification with nothing verified
+ *
+ * @param expected: Function giving the value a longword of the image must hold
+ *
+ * @return: This function return nothing
+ */
+void Verify_reset(verify_expected_t expected)
+{
+    uint32_t i = 0; /*i is used for traversaling the loop*/
+
+    s_verify.first_address = 0;
+    s_verify.next_address = 0;
+    s_verify.ready_address = 0;
+    s_verify.failed_sectors = 0;
+    s_verify.crc_failed = 0;
+    for (i = 0; i < (FLASH_SECTOR_COUNT / 32u); i++)
+    {
+        s_verify.failed_map[i] = 0;
+    }
+    s_verify.expected = expected;
+
+    return;
+}
+
+/**
+ * @brief Mark a programmed range as ready for verification
+ *
+ * @param start_address: Address of the first programmed byte
+ * @param end_address: Address after the last programmed byte
+ *
+ * @return: This function return nothing
+ */
+void Verify_ready(uint32_t start_address, uint32_t end_address)
+{
+    /*Only flash can be verified, the map has one bit per flash sector*/
+    if (end_address > (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE))
+    {
+        end_address = FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    /*The first range fixes the start of the verification*/
+    if ((0u == s_verify.first_address) && (end_address > start_address))
+    {
+        s_verify.first_address = start_address & ~3u;
+        s_verify.next_address = s_verify.first_address;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    if ((0u != s_verify.first_address) && (end_address > s_verify.ready_address))
+    {
+        s_verify.ready_address = end_address;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/**
+ * @brief Verify the next longwords of the ready range with a user margin read
+ *
+ * @param word_count: Maximum number of longwords to verify
+ *
+ * @return 1 if longwords of the ready range are left to verify, 0 if not
+ */
+uint8_t Verify_step(uint32_t word_count)
+{
+    while ((0u != word_count) && (s_verify.next_address < s_verify.ready_address))
+    {
+        if (0u == Program_Check_LongWord(s_verify.next_address, s_verify.expected(s_verify.next_address),
+                                         FLASH_MARGIN_USER))
+        {
+            Verify_mark_failed(s_verify.next_address);
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+
+        s_verify.next_address += 4u;
+        word_count--;
+    }
+
+    return (s_verify.next_address < s_verify.ready_address) ? 1u : 0u;
+}
+
+/**
+ * @brief Verify the ready range up to an address
+ *
+ * @param end_address: Address after the last longword to verify
+ *
+ * @return: This function return nothing
+ */
+void Verify_until(uint32_t end_address)
+{
+    while ((s_verify.next_address < end_address) && (0u != Verify_step(VERIFY_WORDS_PER_STEP)))
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/**
+ * @brief Mark the sector of a longword as failed in the verification map
+ *
+ * @param address: Address of the failed longword
+ *
+ * @return: This function return nothing
+ */
+void Verify_mark_failed(uint32_t address)
+{
+    uint32_t sector = address / FLASH_SECTOR_SIZE; /*This variable stores the sector index of the longword*/
+
+    if ((sector < FLASH_SECTOR_COUNT) && (0u == (s_verify.failed_map[sector / 32u] & (1u << (sector % 32u)))))
+    {
+        s_verify.failed_map[sector / 32u] |= 1u << (sector % 32u);
+        s_verify.failed_sectors++;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return;
+}
+
+/**
+ * @brief Verify the longwords of a programmed record with a user margin read of its own data
+ *
+ * @param record: Parsed data record
+ *
+ * @return: This function return nothing
+ */
+void Verify_record(srec_line *record)
+{
+    uint32_t i = 0;        /*i is used for traversaling the loop*/
+    uint32_t expected = 0; /*This variable stores the value the longword must hold*/
+
+    for (i = 0; i < record->data_word; i++)
+    {
+        expected = (uint32_t)record->data[i * 4] | ((uint32_t)record->data[i * 4 + 1] << 8) |
+                   ((uint32_t)record->data[i * 4 + 2] << 16) | ((uint32_t)record->data[i * 4 + 3] << 24);
+
+        if (0u == Program_Check_LongWord(record->address + i * 4, expected, FLASH_MARGIN_USER))
+        {
+            Verify_mark_failed(record->address + i * 4);
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Set the result of the CRC check of the image against its manifest
+ *
+ * @param failed: 1 if the image does not match the CRC, 0 if it does
+ *
+ * @return: This function return nothing
+ */
+void Verify_set_crc_failed(uint8_t failed)
+{
+    s_verify.crc_failed = failed;
+
+    return;
+}
+
+/**
+ * @brief Check the result of the verification
+ *
+ * @param: This function has no parameter
+ *
+ * @return 1 if no sector and no CRC check failed, 0 if not
+ */
+uint8_t Verify_is_passed(void)
+{
+    return ((0u == s_verify.failed_sectors) && (0u == s_verify.crc_failed)) ? 1u : 0u;
+}
+
+/**
+ * @brief Print the per-sector verification map of the last update
+ *
+ * @param: This function has no parameter
+ *
+ * @return: This function return nothing
+ */
+void Verify_print_map(void)
+{
+    uint32_t sector = 0;                  /*sector is used for traversaling the loop*/
+    uint8_t sector_state[2] = {'.', '\0'}; /*Map character of a sector: '.' passed, 'X' failed*/
+
+    Driver_UART0_send_string("\nVERIFY first_sector=");
+    Driver_UART0_send_number(s_verify.first_address / FLASH_SECTOR_SIZE);
+    Driver_UART0_send_string(" sectors=");
+    Driver_UART0_send_number((s_verify.next_address + FLASH_SECTOR_SIZE - 1u) / FLASH_SECTOR_SIZE -
+                             s_verify.first_address / FLASH_SECTOR_SIZE);
+    Driver_UART0_send_string(" failed=");
+    Driver_UART0_send_number(s_verify.failed_sectors + s_verify.crc_failed);
+    Driver_UART0_send_string(" map=");
+
+    for (sector = s_verify.first_address / FLASH_SECTOR_SIZE;
+         (0u != s_verify.first_address) && (sector < FLASH_SECTOR_COUNT) &&
+         (sector * FLASH_SECTOR_SIZE < s_verify.next_address);
+         sector++)
+    {
+        sector_state[0] = (0u != (s_verify.failed_map[sector / 32u] & (1u << (sector % 32u)))) ? 'X' : '.';
+        Driver_UART0_send_string(sector_state);
+    }
+
+    return;
+}
+/*EOF*/
@@ -17,148 +17,208 @@
 #include "../Includes/Driver/Driver_SIM.h"
 #include "../Includes/Driver/Driver_UART0.h"
 #include "../Includes/Driver/Driver_core.h"
+#include "../Includes/Queue/Queque.h"
 #include "../Includes/Srec/Srec.h"
 #include "../Includes/HAL/FLASH.h"
+#include "../Includes/Trace/Trace.h"
+#include "../Includes/Event/Event.h"
+#include "../Includes/Update/Update.h"
+#include "../Includes/Update/Verify.h"
+#include "../Includes/Command/Command.h"
+#include "Boot_info.h"
+#include "App_manifest.h"
+#include "Flash_layout.h"
+#include <stddef.h>
 #include <stdlib.h>
 
 /*******************************************************************************
  * Macro
  ******************************************************************************/
 
-/*Base address of application code*/
-#define BASE_APP_ADDRESS (0xA000u)
+/*\Longest App header printed in boot mode*/
+#define APP_HEADER_MAX_LENGTH (49u)
 
-/*Flash location that stores the start address of application code*/
-#define APP_START_ADDRESS_LOCATION (0x9C00u)
-
-/*Flash location that stores the size of application in sector*/
-#define APP_SIZE_LOCATION (APP_START_ADDRESS_LOCATION + 4u)
-
-/*Flash location stores the flag that indicates firmware updated successfully*/
-#define APP_UPDATED_FLAG_LOCATION (APP_SIZE_LOCATION + 4u)
-
-/*Flash location that stores header of the file*/
-#define APP_HEADER_LOCATION (APP_UPDATED_FLAG_LOCATION + 4u)
-
-/*\Indicating the app has been updated successfully*/
-#define APP_UPDATE_SUCCESS (1u)
+/*\Core clock profile: MCG_PROFILE_PEE (48 MHz from the 8 MHz crystal) or MCG_PROFILE_FEI*/
+#define BOOT_CLOCK_PROFILE (MCG_PROFILE_PEE)
 
 /*\Red LED port and pin macro*/
 #define RED_LED_PORT (PORT_E)
 #define RED_LED_PIN (29u)
 
+/*\Green LED port and pin macro*/
+#define GREEN_LED_PORT (PORT_D)
+#define GREEN_LED_PIN (5u)
+
+/*\Boot switch port and pin macro*/
+#define BOOT_SWITCH_PORT (PORT_C)
+#define BOOT_SWITCH_PIN (12u)
+
+/*\Peripherals initialized by the bootloader, de-initialized before jumping to the App*/
+#define HANDOFF_SWITCH (1u << 0)
+#define HANDOFF_UART0 (1u << 1)
+#define HANDOFF_LEDS (1u << 2)
+
 /*******************************************************************************
  * Variable
  ******************************************************************************/
 
+/*Work areas kept off the stack. The line buffer is shared: main uses it for the App header
+ *before Boot_main uses it for the received lines*/
+static uint8_t s_work_line[SREC_LINE_BUFFER_SIZE] __attribute__((aligned(4)));
+static srec_line s_work_record __attribute__((aligned(4)));
+
+/*Names of the Boot_main results in the RESULT line, indexed by boot_result_t*/
+static const char *const s_boot_result_name[BOOT_RESULT_COUNT] = {"bad_line", "success", "bad_address",
+                                                                  "bad_manifest", "verify_failed", "no_app",
+                                                                  "app_erased", "too_large"};
+
+/*This variable stores the HANDOFF_ flags of the initialized peripherals*/
+static uint32_t s_handoff_list = 0;
+
+/*Boot information block passed to the App, placed at BOOT_INFO_ADDRESS by the linker*/
+static boot_info s_boot_info __attribute__((section(".boot_info"), used));
+
+
+
 /*******************************************************************************
  * Static functions prototype
  ******************************************************************************/
 
 /**
- * @brief Erase failed update application code in flash
+ * @brief Print the UART0 line-quality counters
  *
  * @param: This function has no parameter
  *
  * @return: This function return nothing
  */
-static void Erase_failed_app(void);
+static void Print_line_quality(void);
 
 /**
- * @brief Erase old application code in flash
+ * @brief Return every peripheral in the hand-off list to its reset state
  *
  * @param: This function has no parameter
  *
  * @return: This function return nothing
  */
-static void Erase_Old_Application(void);
+static void Deinit_peripherals(void);
 
 /**
- * @brief Get App size in sector
+ * @brief Send the machine readable result of the boot, name and code
  *
- * @param App_size_byte: App size in byte
+ * @param result is the boot_result_t of Boot_main or of App mode
  *
- * @return App size in sector
+ * @return: This function return nothing
  */
-static uint32_t Get_App_size_sector(uint32_t App_size_byte);
+static void Print_result(uint32_t result);
 
 /*******************************************************************************
  * Functions
  ******************************************************************************/
 
 /**
- * @brief Erase failed update application code in flash
+ * @brief Print the UART0 line-quality counters
  */
-static void Erase_failed_app(void)
+static void Print_line_quality(void)
 {
-    uint32_t i = 0; /*i is used for traversaling the loop*/
-
-    while (Read_FlashAddress(BASE_APP_ADDRESS + (i * 1024)) != FLASH_DELETED_VALUE)
-    {
-        i++;
-    }
-
-    /*Erase failed application code*/
-    Erase_Multi_Sector(APP_START_ADDRESS_LOCATION, i + 1);
+    uart0_error_counter_info counters = {0}; /*This struct stores the UART0 line-quality counters*/
+
+    /*Get the counters*/
+    Driver_UART0_get_error_counters(&counters);
+
+    Driver_UART0_send_string("\nLine   : OR ");
+    Driver_UART0_send_number(counters.overrun_count);
+    Driver_UART0_send_string(", NF ");
+    Driver_UART0_send_number(counters.noise_count);
+    Driver_UART0_send_string(", FE ");
+    Driver_UART0_send_number(counters.framing_count);
+    Driver_UART0_send_string(", PF ");
+    Driver_UART0_send_number(counters.parity_count);
+    Driver_UART0_send_string(", baud ");
+    Driver_UART0_send_number(Driver_UART0_get_baud_rate());
 
     return;
 }
 
 /**
- * @brief Erase old application code in flash
+ * @brief Return every peripheral in the hand-off list to its reset state
  */
-static void Erase_Old_Application(void)
+static void Deinit_peripherals(void)
 {
-    uint32_t app_start_addr = 0;  /*This variable stores old application start address*/
-    uint32_t app_size_sector = 0; /*This variable stores old application size in sector*/
-
-    /*Get Application start address*/
-    app_start_addr = Read_FlashAddress(APP_START_ADDRESS_LOCATION);
+    /*SIM_SCGC5 reset state: all port clocks are gated off*/
+    SCGC5_config_info port_gate_reset = {
+        .PORTA_clock = DISABLED,
+        .PORTB_clock = DISABLED,
+        .PORTC_clock = DISABLED,
+        .PORTD_clock = DISABLED,
+        .PORTE_clock = DISABLED,
+    };
 
-    /*Get Application size*/
-    app_size_sector = Read_FlashAddress(APP_SIZE_LOCATION);
+    /*SIM_SOPT2 reset state: UART0 clock is disabled, FLL clock is selected*/
+    SOPT2_config_info SOPT2_reset = {
+        .uart0_clock_source = CLOCK_DISABLED,
+        .MCGPLLCLK_MCGFLLCLK_option = MCGFLLCLK_CLOCK_SELECTED,
+    };
 
-    /*Disable all current interrupts*/
-    Driver_Disable_current_IRQs();
+    /*UART0 goes first, it waits for the last character to be sent*/
+    if (0u != (s_handoff_list & HANDOFF_UART0))
+    {
+        /*Report the baud rate in use, it may have been stepped down*/
+        s_boot_info.baud_rate = Driver_UART0_get_baud_rate();
 
-    /*Erase Application information sector*/
-    Erase_Sector(APP_START_ADDRESS_LOCATION);
+        Driver_UART0_deinit();
+        Driver_SIM_SOPT2_init(&SOPT2_reset);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
 
-    /*Check if there is no App*/
-    if ((app_start_addr == FLASH_DELETED_VALUE) && (app_size_sector == FLASH_DELETED_VALUE))
+    if (0u != (s_handoff_list & HANDOFF_LEDS))
+    {
+        Driver_GPIO_deinit_pin(GREEN_LED_PORT, GREEN_LED_PIN);
+        Driver_GPIO_deinit_pin(RED_LED_PORT, RED_LED_PIN);
+    }
+    else
     {
         /*Do nothing*/
     }
+
+    if (0u != (s_handoff_list & HANDOFF_SWITCH))
+    {
+        Driver_GPIO_deinit_pin(BOOT_SWITCH_PORT, BOOT_SWITCH_PIN);
+    }
     else
     {
-        /*Erase old App*/
-        Erase_Multi_Sector(app_start_addr, app_size_sector);
+        /*Do nothing*/
     }
-    /*Enable all current interrupted interrupts*/
-    Driver_Enable_current_IRQs();
+
+    /*Gate off the port clocks once no pin is in use*/
+    Driver_SIM_SCGC5_init_clock(&port_gate_reset);
+
+    s_handoff_list = 0;
 
     return;
 }
 
 /**
- * @brief Get App size in sector
- *
- * @param App_size_byte: App size in byte
- *
- * @return App size in sector
+ * @brief Send the machine readable result of the boot
  */
-static uint32_t Get_App_size_sector(uint32_t App_size_byte)
+static void Print_result(uint32_t result)
 {
-    if (App_size_byte % 1024 == 0)
+    /*Check input*/
+    if (result < BOOT_RESULT_COUNT)
     {
-        App_size_byte = App_size_byte / 1024 + 1u;
+        Driver_UART0_send_string("\nRESULT status=");
+        Driver_UART0_send_string((uint8_t *)s_boot_result_name[result]);
+        Driver_UART0_send_string(" code=");
+        Driver_UART0_send_number(result);
     }
     else
     {
-        App_size_byte = (App_size_byte / 1024) + 2u;
+        /*Do nothing*/
     }
 
-    return App_size_byte;
+    return;
 }
 
 /**
@@ -180,11 +240,26 @@ void jump_to_application(uint32_t vector_start_addr)
     /*Get initial value of stack pointer*/
     s_new_StackPointer = *(uint32_t *)vector_start_addr;
 
+    /*The record stays in RAM for a debugger, the App does not initialize the ring*/
+    Trace_record(TRACE_EVENT_JUMP, vector_start_addr);
+
     /*Disable all current interrupts*/
     Driver_Disable_current_IRQs();
 
-    /*Off set vector table*/
-    Driver_Set_VectorTable_offset(BASE_APP_ADDRESS);
+    /*Stop the timestamp counter, its interrupt would go to the App vector table*/
+    Driver_SysTick_stop();
+
+    /*Return the peripherals to their reset state, the MCG keeps running as reported in boot info*/
+    Deinit_peripherals();
+
+    /*No interrupt stays enabled or pending in NVIC*/
+    Driver_NVIC_clear_all_IRQs();
+
+    /*Validate the boot information block*/
+    s_boot_info.magic = BOOT_INFO_MAGIC;
+
+    /*Off set vector table to the App vector table*/
+    Driver_Set_VectorTable_offset(vector_start_addr);
 
     /*Set initial stack pointer value*/
     Driver_Set_MSP(s_new_StackPointer);
@@ -193,6 +268,9 @@ void jump_to_application(uint32_t vector_start_addr)
     /*Get new application entry*/
     s_entry = (void (*)(void))s_new_Entry;
 
+    /*Nothing can be pending at this point, the App starts with interrupts enabled as after reset*/
+    Driver_Enable_current_IRQs();
+
     /*Jump to new application*/
     s_entry();
 
@@ -200,130 +278,110 @@ void jump_to_application(uint32_t vector_start_addr)
 }
 
 /**
- * @brief Boot main
+ * @brief Boot main: host command lines go to Command.c, S-record lines to Update.c
  *
  * @param: This function has no param
  *
- * @return 1 if success, 0 if fail
+ * @return BOOT_RESULT_SUCCESS (1) if success, the boot_result_t of the failure otherwise
  */
 uint32_t Boot_main(void)
 {
-    uint32_t ret_val = 0;              /*This variable stores the function return value*/
-    uint32_t i = 0;                    /*i is used for traversaling loop*/
-    uint8_t queue_flag = 0;            /*This flag indicates if a queue element has received a full srec line*/
-    uint8_t stop_flag = 0;             /*This flag indicates if the function need to stop*/
-    uint8_t received_line[515] = {0};  /*Buffer for srec line*/
-    srec_line record = {0};            /*This struct stores information of a parsed srec line*/
-    uint32_t newApp_start_address = 0; /*This variable stores start address of new Application*/
-    uint32_t newApp_sector_size = 0;   /*This variable stores size of new Application in byte*/
-    uint32_t newApp_byte_size = 0;     /*This variable stores size of new Application in sector*/
-
-    /*Erase old application*/
-    Erase_Old_Application();
+    uint32_t ret_val = UPDATE_CONTINUE;   /*This variable stores the function return value*/
+    uint8_t queue_flag = 0;               /*This flag indicates if a queue element has received a full srec line*/
+    uint8_t line_error = 0;               /*This flag indicates if the srec line failed its check*/
+    uint8_t *received_line = s_work_line; /*Buffer for srec line*/
+    srec_line *record = &s_work_record;   /*This struct stores information of a parsed srec line*/
+    uint32_t step_down_baud = 0;          /*This variable stores the baud rate of a pending step-down*/
+
+    /*The old App is kept until an image has been received*/
+    Update_start();
+    Driver_UART0_send_string("\nStatus: Waiting for receiving Srec file");
 
     /*Turn on the Red LED*/
     Driver_GPIO_set_pin_State(RED_LED_PORT, RED_LED_PIN, LOW_STATE);
 
-    while (1)
+    while (UPDATE_CONTINUE == ret_val)
     {
+        /*Run the handlers of the events posted since the last pass, a received line is read below*/
+        Event_dispatch();
+
+        /*A step-down requested by the line errors is announced at the old baud rate, a line lost
+         *across the switch fails as any bad line*/
+        step_down_baud = Driver_UART0_get_step_down_baud();
+        if (0u != step_down_baud)
+        {
+            Driver_UART0_send_string("\nBAUD ");
+            Driver_UART0_send_number(step_down_baud);
+            Driver_UART0_send_string("\n");
+            Driver_UART0_step_down();
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+
         /*Get queue flag*/
         queue_flag = Driver_UART0_check_first_buffer();
 
-        /*If a queue element is ready and no stop sign*/
-        if (1 == queue_flag && stop_flag == 0)
+        /*If a queue element is ready*/
+        if (1 == queue_flag)
         {
             /*Get srec line from queue*/
             Driver_UART0_receive_string(received_line);
-            /*Parse the srec line*/
-            record = parse_Srecord_line(received_line);
-            /*Check srec line*/
-            stop_flag = check_srec_line(&record, received_line);
 
-            /*If srec record is good*/
-            if (0 == stop_flag)
+            /*Answer a host command and wait for the next line*/
+            if (BOOT_COMMAND_PREFIX == received_line[0])
             {
-                /*If record is header*/
-                if (S0 == record.type)
+                ret_val = Command_handle(received_line, &s_boot_info);
+                if (UPDATE_CONTINUE == ret_val)
                 {
-                    /*Write header data to the App header location in flash*/
-                    for (i = 0; i < record.data_word; i++)
-                    {
-                        Driver_Disable_current_IRQs();
-                        Program_LongWord_8B(APP_HEADER_LOCATION + i * 4, &record.data[i * 4]);
-                        Driver_Enable_current_IRQs();
-                    }
+                    Update_account_line();
                 }
-                /*If record is a termination record*/
-                else if (S9 == record.type || S8 == record.type || S7 == record.type)
+                else
                 {
-                    newApp_sector_size = Get_App_size_sector(newApp_byte_size);
-
-                    /*Program App start address and size to App information region*/
-                    Driver_Disable_current_IRQs();
-                    Program_LongWord(APP_SIZE_LOCATION, newApp_sector_size);
-                    Program_LongWord(APP_UPDATED_FLAG_LOCATION, 1u);
-                    Driver_Enable_current_IRQs();
-
-                    ret_val = 1;
-                    break;
+                    /*Do nothing*/
                 }
-                /*If record is data record and has address greater or equal to base app address*/
-                else if (record.address >= BASE_APP_ADDRESS)
+                Driver_UART0_dequeue();
+            }
+            else
+            {
+                /*Parse the srec line*/
+                parse_Srecord_line(received_line, record);
+                /*Check srec line*/
+                line_error = check_srec_line(record, received_line);
+
+                /*Program the record, a failed update leaves its line in the queue*/
+                ret_val = Update_record(record, line_error, Command_get_pace());
+                if (UPDATE_CONTINUE == ret_val)
                 {
-                    /*Get new App start address*/
-                    if (0 == newApp_start_address)
+                    /*Dequeue the queue*/
+                    Driver_UART0_dequeue();
+
+                    /*The host may send one more line*/
+                    if (1u == Command_get_pace())
                     {
-                        newApp_start_address = record.address;
-                        Driver_Disable_current_IRQs();
-                        Program_LongWord(APP_START_ADDRESS_LOCATION, newApp_start_address);
-                        Driver_Enable_current_IRQs();
+                        Driver_UART0_send_data_byte(BOOT_PACE_ACK);
                     }
                     else
                     {
                         /*Do nothing*/
                     }
-
-                    /*Program data record to flash*/
-                    for (i = 0; i < record.data_word; i++)
-                    {
-                        Driver_Disable_current_IRQs();
-                        Program_LongWord_8B(record.address + i * 4, &record.data[i * 4]);
-                        Driver_Enable_current_IRQs();
-                    }
-
-                    newApp_byte_size += record.data_word * 4;
                 }
-                /*If record address is smaller than base App address*/
                 else
                 {
-                    /*Return error value*/
-                    ret_val = 0;
-                    break;
+                    /*Do nothing*/
                 }
             }
-            /*If the received srec line is error*/
-            else
-            {
-                /*Get current size of new Application*/
-                newApp_sector_size = Get_App_size_sector(newApp_byte_size);
-
-                /*Erase all written memory of new App*/
-                Driver_Disable_current_IRQs();
-                Erase_Multi_Sector(BASE_APP_ADDRESS, newApp_sector_size);
-                Driver_Enable_current_IRQs();
-
-                ret_val = 0;
-                break;
-            }
-            /*Dequeue the queue*/
-            Driver_UART0_dequeue();
         }
         else
         {
-            /*Do nothing*/
+            /*No line to process*/
+            Update_idle();
         }
     }
 
+    Update_finish();
+
     return ret_val;
 }
 
@@ -335,11 +393,11 @@ uint32_t Boot_main(void)
 END***************************************************************************/
 int main(void)
 {
-    uint32_t MCGFLLCLK_frequency = 0; /*This variable stores the MCGFLLCLK freuquency*/
+    MCG_clock_frequency_info clock_frequency = {0}; /*This struct stores the frequencies of the clock tree*/
     uint32_t i = 0;                   /*i is used for traversaling loop*/
     uint32_t boot_state = 0;          /*This variable store status of boot*/
+    uint8_t boot_switch = 0;          /*This variable stores the boot switch state (0: pressed)*/
     uint8_t header_byte = 0;          /*This variable stores a byte of data in header*/
-    uint8_t header[50] = {0};         /*This array store header of Application*/
 
     /*SIM_SCGC4 configuration info*/
     SCGC4_config_info SCGC4_config = {
@@ -349,12 +407,32 @@ int main(void)
     /*SIM_SOPT2 configuration info*/
     SOPT2_config_info SOPT2_config = {
         .uart0_clock_source = MCGFLLCLK_HALF_MCGPLLCLK_CLOCK,
-        .MCGPLLCLK_MCGFLLCLK_option = MCGFLLCLK_CLOCK_SELECTED};
+        .MCGPLLCLK_MCGFLLCLK_option = (MCG_PROFILE_PEE == BOOT_CLOCK_PROFILE) ? HALF_MCGPLLCLK_CLOCK_SELECTED
+                                                                             : MCGFLLCLK_CLOCK_SELECTED};
+
+    /*Clock profile configuration info*/
+    MCG_clock_config_info clock_config = {
+        .profile = BOOT_CLOCK_PROFILE,
+        .FLL_config = {
+            .DCO_max_frequency = DCO_FIX_TUNED_MAX_FREQUENCY,
+            .DCO_range = DCO_MID_RANGE,
+        },
+        .crystal_frequency = MCG_CRYSTAL_FREQUENCY,
+        .PLL_divider = 2,     /*8 MHz / 2 = 4 MHz PLL reference*/
+        .PLL_multiplier = 24, /*4 MHz * 24 = 96 MHz MCGPLLCLK*/
+        .core_divider = (MCG_PROFILE_PEE == BOOT_CLOCK_PROFILE) ? 2 : 1, /*48 MHz core clock in both profiles*/
+        .bus_divider = 2,                                                /*24 MHz bus and flash clock*/
+    };
 
-    /*MCG_C4 configuration info*/
-    MCG_C4_config_info MCG_C4_config = {
-        .DCO_max_frequency = DCO_FIX_TUNED_MAX_FREQUENCY,
-        .DCO_range = DCO_MID_RANGE,
+    /*Clock tree out of reset: FEI, DCO low range (640 * 32768 Hz), SIM_CLKDIV1 OUTDIV1 /1 and OUTDIV4 /2*/
+    MCG_clock_config_info reset_clock_config = {
+        .profile = MCG_PROFILE_FEI,
+        .FLL_config = {
+            .DCO_max_frequency = DCO_DEFAULT_RANGE,
+            .DCO_range = DCO_LOW_RANGE,
+        },
+        .core_divider = 1, /*20.97 MHz core clock*/
+        .bus_divider = 2,  /*10.49 MHz bus and flash clock*/
     };
 
     /*UART0 configuration info*/
@@ -372,12 +450,13 @@ int main(void)
         .receiver_state = RECEIVER_ENABLED,
         .transmiter_IRQ = TRANSMIT_IRQ_DISABLED,
         .receiver_IRQ = RECEIVE_IRQ_ENABLED,
+        .error_rate = 0, /*The baud step-down is enabled by the host with #AUTOBAUD, it follows the changes*/
     };
 
     /*Green LED configuration info*/
     GPIO_config_info_t green_LED = {
-        .port_type = PORT_D,
-        .pin = 5,
+        .port_type = GREEN_LED_PORT,
+        .pin = GREEN_LED_PIN,
         .direction = GPIO_OUTPUT,
         .pull_type = PULL_DOWN,
         .initial_state = HIGH_STATE,
@@ -385,8 +464,8 @@ int main(void)
 
     /*Red LED configuration info*/
     GPIO_config_info_t red_LED = {
-        .port_type = PORT_E,
-        .pin = 29,
+        .port_type = RED_LED_PORT,
+        .pin = RED_LED_PIN,
         .direction = GPIO_OUTPUT,
         .initial_state = HIGH_STATE,
         .pull_type = PULL_DOWN,
@@ -395,8 +474,8 @@ int main(void)
     /*Switch 1 configuration*/
     GPIO_config_info_t switch2 =
         {
-            .port_type = PORT_C,
-            .pin = 12,
+            .port_type = BOOT_SWITCH_PORT,
+            .pin = BOOT_SWITCH_PIN,
             .direction = GPIO_INPUT,
             .pull_type = PULL_UP,
             .initial_state = HIGH_STATE,
@@ -411,29 +490,86 @@ int main(void)
         .PORTE_clock = ENABLED,
     };
 
+    /*Paint the unused stack for the high-water check*/
+    Driver_Stack_paint();
+
+    /*Start the timestamp counter*/
+    Driver_SysTick_start();
+    Trace_init();
+    Event_init();
+
+    /*The block is not valid until the jump. The clocks run as out of reset so far, the fast path
+     *hands them over so, and UART0 has not been used*/
+    Driver_MCG_get_clock_frequency(&reset_clock_config, &clock_frequency);
+    s_boot_info.magic = 0;
+    s_boot_info.clock_profile = MCG_PROFILE_FEI;
+    s_boot_info.core_clock = clock_frequency.core_clock;
+    s_boot_info.bus_clock = clock_frequency.bus_clock;
+    s_boot_info.peripheral_clock = clock_frequency.peripheral_clock;
+    s_boot_info.baud_rate = 0;
+
+    /*Only the switch port is needed to select the mode*/
+    Driver_SIM_SCGC5_set_PORTn_clock_gate(switch2.port_type, ENABLED);
+    /*Init Switch 1*/
+    Driver_GPIO_init_pin(&switch2);
+    s_handoff_list |= HANDOFF_SWITCH;
+    /*Get the boot switch state*/
+    boot_switch = Driver_GPIO_read_pin_state(switch2.port_type, switch2.pin);
+
+    Trace_record(TRACE_EVENT_SWITCH_READ, boot_switch);
+
+    /*Fast path: if the Boot button is not pressed and the App is valid, jump without any other init*/
+    if ((1 == boot_switch) && (1 == Update_is_app_valid()))
+    {
+        /*Jump to application to excute*/
+        jump_to_application(Read_FlashAddress(APP_START_ADDRESS_LOCATION));
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
     /*Init SIM_SCGC5*/
     Driver_SIM_SCGC5_init_clock(&port_gate_config);
     /*Init SIM_SCGC4*/
     Driver_SIM_SCGC4_init_clock(&SCGC4_config);
     /*Init SOPT2*/
     Driver_SIM_SOPT2_init(&SOPT2_config);
-    /*Init the MCGFLLCLK clock*/
-    Driver_MCG_Init_MCGFLLCLK(&MCG_C4_config);
+    /*Init the clock tree*/
+    Driver_MCG_Init_clock(&clock_config);
+
+    /*Get the clock frequencies, UART0 baud rate divisor is derived from them*/
+    Driver_MCG_get_clock_frequency(&clock_config, &clock_frequency);
 
-    /*Get the MCGFLLCLK frequency*/
-    MCGFLLCLK_frequency = Driver_MCG_get_MCGFLLCLK_frequency(&MCG_C4_config);
+    s_boot_info.clock_profile = clock_config.profile;
+    s_boot_info.core_clock = clock_frequency.core_clock;
+    s_boot_info.bus_clock = clock_frequency.bus_clock;
+    s_boot_info.peripheral_clock = clock_frequency.peripheral_clock;
+
+    Trace_record(TRACE_EVENT_CLOCK_INIT, clock_frequency.core_clock);
 
     /*Init UART0*/
-    Driver_UART0_init(&UART0_config, MCGFLLCLK_frequency);
+    Driver_UART0_init(&UART0_config, clock_frequency.peripheral_clock);
     /*Init green LED*/
     Driver_GPIO_init_pin(&green_LED);
     /*Init red LED*/
     Driver_GPIO_init_pin(&red_LED);
-    /*Init Switch 1*/
-    Driver_GPIO_init_pin(&switch2);
+    /*Share the line with the other bootloaders of a multi-drop line, silent until addressed*/
+    if (0u != BOOT_NODE_ADDRESS)
+    {
+        Driver_UART0_enable_address_match(BOOT_NODE_ADDRESS, BOOT_BROADCAST_ADDRESS);
+    }
+    else
+    {
+        /*Do nothing*/
+    }
     /*Enable UART0 interrupt handler*/
     Driver_UART0_enable_interrupt_handler();
 
+    s_handoff_list |= HANDOFF_UART0 | HANDOFF_LEDS;
+
+    Trace_record(TRACE_EVENT_UART_INIT, Driver_UART0_get_baud_rate());
+
     Driver_UART0_send_string("\n---------------------------------------------------------------");
     Driver_UART0_send_string("\nProject: MCU MOCK - Custom Bootloader");
     Driver_UART0_send_string("\nAuthor : Nguyen The Anh");
@@ -443,8 +579,10 @@ int main(void)
     Driver_UART0_send_string("\n   + Red led will turn on during boot mode");
     Driver_UART0_send_string("\n---------------------------------------------------------------\n");
 
-    /*If the Boot button is not pressed*/
-    if (Driver_GPIO_read_pin_state(switch2.port_type, switch2.pin) == 1)
+    Trace_record(TRACE_EVENT_BANNER, 0);
+
+    /*If the Boot button is not pressed (the App is not valid, otherwise it has been launched)*/
+    if (1 == boot_switch)
     {
         Driver_UART0_send_string("\n---------------------------------------------------------------");
         Driver_UART0_send_string("\nMode   : App mode");
@@ -455,47 +593,56 @@ int main(void)
             Driver_UART0_send_string("\nStatus : No Application");
             Driver_UART0_send_string("\nMessage: + Enter boot mode then send Srec file to update firmware");
             Driver_UART0_send_string("\n         + To enter boot mode, hold switch 2 then press reset");
+            Print_result(BOOT_RESULT_NO_APP);
             Driver_UART0_send_string("\n---------------------------------------------------------------\n");
         }
         else
         {
-            if (APP_UPDATE_SUCCESS == Read_FlashAddress(APP_UPDATED_FLAG_LOCATION))
-            {
-                /*Get the header in header region*/
-                header_byte = Read_Flash_byte(APP_HEADER_LOCATION);
-                while (0xFFu != header_byte && '.' != header_byte)
-                {
-                    header[i] = header_byte;
-                    i++;
-                    header_byte = Read_Flash_byte(APP_HEADER_LOCATION + i);
-                }
-
-                Driver_UART0_send_string("\nApp    : ");
-                Driver_UART0_send_string(header);
-                Driver_UART0_send_string("\nStatus : Running");
-                Driver_UART0_send_string("\nMessage: To enter boot mode, hold switch 2 then press reset");
-                Driver_UART0_send_string("\n---------------------------------------------------------------\n");
-
-                /*Jump to application to excute*/
-                jump_to_application(Read_FlashAddress(APP_START_ADDRESS_LOCATION));
-            }
-            else
-            {
-                Driver_UART0_send_string("\nStatus : Lastest updated failed");
-                Driver_UART0_send_string("\nMessage: + Enter boot mode then send Srec file to update firmware");
-                Driver_UART0_send_string("\n         + To enter boot mode, hold switch 2 then press reset");
-                Driver_UART0_send_string("\n---------------------------------------------------------------\n");
+            Driver_UART0_send_string("\nStatus : Failed to update, written memory is erased");
+            Driver_UART0_send_string("\nMessage: + Enter boot mode then send Srec file to update firmware");
+            Driver_UART0_send_string("\n         + To enter boot mode, hold switch 2 then press reset");
 
-                /*Erase failed App code*/
-                Erase_failed_app();
-            }
+            /*Erase failed App code*/
+            Update_erase_failed_app();
+            Print_result(BOOT_RESULT_APP_ERASED);
+            Driver_UART0_send_string("\n---------------------------------------------------------------\n");
         }
     }
     else
     {
         Driver_UART0_send_string("\n---------------------------------------------------------------");
         Driver_UART0_send_string("\nMode  : Boot mode");
-        Driver_UART0_send_string("\nStatus: Waiting for receiving Srec file");
+
+        /*Show the App that is going to be replaced*/
+        if ((1 == Update_is_app_valid()) && (APP_MANIFEST_MAGIC == Read_FlashAddress(APP_HEADER_LOCATION)))
+        {
+            Driver_UART0_send_string("\nApp   : version ");
+            Driver_UART0_send_number(Read_FlashAddress(APP_HEADER_LOCATION + offsetof(app_manifest, version)));
+            Driver_UART0_send_string(", ");
+            Driver_UART0_send_number(Read_FlashAddress(APP_HEADER_LOCATION + offsetof(app_manifest, load_size)));
+            Driver_UART0_send_string(" bytes, crc ");
+            Driver_UART0_send_hex(Read_FlashAddress(APP_HEADER_LOCATION + offsetof(app_manifest, image_crc)));
+        }
+        else if (1 == Update_is_app_valid())
+        {
+            /*Get the header in header region*/
+            header_byte = Read_Flash_byte(APP_HEADER_LOCATION);
+            while (0xFFu != header_byte && '.' != header_byte && i < APP_HEADER_MAX_LENGTH)
+            {
+                s_work_line[i] = header_byte;
+                i++;
+                header_byte = Read_Flash_byte(APP_HEADER_LOCATION + i);
+            }
+
+            Driver_UART0_send_string("\nApp   : ");
+            s_work_line[i] = '\0';
+
+            Driver_UART0_send_string(s_work_line);
+        }
+        else
+        {
+            /*Do nothing*/
+        }
 
         /*Call boot process*/
         boot_state = Boot_main();
@@ -517,15 +664,45 @@ int main(void)
         }
 
         /*Evaluate the boot result*/
-        if (1 == boot_state)
+        if (BOOT_RESULT_SUCCESS == boot_state)
         {
-            Driver_UART0_send_string("\nUpdate has been finised, restart to lanch new Application");
+            Driver_UART0_send_string("\nUpdate has been finished, press reset to launch new Application");
+            Print_line_quality();
+            Update_print_statistics(s_boot_info.core_clock);
+            Verify_print_map();
+            Print_result(boot_state);
+            Trace_dump();
             Driver_UART0_send_string("\n---------------------------------------------------------------\n");
         }
         else
         {
             Driver_UART0_send_string("\nStatus: Failed to update firmware");
             Driver_UART0_send_string("\nThe Boot process will be terminated.");
+
+            /*A staged image that failed has not touched flash*/
+            if (0u == Update_is_flash_written())
+            {
+                Driver_UART0_send_string("\nFlash has not been written, the old Application is kept.");
+            }
+            else
+            {
+                /*Do nothing*/
+            }
+
+            if (BOOT_RESULT_TOO_LARGE == boot_state)
+            {
+                Driver_UART0_send_string("\nThe image is larger than the RAM staging buffer: send it paced (#PACE 1),");
+                Driver_UART0_send_string("\nits first line alone.");
+            }
+            else
+            {
+                /*Do nothing*/
+            }
+            Print_line_quality();
+            Update_print_statistics(s_boot_info.core_clock);
+            Verify_print_map();
+            Print_result(boot_state);
+            Trace_dump();
             Driver_UART0_send_string("\n---------------------------------------------------------------\n");
         }
     }
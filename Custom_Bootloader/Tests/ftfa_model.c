@@ -0,0 +1,477 @@
+/**
+ * @file  : ftfa_model.c
+ * @author: Nguyen The Anh.
+ * @brief : Host model of the FTFA flash controller and the program flash, shared by test_flash and test_board.
+ * @version: 0.0
+ *
+ * The page of the FTFA register block is mapped without access: each register access faults, the
+ * model sets the registers the code is about to read, lets the one instruction run with the x86
+ * trap flag and then takes the values it wrote. FSTAT is write 1 to clear as on the target. The
+ * program flash is mapped read only, a block is closed while a command runs on it. The model
+ * writes it as the commands run.
+ *
+ * A launched command runs for its typical time of the KL46 data sheet on the clock of the check
+ * program. The code takes no time: the second busy read of FSTAT at the same time is a wait, the
+ * clock moves to the end of the command and the interrupts due meanwhile are taken. The program
+ * check command compares the longword at the margin level of FCCOB4, the weak longword fails it.
+ * The model counts as a violation:
+ *   - a command on the boot block launched with the interrupts enabled (the code and the
+ *     vector table are fetched from that block)
+ *   - an erase of the whole boot block, a command on the protected flash
+ *   - a read of a block while a command runs on it
+ *   - a command register written while a command runs, a longword programmed twice
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "ftfa_model.h"
+#include "MKL46Z4.h"
+#include "HAL/FLASH.h"
+#include "Flash_layout.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\FSTAT flags a write of 1 clears*/
+#define MODEL_FSTAT_ERROR_CLEAR (FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK)
+
+/*\x86 EFLAGS trap flag: one instruction then SIGTRAP*/
+#define MODEL_TRAP_FLAG (0x100)
+
+/*\Page fault error code of a write*/
+#define MODEL_FAULT_WRITE (0x2)
+
+/*\Number of program flash blocks*/
+#define MODEL_BLOCKS (FLASH_TOTAL_SIZE / FLASH_BLOCK_SIZE)
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*State of the model*/
+ftfa_model g_ftfa_model;
+
+/*This variable stores the clock of the check program*/
+static const ftfa_model_clock *s_clock = NULL;
+
+/*This array stores page 0 of block 0*/
+static uint8_t s_page0[MODEL_FLASH_START];
+
+/*This variable stores the protection of each block*/
+static int s_block_protection[MODEL_BLOCKS];
+
+/*This variable stores 1 while the register page is open*/
+static uint8_t s_registers_open = 0;
+
+/*This variable stores the access in progress: register offset or block, and its time*/
+static uint8_t s_access_pending = 0;
+static uint8_t s_access_write = 0;
+static uint8_t s_access_flash = 0;
+static uintptr_t s_access_offset = 0;
+static uint64_t s_spin_us = 0;
+
+/*This variable stores FCNFG as last written, the interrupt enable of the model*/
+static uint8_t s_fcnfg = 0;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+void FTFA_IRQHandler(void);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*First mapped byte and size of a block*/
+static uintptr_t model_block_start(uint8_t block)
+{
+    return (0u == block) ? MODEL_FLASH_START : ((uintptr_t)block * FLASH_BLOCK_SIZE);
+}
+
+static size_t model_block_size(uint8_t block)
+{
+    return (0u == block) ? (FLASH_BLOCK_SIZE - MODEL_FLASH_START) : FLASH_BLOCK_SIZE;
+}
+
+/*Open or close a block to the reads of the code*/
+static void model_set_block_access(uint8_t block, int protection)
+{
+    if (protection != s_block_protection[block])
+    {
+        (void)mprotect((void *)model_block_start(block), model_block_size(block), protection);
+        s_block_protection[block] = protection;
+    }
+}
+
+/*Open or close the register page, return its state before*/
+static uint8_t model_set_registers(uint8_t open)
+{
+    uint8_t was_open = s_registers_open;
+
+    if (open != s_registers_open)
+    {
+        (void)mprotect((void *)FTFA_BASE, MODEL_PAGE_SIZE, (0u != open) ? (PROT_READ | PROT_WRITE) : PROT_NONE);
+        s_registers_open = open;
+    }
+
+    return was_open;
+}
+
+uint8_t *ftfa_model_byte(uint32_t address)
+{
+    return (address < MODEL_FLASH_START) ? &s_page0[address] : (uint8_t *)(uintptr_t)address;
+}
+
+/*Write a range of one block, the block keeps its protection*/
+static void model_write(uint32_t address, const uint8_t *data, uint8_t value, uint32_t size)
+{
+    uint8_t block = Flash_Get_Block(address);
+    int protection = s_block_protection[block];
+
+    model_set_block_access(block, PROT_READ | PROT_WRITE);
+    if (NULL != data)
+    {
+        memcpy(ftfa_model_byte(address), data, size);
+    }
+    else
+    {
+        memset(ftfa_model_byte(address), value, size);
+    }
+    model_set_block_access(block, protection);
+}
+
+void ftfa_model_fill(uint32_t address, uint8_t value, uint32_t size)
+{
+    uint32_t part = 0;
+
+    /*Page 0 and each block on its own*/
+    while (0u != size)
+    {
+        part = (address < MODEL_FLASH_START) ? (MODEL_FLASH_START - address)
+                                             : (FLASH_BLOCK_SIZE - (address % FLASH_BLOCK_SIZE));
+        part = (part < size) ? part : size;
+        model_write(address, NULL, value, part);
+        address += part;
+        size -= part;
+    }
+}
+
+/*Run a command of the FCCOB registers, return its time or 0 if it is refused*/
+static uint32_t model_execute(uint8_t command, uint32_t address)
+{
+    volatile FTFA_Type *regs = FTFA;
+    uint32_t duration = 0;
+    uint32_t start = 0;
+    uint32_t size = 0;
+    uint32_t i = 0;
+    uint8_t data[4] = {0};
+    uint8_t program[4] = {0};
+    uint8_t margin = 0;
+
+    if (CMD_ERASE_FLASH_SECTOR == command)
+    {
+        start = address & ~(FLASH_SECTOR_SIZE - 1u);
+        size = FLASH_SECTOR_SIZE;
+        duration = MODEL_ERASE_SECTOR_US;
+    }
+    else if (CMD_ERASE_FLASH_BLOCK == command)
+    {
+        start = address & ~(FLASH_BLOCK_SIZE - 1u);
+        size = FLASH_BLOCK_SIZE;
+        duration = MODEL_ERASE_BLOCK_US;
+        g_ftfa_model.violations += (FLASH_BOOT_BLOCK == Flash_Get_Block(address)) ? 1u : 0u;
+    }
+    else if (CMD_PROGRAM_LONGWORD == command)
+    {
+        /*FCCOB4 is the most significant byte*/
+        start = address;
+        data[3] = regs->FCCOB4;
+        data[2] = regs->FCCOB5;
+        data[1] = regs->FCCOB6;
+        data[0] = regs->FCCOB7;
+        duration = MODEL_PROGRAM_LONGWORD_US;
+    }
+    else if (CMD_PROGRAM_CHECK == command)
+    {
+        /*FCCOB4 is the margin level: user or factory*/
+        start = address;
+        margin = regs->FCCOB4;
+        data[3] = regs->FCCOB8;
+        data[2] = regs->FCCOB9;
+        data[1] = regs->FCCOBA;
+        data[0] = regs->FCCOBB;
+        duration = ((FLASH_MARGIN_USER == margin) || (FLASH_MARGIN_FACTORY == margin)) ? MODEL_PROGRAM_CHECK_US : 0u;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    if ((0u == duration) || (0u != (address % 4u)))
+    {
+        duration = 0;
+    }
+    else if (start < g_ftfa_model.protected_end)
+    {
+        /*FPVIOL: the command does not run*/
+        g_ftfa_model.fstat |= FTFA_FSTAT_FPVIOL_MASK;
+        g_ftfa_model.violations++;
+        duration = 0;
+    }
+    else if (0u != size)
+    {
+        model_write(start, NULL, 0xFFu, size);
+        g_ftfa_model.sector_erases += (FLASH_SECTOR_SIZE == size) ? 1u : 0u;
+        g_ftfa_model.block_erases += (FLASH_BLOCK_SIZE == size) ? 1u : 0u;
+    }
+    else if (CMD_PROGRAM_LONGWORD == command)
+    {
+        /*A bit programmed to 0 stays 0: the verify of the command fails if the flash does not read the data*/
+        for (i = 0; i < 4u; i++)
+        {
+            g_ftfa_model.violations += (0xFFu != *ftfa_model_byte(address + i)) ? 1u : 0u;
+            program[i] = data[i] & *ftfa_model_byte(address + i);
+        }
+        model_write(address, program, 0, 4u);
+        g_ftfa_model.fstat |= (0 != memcmp(program, data, 4u)) ? FTFA_FSTAT_MGSTAT0_MASK : 0u;
+        g_ftfa_model.programs++;
+    }
+    else
+    {
+        /*The weak longword reads its data, it does not at a margin level*/
+        g_ftfa_model.fstat |= ((0 != memcmp(ftfa_model_byte(address), data, 4u)) ||
+                               ((g_ftfa_model.weak_address == address) && (0 != memcmp(data, "\xFF\xFF\xFF\xFF", 4u))))
+                                  ? FTFA_FSTAT_MGSTAT0_MASK
+                                  : 0u;
+        g_ftfa_model.checks++;
+    }
+
+    return duration;
+}
+
+/*The code has written 1 to CCIF: launch the command of the FCCOB registers*/
+static void model_launch(void)
+{
+    volatile FTFA_Type *regs = FTFA;
+    uint32_t address = ((uint32_t)regs->FCCOB1 << 16) | ((uint32_t)regs->FCCOB2 << 8) | regs->FCCOB3;
+    uint32_t duration = 0;
+
+    /*A launch with an error flag left set is ignored*/
+    if (0u == (g_ftfa_model.fstat & MODEL_FSTAT_ERROR_CLEAR))
+    {
+        g_ftfa_model.fstat &= (uint8_t)~FTFA_FSTAT_MGSTAT0_MASK;
+        duration = (address < FLASH_TOTAL_SIZE) ? model_execute(regs->FCCOB0, address) : 0u;
+        if (0u == duration)
+        {
+            g_ftfa_model.fstat |= (0u == (g_ftfa_model.fstat & FTFA_FSTAT_FPVIOL_MASK)) ? FTFA_FSTAT_ACCERR_MASK : 0u;
+        }
+        else
+        {
+            g_ftfa_model.violations +=
+                ((FLASH_BOOT_BLOCK == Flash_Get_Block(address)) && (0u == g_mock_primask)) ? 1u : 0u;
+            g_ftfa_model.fstat &= (uint8_t)~FTFA_FSTAT_CCIF_MASK;
+            g_ftfa_model.busy = 1;
+            g_ftfa_model.busy_block = Flash_Get_Block(address);
+            g_ftfa_model.end_us = s_clock->get_us() + duration;
+            g_ftfa_model.busy_us += duration;
+            /*The code runs from the boot block, its commands are run with the interrupts masked*/
+            if (FLASH_BOOT_BLOCK != g_ftfa_model.busy_block)
+            {
+                model_set_block_access(g_ftfa_model.busy_block, PROT_NONE);
+            }
+        }
+    }
+}
+
+void ftfa_model_run(void)
+{
+    uint8_t was_open = 0;
+
+    if ((0u != g_ftfa_model.busy) && (s_clock->get_us() >= g_ftfa_model.end_us))
+    {
+        g_ftfa_model.busy = 0;
+        g_ftfa_model.fstat |= FTFA_FSTAT_CCIF_MASK;
+        model_set_block_access(g_ftfa_model.busy_block, PROT_READ);
+    }
+
+    if ((0u == g_ftfa_model.busy) && (0u == g_mock_primask) && (0u != (s_fcnfg & FTFA_FCNFG_CCIE_MASK)))
+    {
+        g_ftfa_model.interrupts++;
+        was_open = model_set_registers(1);
+        FTFA->FSTAT = g_ftfa_model.fstat;
+        FTFA_IRQHandler();
+        s_fcnfg = FTFA->FCNFG;
+        (void)model_set_registers(was_open);
+    }
+}
+
+uint64_t ftfa_model_next_us(void)
+{
+    return (0u != g_ftfa_model.busy) ? g_ftfa_model.end_us : UINT64_MAX;
+}
+
+/*The code reads FSTAT: the second busy read at the same time is a wait, stall to the end of the command*/
+static void model_read_fstat(void)
+{
+    uint64_t now_us = s_clock->get_us();
+
+    if ((0u != g_ftfa_model.busy) && (0u != g_ftfa_model.spinning) && (now_us == s_spin_us))
+    {
+        g_ftfa_model.stall_us += g_ftfa_model.end_us - now_us;
+        g_ftfa_model.masked_us += (0u != g_mock_primask) ? (g_ftfa_model.end_us - now_us) : 0u;
+        s_clock->run_until(g_ftfa_model.end_us);
+        ftfa_model_run();
+    }
+    g_ftfa_model.spinning = g_ftfa_model.busy;
+    s_spin_us = s_clock->get_us();
+}
+
+uint8_t ftfa_model_on_fault(siginfo_t *info, ucontext_t *context)
+{
+    uintptr_t address = (uintptr_t)info->si_addr;
+    uint8_t block = 0;
+    uint8_t ret_val = 1;
+
+    if ((address - FTFA_BASE) < MODEL_PAGE_SIZE)
+    {
+        s_access_flash = 0;
+        s_access_write = (0 != (context->uc_mcontext.gregs[REG_ERR] & MODEL_FAULT_WRITE)) ? 1u : 0u;
+        s_access_offset = address - FTFA_BASE;
+        /*The interrupts enabled again since the last access are taken first*/
+        s_clock->run_until(s_clock->get_us());
+        ftfa_model_run();
+        if ((0u == s_access_write) && (offsetof(FTFA_Type, FSTAT) == s_access_offset))
+        {
+            model_read_fstat();
+        }
+        else
+        {
+            g_ftfa_model.spinning = 0;
+        }
+        (void)model_set_registers(1);
+        FTFA->FSTAT = g_ftfa_model.fstat;
+    }
+    else if ((address >= MODEL_FLASH_START) && (address < FLASH_TOTAL_SIZE) &&
+             (PROT_NONE == s_block_protection[Flash_Get_Block((uint32_t)address)]))
+    {
+        /*A block is closed while a command runs on it*/
+        block = Flash_Get_Block((uint32_t)address);
+        s_access_flash = 1;
+        s_access_offset = block;
+        g_ftfa_model.violations++;
+        model_set_block_access(block, PROT_READ);
+    }
+    else
+    {
+        ret_val = 0;
+    }
+
+    if (0u != ret_val)
+    {
+        s_access_pending = 1;
+        context->uc_mcontext.gregs[REG_EFL] |= MODEL_TRAP_FLAG;
+    }
+
+    return ret_val;
+}
+
+uint8_t ftfa_model_on_trap(ucontext_t *context)
+{
+    uint8_t written = 0;
+    uint8_t ret_val = s_access_pending;
+
+    if (0u == s_access_pending)
+    {
+        /*Do nothing*/
+    }
+    else if (0u != s_access_flash)
+    {
+        model_set_block_access((uint8_t)s_access_offset,
+                               ((0u != g_ftfa_model.busy) && (s_access_offset == g_ftfa_model.busy_block)) ? PROT_NONE
+                                                                                                       : PROT_READ);
+    }
+    else
+    {
+        if ((0u != s_access_write) && (offsetof(FTFA_Type, FSTAT) == s_access_offset))
+        {
+            written = FTFA->FSTAT;
+            g_ftfa_model.fstat &= (uint8_t)~(written & MODEL_FSTAT_ERROR_CLEAR);
+            if ((0u != (written & FTFA_FSTAT_CCIF_MASK)) && (0u == g_ftfa_model.busy))
+            {
+                model_launch();
+            }
+        }
+        else if ((0u != s_access_write) && (offsetof(FTFA_Type, FCNFG) == s_access_offset))
+        {
+            s_fcnfg = FTFA->FCNFG;
+        }
+        else if ((0u != s_access_write) && (0u != g_ftfa_model.busy) && (offsetof(FTFA_Type, FCCOB3) <= s_access_offset))
+        {
+            /*The command registers are locked while CCIF is clear*/
+            g_ftfa_model.violations++;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+        FTFA->FSTAT = g_ftfa_model.fstat;
+        (void)model_set_registers(0);
+    }
+
+    if (0u != ret_val)
+    {
+        s_access_pending = 0;
+        context->uc_mcontext.gregs[REG_EFL] &= ~MODEL_TRAP_FLAG;
+    }
+
+    return ret_val;
+}
+
+uint8_t ftfa_model_init(int file, const ftfa_model_clock *clock)
+{
+    void *registers = mmap((void *)FTFA_BASE, MODEL_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    void *flash = (file >= 0) ? mmap((void *)MODEL_FLASH_START, FLASH_TOTAL_SIZE - MODEL_FLASH_START, PROT_READ,
+                                     MAP_SHARED | MAP_FIXED_NOREPLACE, file, MODEL_FLASH_START)
+                              : mmap((void *)MODEL_FLASH_START, FLASH_TOTAL_SIZE - MODEL_FLASH_START, PROT_READ,
+                                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    uint8_t block = 0;
+
+    if (((void *)FTFA_BASE != registers) || ((void *)MODEL_FLASH_START != flash))
+    {
+        return 0;
+    }
+
+    s_clock = clock;
+    for (block = 0; block < MODEL_BLOCKS; block++)
+    {
+        s_block_protection[block] = PROT_READ;
+    }
+    memset(s_page0, 0xFF, sizeof(s_page0));
+    if (file < 0)
+    {
+        ftfa_model_fill(MODEL_FLASH_START, 0xFFu, FLASH_TOTAL_SIZE - MODEL_FLASH_START);
+    }
+    memset(&g_ftfa_model, 0, sizeof(g_ftfa_model));
+    s_fcnfg = 0;
+    g_ftfa_model.weak_address = MODEL_NO_WEAK;
+    g_ftfa_model.fstat = FTFA_FSTAT_CCIF_MASK;
+    FTFA->FSTAT = g_ftfa_model.fstat;
+    s_registers_open = 1;
+    (void)model_set_registers(0);
+
+    return 1;
+}
+/*EOF*/
@@ -0,0 +1,158 @@
+/**
+ * @file  : ftfa_model.h
+ * @author: Nguyen The Anh.
+ * @brief : Host model of the FTFA flash controller and the program flash, shared by test_flash and test_board.
+ * @version: 0.0
+ *
+ * FLASH.c runs unchanged on the FTFA register block of the device header, at its address
+ * FTFA_BASE, and on the program flash mapped at its addresses from MODEL_FLASH_START. Each access
+ * to the registers faults, the model runs the instruction alone with the x86 trap flag: the
+ * check program gives the SIGSEGV and SIGTRAP of those accesses to ftfa_model_on_fault and
+ * ftfa_model_on_trap. The time of a command is taken on the clock of the check program.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _FTFA_MODEL_H_
+#define _FTFA_MODEL_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <signal.h>
+#include <stdint.h>
+#include <ucontext.h>
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Page of a register block*/
+#define MODEL_PAGE_SIZE (0x1000u)
+
+/*\Page 0 is below vm.mmap_min_addr: the model keeps it in an array, the code does not read it*/
+#define MODEL_FLASH_START (MODEL_PAGE_SIZE)
+
+/*\Typical command times of the KL46 data sheet, in microseconds*/
+#define MODEL_PROGRAM_LONGWORD_US (65u)
+#define MODEL_PROGRAM_CHECK_US    (45u)
+#define MODEL_ERASE_SECTOR_US     (14000u)
+#define MODEL_ERASE_BLOCK_US      (88000u)
+
+/*\Weak longword: none*/
+#define MODEL_NO_WEAK (0xFFFFFFFFu)
+
+/*******************************************************************************
+ * Struct
+ ******************************************************************************/
+
+/*Clock of the check program*/
+typedef struct ftfa_model_clock
+{
+    uint64_t (*get_us)(void);       /*Time of the check, in microseconds*/
+    void (*run_until)(uint64_t us); /*The code waits until a time, the interrupts due meanwhile are taken*/
+} ftfa_model_clock;
+
+/*State of the FTFA model*/
+typedef struct ftfa_model
+{
+    uint64_t end_us;         /*End of the running command*/
+    uint64_t busy_us;        /*Time of all the commands launched*/
+    uint64_t stall_us;       /*Time the code spun on FSTAT*/
+    uint64_t masked_us;      /*Part of stall_us with the interrupts masked*/
+    uint32_t sector_erases;
+    uint32_t block_erases;
+    uint32_t programs;
+    uint32_t checks;         /*Program check commands*/
+    uint32_t violations;
+    uint32_t interrupts;     /*FTFA_IRQHandler calls*/
+    uint32_t protected_end;  /*The flash below is protected: a command on it fails with FPVIOL*/
+    uint32_t weak_address;   /*Longword programmed weak: it reads its data, not at the margin levels*/
+    uint8_t fstat;           /*FSTAT of the model, the page holds the other registers*/
+    uint8_t busy;            /*1 while a command runs*/
+    uint8_t busy_block;      /*Block of the running command*/
+    uint8_t spinning;        /*1 if the last access read FSTAT busy*/
+} ftfa_model;
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*State of the model, the counters are cleared by the check program*/
+extern ftfa_model g_ftfa_model;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/**
+ * @brief Map the FTFA registers and the program flash at their addresses on an idle FTFA
+ *
+ * @param file: Descriptor of a flash file of FLASH_TOTAL_SIZE bytes, -1 maps an erased flash
+ * @param clock: Clock of the check program
+ *
+ * @return 1 if they are mapped, 0 if an address can not be mapped here
+ */
+uint8_t ftfa_model_init(int file, const ftfa_model_clock *clock);
+
+/**
+ * @brief Byte of the flash content at an address, for the check program
+ *
+ * @param address: Flash address
+ *
+ * @return Pointer to the byte
+ */
+uint8_t *ftfa_model_byte(uint32_t address);
+
+/**
+ * @brief Fill a flash range with a value, as the content a check starts with
+ *
+ * @param address: Start of the range
+ * @param value: Value of the bytes
+ * @param size: Size of the range
+ */
+void ftfa_model_fill(uint32_t address, uint8_t value, uint32_t size);
+
+/**
+ * @brief The clock has moved: finish the command that has ended and take its interrupt if the
+ *        code enabled it and the interrupts are not masked
+ */
+void ftfa_model_run(void);
+
+/**
+ * @brief Time the running command ends
+ *
+ * @return End of the running command in microseconds, UINT64_MAX if the FTFA is idle
+ */
+uint64_t ftfa_model_next_us(void);
+
+/**
+ * @brief Prepare a fault on the registers or on a block under command and run its instruction alone
+ *
+ * @param info: Signal information of the SIGSEGV
+ * @param context: Context of the SIGSEGV
+ *
+ * @return 1 if the fault is a model access, 0 otherwise
+ */
+uint8_t ftfa_model_on_fault(siginfo_t *info, ucontext_t *context);
+
+/**
+ * @brief Take the values written by the instruction of a model access and close the page again
+ *
+ * @param context: Context of the SIGTRAP
+ *
+ * @return 1 if the trap is the one of a model access, 0 otherwise
+ */
+uint8_t ftfa_model_on_trap(ucontext_t *context);
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
@@ -0,0 +1,310 @@
+/**
+ * @file  : fuzz_main.c
+ * @author: Nguyen The Anh.
+ * @brief : Standalone driver of the fuzz harnesses, for a compiler without libFuzzer.
+ * @version: 0.0
+ *
+ * Usage: fuzz_<target> [-runs=N] [-seed=N] [-max_len=N] <corpus directory or file>...
+ *
+ * The harness is the LLVMFuzzerTestOneInput of a fuzz_*.c file. Built with clang and
+ * -fsanitize=fuzzer this file is left out and libFuzzer runs it with the same options. Here
+ * every corpus file is run once, then `runs` inputs made of a corpus file with random
+ * mutations. The inputs are copied to a buffer of their exact size so that ASan reports a read
+ * past their end. An input that crashes, or fails an abort() of the harness, is written to
+ * crash-<target>. The executions per second are printed at the end.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sanitizer/common_interface_defs.h>
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Largest number of corpus files*/
+#define FUZZ_CORPUS_MAX (4096u)
+
+/*\Longest input, an S-record line and its line end fit*/
+#define FUZZ_DEFAULT_MAX_LEN (600u)
+
+/*\Largest number of mutations of an input*/
+#define FUZZ_MUTATIONS_MAX (8u)
+
+/*******************************************************************************
+ * Struct
+ ******************************************************************************/
+
+/*An input of the corpus*/
+typedef struct fuzz_input
+{
+    uint8_t *data;
+    size_t size;
+} fuzz_input;
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*This array stores the corpus*/
+static fuzz_input s_corpus[FUZZ_CORPUS_MAX];
+static unsigned int s_corpus_count = 0;
+
+/*This variable stores the state of the random generator*/
+static uint32_t s_random = 1;
+
+/*This variable stores the input being run, written on a crash*/
+static const uint8_t *s_current = NULL;
+static size_t s_current_size = 0;
+static char s_crash_name[256];
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*xorshift32, the same runs for the same seed*/
+static uint32_t get_random(uint32_t range)
+{
+    s_random ^= s_random << 13u;
+    s_random ^= s_random >> 17u;
+    s_random ^= s_random << 5u;
+
+    return (0u != range) ? (s_random % range) : 0u;
+}
+
+/*Called by the sanitizer before it ends the process*/
+static void save_crash(void)
+{
+    FILE *file = fopen(s_crash_name, "wb");
+
+    if (NULL != file)
+    {
+        fwrite(s_current, 1u, s_current_size, file);
+        fclose(file);
+        fprintf(stderr, "fuzz: input written to %s\n", s_crash_name);
+    }
+}
+
+/*An abort() of the harness, the sanitizers do not handle it*/
+static void save_abort(int signal_number)
+{
+    save_crash();
+    signal(signal_number, SIG_DFL);
+    raise(signal_number);
+}
+
+/*Run the harness on a copy of its exact size*/
+static void run_input(const uint8_t *data, size_t size)
+{
+    uint8_t *copy = malloc((0u != size) ? size : 1u);
+
+    if (NULL != copy)
+    {
+        memcpy(copy, data, size);
+        s_current = copy;
+        s_current_size = size;
+        (void)LLVMFuzzerTestOneInput(copy, size);
+        free(copy);
+    }
+}
+
+/*Add a file to the corpus, cut to max_len*/
+static void load_file(const char *name, size_t max_len)
+{
+    FILE *file = NULL;
+    uint8_t *data = NULL;
+
+    if (s_corpus_count < FUZZ_CORPUS_MAX)
+    {
+        file = fopen(name, "rb");
+        data = malloc(max_len);
+        if ((NULL != file) && (NULL != data))
+        {
+            s_corpus[s_corpus_count].data = data;
+            s_corpus[s_corpus_count].size = fread(data, 1u, max_len, file);
+            s_corpus_count++;
+            data = NULL;
+        }
+        if (NULL != file)
+        {
+            fclose(file);
+        }
+        free(data);
+    }
+}
+
+/*Add a corpus directory, or a file*/
+static void load_corpus(const char *path, size_t max_len)
+{
+    DIR *directory = opendir(path);
+    struct dirent *entry = NULL;
+    char name[1024];
+
+    if (NULL == directory)
+    {
+        load_file(path, max_len);
+        return;
+    }
+    while (NULL != (entry = readdir(directory)))
+    {
+        if ('.' != entry->d_name[0])
+        {
+            snprintf(name, sizeof(name), "%s/%s", path, entry->d_name);
+            load_file(name, max_len);
+        }
+    }
+    closedir(directory);
+}
+
+/*Change an input in place, return its new size*/
+static size_t mutate(uint8_t *data, size_t size, size_t max_len)
+{
+    static const char hex[] = "0123456789ABCDEFS\r\n";
+    unsigned int count = 1u + get_random(FUZZ_MUTATIONS_MAX);
+    unsigned int i = 0;
+    const fuzz_input *other = NULL;
+    size_t position = 0;
+    size_t length = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        position = get_random((uint32_t)size + 1u);
+        switch (get_random(6u))
+        {
+        case 0: /*Flip a bit*/
+            if (position < size)
+            {
+                data[position] ^= (uint8_t)(1u << get_random(8u));
+            }
+            break;
+        case 1: /*A digit, the start code or a line end*/
+            if (position < size)
+            {
+                data[position] = (uint8_t)hex[get_random(sizeof(hex) - 1u)];
+            }
+            break;
+        case 2: /*Insert a byte*/
+            if (size < max_len)
+            {
+                memmove(data + position + 1u, data + position, size - position);
+                data[position] = (uint8_t)get_random(256u);
+                size++;
+            }
+            break;
+        case 3: /*Erase bytes*/
+            length = get_random(8u);
+            length = (length < (size - position)) ? length : (size - position);
+            memmove(data + position, data + position + length, size - position - length);
+            size -= length;
+            break;
+        case 4: /*Cut the input*/
+            size = position;
+            break;
+        default: /*Copy a part of another input over it*/
+            other = &s_corpus[get_random(s_corpus_count)];
+            length = get_random((uint32_t)other->size + 1u);
+            length = (length < (max_len - position)) ? length : (max_len - position);
+            memcpy(data + position, other->data, length);
+            size = ((position + length) > size) ? (position + length) : size;
+            break;
+        }
+    }
+
+    return size;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long runs = 100000u;
+    unsigned long run = 0;
+    size_t max_len = FUZZ_DEFAULT_MAX_LEN;
+    const char *target = strrchr(argv[0], '/');
+    uint8_t *data = NULL;
+    size_t size = 0;
+    struct timespec start;
+    struct timespec end;
+    double seconds = 0;
+    unsigned int i = 0;
+    int arg = 0;
+
+    target = (NULL != target) ? (target + 1) : argv[0];
+    snprintf(s_crash_name, sizeof(s_crash_name), "crash-%s", target);
+    for (arg = 1; arg < argc; arg++)
+    {
+        if (0 == strncmp(argv[arg], "-runs=", 6u))
+        {
+            runs = strtoul(argv[arg] + 6, NULL, 0);
+        }
+        else if (0 == strncmp(argv[arg], "-seed=", 6u))
+        {
+            s_random = (uint32_t)strtoul(argv[arg] + 6, NULL, 0);
+            s_random = (0u != s_random) ? s_random : 1u;
+        }
+        else if (0 == strncmp(argv[arg], "-max_len=", 9u))
+        {
+            max_len = strtoul(argv[arg] + 9, NULL, 0);
+            max_len = (0u != max_len) ? max_len : FUZZ_DEFAULT_MAX_LEN;
+        }
+        else
+        {
+            load_corpus(argv[arg], max_len);
+        }
+    }
+    if (0u == s_corpus_count)
+    {
+        /*An empty input to start from*/
+        s_corpus[0].data = malloc(max_len);
+        s_corpus[0].size = 0;
+        s_corpus_count = (NULL != s_corpus[0].data) ? 1u : 0u;
+    }
+    data = malloc(max_len);
+    if ((0u == s_corpus_count) || (NULL == data))
+    {
+        return 2;
+    }
+    __sanitizer_set_death_callback(save_crash);
+    signal(SIGABRT, save_abort);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < s_corpus_count; i++)
+    {
+        run_input(s_corpus[i].data, s_corpus[i].size);
+    }
+    for (run = 0; run < runs; run++)
+    {
+        const fuzz_input *seed = &s_corpus[get_random(s_corpus_count)];
+
+        memcpy(data, seed->data, seed->size);
+        size = mutate(data, seed->size, max_len);
+        run_input(data, size);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    seconds = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+    printf("%s: %u corpus inputs, %lu runs in %.2f s, %.0f exec/s\n", target, s_corpus_count,
+           s_corpus_count + runs, seconds, (seconds > 0) ? ((double)(s_corpus_count + runs) / seconds) : 0.0);
+    free(data);
+
+    return 0;
+}
+/*EOF*/
@@ -0,0 +1,127 @@
+/**
+ * @file  : fuzz_srec.c
+ * @author: Nguyen The Anh.
+ * @brief : Fuzz harness of the S-record decoder, one input is one received line.
+ * @version: 0.0
+ *
+ * The line is decoded as Boot_main does: parse_Srecord_line then check_srec_line. A line that
+ * is accepted must have the length of its byte count, a known record type, a data field that
+ * fits record->data, and must be written back the same from the decoded fields.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Srec/Srec.h"
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Address field width in hex digits of a record type*/
+static unsigned int get_address_width(uint8_t type)
+{
+    unsigned int ret_val = ADDRESS_16BIT_WIDTH;
+
+    if ((S2 == type) || (S6 == type) || (S8 == type))
+    {
+        ret_val = ADDRESS_24BIT_WIDTH;
+    }
+    else if ((S3 == type) || (S7 == type))
+    {
+        ret_val = ADDRESS_32BIT_WIDTH;
+    }
+    else
+    {
+        /*Do nothing*/
+    }
+
+    return ret_val;
+}
+
+/*Write an accepted record back and compare it with its line*/
+static void check_accepted(const srec_line *record, const char *line)
+{
+    char text[SREC_LINE_BUFFER_SIZE];
+    unsigned int address_width = get_address_width(record->type);
+    unsigned int data_size = 0;
+    unsigned int length = 0;
+    unsigned int i = 0;
+
+    if ((S4 == record->type) || (record->type > S9) || (strlen(line) != ((record->byte_count + 2u) * 2u)))
+    {
+        abort();
+    }
+    if (record->type <= S3)
+    {
+        data_size = record->byte_count - (address_width / 2u) - 1u;
+        if ((data_size > sizeof(record->data)) ||
+            ((record->data_word * WORD_ALIGN) != ((data_size + WORD_ALIGN - 1u) & ~(WORD_ALIGN - 1u))))
+        {
+            abort();
+        }
+        for (i = data_size; i < (record->data_word * WORD_ALIGN); i++)
+        {
+            if (0xFFu != record->data[i])
+            {
+                abort();
+            }
+        }
+    }
+
+    length = (unsigned int)sprintf(text, "S%u%02X", record->type, record->byte_count);
+    /*The address of S0 is not decoded, it is taken from the line*/
+    if (S0 == record->type)
+    {
+        memcpy(text + length, line + ADDRESS_FIELD_OFFSET, address_width);
+        length += address_width;
+    }
+    else
+    {
+        length += (unsigned int)sprintf(text + length, "%0*X", (int)address_width, (unsigned int)record->address);
+    }
+    for (i = 0; i < data_size; i++)
+    {
+        length += (unsigned int)sprintf(text + length, "%02X", record->data[i]);
+    }
+    sprintf(text + length, "%02X", record->check_sum);
+
+    if (0 != strcmp(text, line))
+    {
+        fprintf(stderr, "fuzz_srec: accepted \"%s\" decodes to \"%s\"\n", line, text);
+        abort();
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    srec_line record;
+    uint8_t *line = NULL;
+
+    if (size <= SREC_MAX_LINE_LENGTH)
+    {
+        /*The receive queue ends the line with a NULL character*/
+        line = malloc(size + 1u);
+        if (NULL != line)
+        {
+            memcpy(line, data, size);
+            line[size] = '\0';
+            parse_Srecord_line(line, &record);
+            if (0u == check_srec_line(&record, line))
+            {
+                check_accepted(&record, (const char *)line);
+            }
+            free(line);
+        }
+    }
+
+    return 0;
+}
+/*EOF*/
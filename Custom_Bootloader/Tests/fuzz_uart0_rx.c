@@ -0,0 +1,216 @@
+/**
+ * @file  : fuzz_uart0_rx.c
+ * @author: Nguyen The Anh.
+ * @brief : Fuzz harness of the UART0 receive path: interrupt handler, receive queue and decoder.
+ * @version: 0.0
+ *
+ * One input is the bytes on the wire, an S-record file is a valid input. Each byte is received
+ * by UART0_IRQHandler on the register block of mock/MKL46Z4.h. The escape byte 0x1B, never in
+ * an S-record file, takes the next byte as a control of the byte after it:
+ *   bits 0 - 3: OR, NF, FE and PF flags set with the byte
+ *   bit 5: read a line after the byte, as Boot_main does, and decode it
+ *   bit 6: step the baud rate down after the byte, if the error rate asks for it
+ * The ready lines are read at the end. Each received byte must be counted, the queue must keep
+ * one free line, and every line read must be a string of at most a queue line without line end.
+ * The multi-drop address match is not run: leaving it needs the NVIC of the target.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "MKL46Z4.h"
+#include "Driver/Driver_UART0.h"
+#include "Driver/Driver_PORT.h"
+#include "Driver/Driver_SIM.h"
+#include "Event/Event.h"
+#include "Queue/Queque.h"
+#include "Srec/Srec.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Byte that starts a control*/
+#define FUZZ_ESCAPE (0x1Bu)
+
+/*\Bits of a control*/
+#define FUZZ_ERROR_FLAGS_MASK (0x0Fu)
+#define FUZZ_READ_LINE        (0x20u)
+#define FUZZ_STEP_DOWN        (0x40u)
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*UART0 register block of the device header*/
+UART0_Type g_mock_uart0;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+void UART0_IRQHandler(void);
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Stand-ins of the modules the driver calls, the clock gates and pins do not exist on the host*/
+void Driver_PORT_set_MUX_pin(Port_type_enum_t port_type, uint8_t pin, Mux_type_enum_t mux_type)
+{
+    (void)port_type;
+    (void)pin;
+    (void)mux_type;
+}
+
+void Driver_SIM_SCGC4_set_UART0_clock_gate(clock_gate_state_enum_t uart0_clock_gate)
+{
+    (void)uart0_clock_gate;
+}
+
+void Driver_SIM_SCGC5_set_PORTn_clock_gate(Port_type_enum_t port, clock_gate_state_enum_t PORTn_gate)
+{
+    (void)port;
+    (void)PORTn_gate;
+}
+
+void Event_post(event_id_enum_t event)
+{
+    (void)event;
+}
+
+/*Run the interrupt handler on a received byte, the transmitter is idle*/
+static void receive_byte(uint8_t byte, uint8_t control)
+{
+    static const uint8_t error_flags[4] = {UART0_S1_OR_MASK, UART0_S1_NF_MASK, UART0_S1_FE_MASK, UART0_S1_PF_MASK};
+    uint8_t flags = 0;
+    uint8_t i = 0;
+
+    for (i = 0; i < 4u; i++)
+    {
+        flags |= (0u != (control & (1u << i))) ? error_flags[i] : 0u;
+    }
+    g_mock_uart0.S1 = UART0_S1_RDRF_MASK | UART0_S1_TDRE_MASK | UART0_S1_TC_MASK | flags;
+    g_mock_uart0.D = byte;
+    UART0_IRQHandler();
+    g_mock_uart0.S1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+}
+
+/*Read the first ready line and decode it, return 1 if there was one*/
+static unsigned int read_line(void)
+{
+    uint8_t received_line[QUEUE_LINE_SIZE];
+    srec_line record;
+    uint8_t *line = NULL;
+    uint8_t *end = NULL;
+    size_t length = 0;
+    unsigned int ret_val = 0;
+
+    if (QUEUE_ELEMENT_READY == Driver_UART0_check_first_buffer())
+    {
+        memset(received_line, 0xA5, sizeof(received_line));
+        Driver_UART0_receive_string(received_line);
+        Driver_UART0_dequeue();
+        ret_val = 1;
+
+        end = memchr(received_line, '\0', sizeof(received_line));
+        if (NULL == end)
+        {
+            abort();
+        }
+        length = (size_t)(end - received_line);
+        if ((NULL != memchr(received_line, '\r', length)) || (NULL != memchr(received_line, '\n', length)))
+        {
+            abort();
+        }
+
+        /*The decoder gets a buffer of the exact line size*/
+        line = malloc(length + 1u);
+        if (NULL != line)
+        {
+            memcpy(line, received_line, length + 1u);
+            parse_Srecord_line(line, &record);
+            (void)check_srec_line(&record, line);
+            free(line);
+        }
+    }
+
+    return ret_val;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    uart0_config_info config = {
+        .baud_rate = 115200,
+        .OSR = 16,
+        .Tx_Rx_port = PORT_A,
+        .Tx_pin = 2,
+        .Rx_pin = 1,
+        .data_mode = DATA_8BITS,
+        .parity_state = PARITY_DISABLED,
+        .stop_bit_count = ONE_STOP_BIT,
+        .transmitter_state = TRANSMITTER_ENABLED,
+        .receiver_state = RECEIVER_ENABLED,
+        .transmiter_IRQ = TRANSMIT_IRQ_DISABLED,
+        .receiver_IRQ = RECEIVE_IRQ_ENABLED,
+        .error_rate = 20,
+    };
+    uart0_rx_statistic_info statistics;
+    uint32_t received = 0;
+    uint8_t control = 0;
+    size_t i = 0;
+
+    /*Each input starts at the first baud rate with an empty queue*/
+    g_mock_uart0.S1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+    Driver_UART0_init(&config, 24000000u);
+    receive_byte('\n', 0u);
+    while (0u != read_line())
+    {
+        /*Do nothing*/
+    }
+    Driver_UART0_reset_rx_statistics();
+    Driver_UART0_reset_error_counters();
+
+    for (i = 0; i < size; i++)
+    {
+        if ((FUZZ_ESCAPE == data[i]) && ((i + 1u) < size))
+        {
+            i++;
+            control = data[i];
+            continue;
+        }
+
+        receive_byte(data[i], control & FUZZ_ERROR_FLAGS_MASK);
+        received++;
+        if (0u != (control & FUZZ_READ_LINE))
+        {
+            (void)read_line();
+        }
+        if (0u != (control & FUZZ_STEP_DOWN))
+        {
+            Driver_UART0_step_down();
+        }
+        control = 0;
+
+        Driver_UART0_get_rx_statistics(&statistics);
+        if ((received != statistics.received_bytes) || (statistics.peak_queue_occupancy > (MAX_QUEQUE_SIZE - 1u)))
+        {
+            abort();
+        }
+    }
+
+    while (0u != read_line())
+    {
+        /*Do nothing*/
+    }
+
+    return 0;
+}
+/*EOF*/
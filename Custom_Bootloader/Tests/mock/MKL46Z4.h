@@ -0,0 +1,135 @@
+/**
+ * @file  : MKL46Z4.h
+ * @author: Nguyen The Anh.
+ * @brief : Host stand-in of the device header: the real header with UART0, SysTick, SCB and NVIC on
+ *          register blocks in RAM, and the core intrinsics on a PRIMASK variable.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _MOCK_MKL46Z4_H_
+#define _MOCK_MKL46Z4_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*The core intrinsics below replace the ones of the CMSIS headers, they are ARM instructions*/
+#define __CORE_CMINSTR_H
+#define __CORE_CMFUNC_H
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*PRIMASK of the core intrinsics, 1 while the interrupts are masked*/
+extern uint32_t g_mock_primask;
+
+/*MSP of the core intrinsics, set by a check that runs on the stack of the linker file*/
+extern uint32_t g_mock_msp;
+
+/*WFI of the core intrinsics: a check that models time takes the next interrupt, 0 returns at once*/
+extern void (*g_mock_wfi)(void);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+static inline uint32_t __get_PRIMASK(void)
+{
+    return g_mock_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t primask)
+{
+    g_mock_primask = primask;
+}
+
+static inline void __disable_irq(void)
+{
+    g_mock_primask = 1u;
+}
+
+static inline void __enable_irq(void)
+{
+    g_mock_primask = 0u;
+}
+
+static inline uint32_t __get_MSP(void)
+{
+    return g_mock_msp;
+}
+
+static inline void __set_MSP(uint32_t top_of_stack)
+{
+    (void)top_of_stack;
+}
+
+static inline void __set_PSP(uint32_t top_of_stack)
+{
+    (void)top_of_stack;
+}
+
+static inline void __DSB(void)
+{
+}
+
+static inline void __WFI(void)
+{
+    if (0 != g_mock_wfi)
+    {
+        g_mock_wfi();
+    }
+}
+
+static inline void __NOP(void)
+{
+}
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include "../../Includes/MKL46Z4.h"
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*Register blocks the checks drive: the flags and the counter are set before calling the driver*/
+extern UART0_Type g_mock_uart0;
+extern SysTick_Type g_mock_systick;
+extern SCB_Type g_mock_scb;
+extern NVIC_Type g_mock_nvic;
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+#undef UART0
+#define UART0 (&g_mock_uart0)
+#undef SysTick
+#define SysTick (&g_mock_systick)
+#undef SCB
+#define SCB (&g_mock_scb)
+#undef NVIC
+#define NVIC (&g_mock_nvic)
+
+/*\The NVIC functions of core_cm0plus.h write the NVIC of the target, the checks call the handlers*/
+#define NVIC_EnableIRQ(IRQn) ((void)(IRQn))
+#define NVIC_DisableIRQ(IRQn) ((void)(IRQn))
+#define NVIC_ClearPendingIRQ(IRQn) ((void)(IRQn))
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
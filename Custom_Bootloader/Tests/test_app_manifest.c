@@ -0,0 +1,95 @@
+/**
+ * @file  : test_app_manifest.c
+ * @author: Nguyen The Anh.
+ * @brief : Host check of App_manifest_check at the edges of the App region.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include "test_check.h"
+#include "App_manifest.h"
+#include "Flash_layout.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\First address after flash*/
+#define FLASH_END (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE)
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Check a manifest with the entry at its load address*/
+static unsigned int check_range(uint32_t load_address, uint32_t load_size)
+{
+    app_manifest manifest = {
+        .magic = APP_MANIFEST_MAGIC,
+        .load_address = load_address,
+        .load_size = load_size,
+        .entry_address = load_address,
+    };
+
+    return App_manifest_check(&manifest);
+}
+
+int main(void)
+{
+    app_manifest manifest = {
+        .magic = APP_MANIFEST_MAGIC,
+        .load_address = BASE_APP_ADDRESS,
+        .load_size = 0x1000u,
+        .entry_address = BASE_APP_ADDRESS,
+        .flags = APP_MANIFEST_FLAG_CRC,
+    };
+
+    /*Accepted: the whole App region, one longword at each end*/
+    CHECK(1u == App_manifest_check(&manifest));
+    CHECK(1u == check_range(BASE_APP_ADDRESS, APP_REGION_SIZE));
+    CHECK(1u == check_range(BASE_APP_ADDRESS, 4u));
+    CHECK(1u == check_range(FLASH_END - VECTOR_TABLE_ALIGNMENT, VECTOR_TABLE_ALIGNMENT));
+
+    /*Below the App region and empty*/
+    CHECK(0u == check_range(BASE_APP_ADDRESS - VECTOR_TABLE_ALIGNMENT, 0x1000u));
+    CHECK(0u == check_range(0u, 0x1000u));
+    CHECK(0u == check_range(BASE_APP_ADDRESS, 0u));
+
+    /*Past the end of flash: the room left would underflow*/
+    CHECK(0u == check_range(FLASH_END, 4u));
+    CHECK(0u == check_range(FLASH_END + VECTOR_TABLE_ALIGNMENT, 4u));
+    CHECK(0u == check_range(0x00100000u, 0x100u));
+    CHECK(0u == check_range(0xFFFFFF00u, 0x100u));
+
+    /*One byte too long, and a size that would wrap the end*/
+    CHECK(0u == check_range(BASE_APP_ADDRESS, APP_REGION_SIZE + 1u));
+    CHECK(0u == check_range(FLASH_END - VECTOR_TABLE_ALIGNMENT, VECTOR_TABLE_ALIGNMENT + 1u));
+    CHECK(0u == check_range(BASE_APP_ADDRESS, 0xFFFFFFFFu));
+    CHECK(0u == check_range(BASE_APP_ADDRESS, 0u - BASE_APP_ADDRESS));
+
+    /*Entry outside the load range or not aligned for VTOR*/
+    manifest.entry_address = BASE_APP_ADDRESS + 0x1000u;
+    CHECK(0u == App_manifest_check(&manifest));
+    manifest.entry_address = BASE_APP_ADDRESS - VECTOR_TABLE_ALIGNMENT;
+    CHECK(0u == App_manifest_check(&manifest));
+    manifest.entry_address = BASE_APP_ADDRESS + 0x80u;
+    CHECK(0u == App_manifest_check(&manifest));
+    manifest.entry_address = BASE_APP_ADDRESS + VECTOR_TABLE_ALIGNMENT;
+    CHECK(1u == App_manifest_check(&manifest));
+
+    /*Unknown flag*/
+    manifest.flags = APP_MANIFEST_FLAG_CRC | 0x80u;
+    CHECK(0u == App_manifest_check(&manifest));
+
+    /*No manifest*/
+    CHECK(0u == App_manifest_check(0));
+
+    return CHECK_DONE("test_app_manifest");
+}
+/*EOF*/
@@ -0,0 +1,722 @@
+/**
+ * @file  : test_board.c
+ * @author: Nguyen The Anh.
+ * @brief : Host board: the bootloader of main.c on a model of the flash, UART0 line and clock of the MKL46Z.
+ * @version: 0.0
+ *
+ * Usage: test_board [-boot] [-weak <address>] [-pty <link>] <flash file>
+ *
+ * One run is one boot of the board, from reset to the jump to the App, the end of main() or a
+ * reset. The flash file is the 256 KB of program flash, mapped at its address and kept from one
+ * boot to the next: a new file starts erased. -boot holds the boot switch.
+ *
+ * The line is stdin and stdout, or with -pty a pseudo-terminal whose slave is linked at <link>
+ * for a host tool that opens a serial port. The frames of the host reach UART0 one after the
+ * other at the baud rate of its divisor, from the time they are read. With 9-bit frames (C1[M])
+ * a frame takes two bytes on the line, the ninth bit then the data, and the match address mode
+ * of C4[MAEN1] and C4[MAEN2] keeps only the address frames equal to MA1 or MA2: the data frames
+ * are discarded while it is on. A first byte of 2 is a pause of the host, a frame time of idle
+ * line: a multi-drop host waits so for the flash work of nodes that can not answer. A frame received while the interrupts are masked waits in D, the
+ * next one sets S1[OR] and is lost. A byte written to D is sent on the line at once. The UART0
+ * register block is mapped at UART0_BASE and its writes trap as the FTFA ones in test_flash.
+ *
+ * FLASH.c runs on the FTFA model of ftfa_model.c over the mapped flash file: a command takes its
+ * typical time of the data sheet, the erase of the other block runs in background while the
+ * line is received and its interrupt wakes the core. The sectors below the App information are
+ * protected, a command on them is a violation as a longword programmed twice. -weak programs
+ * the longword at <address> weak: it reads its data and fails the margin reads. The clock is the
+ * model clock of test_event, the code takes no time: the line and the flash move it, the WFI
+ * takes the next interrupt.
+ *
+ * Limit of the model: it stops at the flash and UART0. The MCG, SIM, PORT and GPIO drivers are
+ * pass-through stand-ins that give the PEE profile (48 MHz core and UART0 clock) and the boot
+ * switch. Their registers are not modelled, so the clock setup, clock gates, pin muxing and LED
+ * of the bootloader are not checked here. SCB and NVIC are the RAM blocks of mock/MKL46Z4.h: the
+ * vector table offset set for the jump is seen, the exception model is not. The register traps
+ * use the trap flag and the fault registers of x86-64 Linux, the board runs there only.
+ *
+ * The boot ends on the jump to the App: the fetch of its entry faults, the flash is not
+ * executable. It also ends at the end of main(), and when the core waits with the line closed by
+ * the host or on SIGTERM: the host resets the board. A line on stderr gives the end, the model
+ * time and the flash work. On a pty the board then waits for the host tool to close the port. Exits 1 on a violation, 77 if the flash can not be mapped.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "MKL46Z4.h"
+#include "Driver/Driver_core.h"
+#include "Driver/Driver_GPIO.h"
+#include "Driver/Driver_MCG.h"
+#include "Driver/Driver_PORT.h"
+#include "Driver/Driver_SIM.h"
+#include "HAL/FLASH.h"
+#include "Flash_layout.h"
+#include "ftfa_model.h"
+/*After the device header: CR0 and CR1 of termios name CMP registers in it*/
+#include <termios.h>
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Core and UART0 clock of the PEE profile, bus and flash clock*/
+#define MODEL_CORE_CLOCK (48000000u)
+#define MODEL_BUS_CLOCK  (24000000u)
+#define MODEL_PLL_CLOCK  (96000000u)
+
+/*\Cycles of a SysTick period and of a microsecond*/
+#define MODEL_PERIOD ((uint64_t)SYSTICK_RELOAD_VALUE + 1u)
+#define MODEL_US(us) ((uint64_t)(us) * (MODEL_CORE_CLOCK / 1000000u))
+
+/*\S1 flags a write of 1 clears*/
+#define MODEL_S1_ERROR_CLEAR (UART0_S1_OR_MASK | UART0_S1_NF_MASK | UART0_S1_FE_MASK | UART0_S1_PF_MASK)
+
+/*\x86 EFLAGS trap flag: one instruction then SIGTRAP*/
+#define MODEL_TRAP_FLAG (0x100)
+
+/*\First byte of a 9-bit frame on the line: ninth bit, or a pause of the host*/
+#define MODEL_FRAME_NINTH_BIT (0x01u)
+#define MODEL_FRAME_PAUSE     (0x02u)
+
+/*\Bytes of the line read ahead*/
+#define MODEL_LINE_BUFFER (4096u)
+
+/*\Longest wait for the host tool to close the pty at the end, in milliseconds*/
+#define MODEL_PTY_CLOSE_MS (10000)
+
+/*******************************************************************************
+ * Struct
+ ******************************************************************************/
+
+/*State of the board model*/
+typedef struct board_model
+{
+    uint64_t clock;          /*Model clock, in core cycles since the reset*/
+    uint64_t line_free;      /*End of the last frame on the line*/
+    uint64_t frame_time;     /*End of the next frame, if frame_ready*/
+    uint32_t lost_frames;    /*Frames lost on an overrun or with the receiver off*/
+    uint16_t frame;          /*Next frame: ninth bit and data*/
+    uint8_t frame_ready;     /*1 if the next frame has been read from the line*/
+    uint8_t line_end;        /*1 once the host has closed the line*/
+} board_model;
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*Register blocks and core registers of the device header, UART0 is at its address*/
+SysTick_Type g_mock_systick;
+SCB_Type g_mock_scb;
+NVIC_Type g_mock_nvic;
+uint32_t g_mock_primask = 0;
+uint32_t g_mock_msp = 0;
+void (*g_mock_wfi)(void) = 0;
+
+/*Stack limits of the linker file, given to the link*/
+extern uint32_t __StackLimit;
+extern uint32_t __StackTop;
+
+/*This variable stores the state of the model*/
+static board_model s_model;
+
+/*This variable stores the boot switch: 0 while it is held*/
+static uint8_t s_boot_switch = 1;
+
+/*This variable stores the line: descriptors, the bytes read ahead and the pty link*/
+static int s_line_in = 0;
+static int s_line_out = 1;
+static uint8_t s_line_buffer[MODEL_LINE_BUFFER];
+static size_t s_line_head = 0;
+static size_t s_line_count = 0;
+static const char *s_pty_link = NULL;
+static int s_pty_slave = -1;
+
+/*This variable stores the UART0 register written by the instruction that trapped*/
+static uint8_t s_access_pending = 0;
+static uintptr_t s_access_offset = 0;
+static uint8_t s_access_s1 = 0;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+void UART0_IRQHandler(void);
+void SysTick_Handler(void);
+int Boot_reset(void);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Stand-ins of the modules the bootloader calls, see the limit of the model above*/
+void Driver_PORT_set_MUX_pin(Port_type_enum_t port_type, uint8_t pin, Mux_type_enum_t mux_type)
+{
+    (void)port_type;
+    (void)pin;
+    (void)mux_type;
+}
+
+void Driver_SIM_SOPT2_init(SOPT2_config_info *SOPT2_config)
+{
+    (void)SOPT2_config;
+}
+
+void Driver_SIM_SCGC4_init_clock(SCGC4_config_info *SCGC4_config)
+{
+    (void)SCGC4_config;
+}
+
+void Driver_SIM_SCGC4_set_UART0_clock_gate(clock_gate_state_enum_t uart0_clock_gate)
+{
+    (void)uart0_clock_gate;
+}
+
+void Driver_SIM_SCGC5_init_clock(SCGC5_config_info *SCGC5_clock_config)
+{
+    (void)SCGC5_clock_config;
+}
+
+void Driver_SIM_SCGC5_set_PORTn_clock_gate(Port_type_enum_t port, clock_gate_state_enum_t PORTn_gate)
+{
+    (void)port;
+    (void)PORTn_gate;
+}
+
+void Driver_MCG_Init_clock(MCG_clock_config_info *clock_config)
+{
+    (void)clock_config;
+}
+
+void Driver_MCG_get_clock_frequency(MCG_clock_config_info *clock_config, MCG_clock_frequency_info *frequency)
+{
+    (void)clock_config;
+    frequency->MCGOUTCLK = MODEL_PLL_CLOCK;
+    frequency->MCGFLLCLK = 0;
+    frequency->MCGPLLCLK = MODEL_PLL_CLOCK;
+    frequency->core_clock = MODEL_CORE_CLOCK;
+    frequency->bus_clock = MODEL_BUS_CLOCK;
+    frequency->peripheral_clock = MODEL_PLL_CLOCK / 2u;
+}
+
+void Driver_GPIO_init_pin(GPIO_config_info_t *GPIO_info)
+{
+    (void)GPIO_info;
+}
+
+void Driver_GPIO_deinit_pin(Port_type_enum_t port_type, uint8_t pin)
+{
+    (void)port_type;
+    (void)pin;
+}
+
+void Driver_GPIO_set_pin_State(Port_type_enum_t port_type, uint8_t pin, Pin_state_enum_t state)
+{
+    (void)port_type;
+    (void)pin;
+    (void)state;
+}
+
+/*The only input is the boot switch*/
+uint8_t Driver_GPIO_read_pin_state(Port_type_enum_t port_type, uint8_t pin)
+{
+    (void)port_type;
+    (void)pin;
+
+    return s_boot_switch;
+}
+
+/*End the boot: report it on stderr and leave*/
+static void board_end(const char *end)
+{
+    char report[256];
+    int length = snprintf(report, sizeof(report),
+                          "test_board: %s after %llu ms, %u sector erases, %u block erases, "
+                          "%u longwords programmed, %u frames lost, %u violations\n",
+                          end, (unsigned long long)(s_model.clock / (MODEL_CORE_CLOCK / 1000u)),
+                          g_ftfa_model.sector_erases, g_ftfa_model.block_erases, g_ftfa_model.programs,
+                          s_model.lost_frames, g_ftfa_model.violations);
+    struct pollfd host = {.fd = s_line_out, .events = 0};
+
+    if (length > 0)
+    {
+        (void)write(2, report, (size_t)length);
+    }
+    if (NULL != s_pty_link)
+    {
+        /*The board stays powered until the host tool closes the port: the lines it has not
+          read yet are lost with the master*/
+        (void)unlink(s_pty_link);
+        (void)close(s_pty_slave);
+        (void)poll(&host, 1, MODEL_PTY_CLOSE_MS);
+    }
+    _exit((0u != g_ftfa_model.violations) ? 1 : 0);
+}
+
+/*The model writes the UART0 registers with the page open*/
+static void model_set_register(volatile uint8_t *reg, uint8_t value)
+{
+    (void)mprotect((void *)UART0_BASE, MODEL_PAGE_SIZE, PROT_READ | PROT_WRITE);
+    *reg = value;
+    (void)mprotect((void *)UART0_BASE, MODEL_PAGE_SIZE, PROT_READ);
+}
+
+/*SysTick counts down from its reload value*/
+static void model_set_systick(void)
+{
+    g_mock_systick.VAL = SYSTICK_RELOAD_VALUE - (uint32_t)(s_model.clock % MODEL_PERIOD);
+}
+
+/*Cycles of a frame at the UART0 divisor: start, data, ninth, parity and stop bits*/
+static uint64_t model_frame_cycles(void)
+{
+    uint32_t sbr = ((uint32_t)(UART0->BDH & UART0_BDH_SBR_MASK) << 8u) | UART0->BDL;
+    uint32_t osr = (uint32_t)(UART0->C4 & UART0_C4_OSR_MASK) + 1u;
+    uint32_t bits = 10u + ((0u != (UART0->C1 & UART0_C1_M_MASK)) ? 1u : 0u) +
+                    ((0u != (UART0->C1 & UART0_C1_PE_MASK)) ? 1u : 0u);
+
+    return (uint64_t)bits * osr * ((0u != sbr) ? sbr : 1u);
+}
+
+/*Read the line ahead, wait for the host if block*/
+static void model_line_fill(uint8_t block)
+{
+    struct pollfd line = {.fd = s_line_in, .events = POLLIN};
+    ssize_t count = 0;
+
+    memmove(s_line_buffer, &s_line_buffer[s_line_head], s_line_count - s_line_head);
+    s_line_count -= s_line_head;
+    s_line_head = 0;
+    if ((0u == s_model.line_end) && (0 < poll(&line, 1, (0u != block) ? -1 : 0)))
+    {
+        count = read(s_line_in, &s_line_buffer[s_line_count], sizeof(s_line_buffer) - s_line_count);
+        if (count > 0)
+        {
+            s_line_count += (size_t)count;
+        }
+        else if ((0 == count) || ((EINTR != errno) && (EAGAIN != errno)))
+        {
+            s_model.line_end = 1;
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+}
+
+/*Take the next frame of the line, wait for the host if block, return 0 if it has not sent it*/
+static uint8_t model_next_frame(uint8_t block)
+{
+    size_t size = (0u != (UART0->C1 & UART0_C1_M_MASK)) ? 2u : 1u;
+    uint8_t wait = 1;
+
+    while ((0u == s_model.frame_ready) && (0u != wait))
+    {
+        if ((s_line_count - s_line_head) < size)
+        {
+            model_line_fill(block);
+        }
+
+        if ((s_line_count - s_line_head) < size)
+        {
+            wait = ((0u != block) && (0u == s_model.line_end)) ? 1u : 0u;
+        }
+        /*A pause of the host: the line stays idle for a frame time*/
+        else if ((2u == size) && (0u != (s_line_buffer[s_line_head] & MODEL_FRAME_PAUSE)))
+        {
+            s_model.line_free = ((s_model.line_free > s_model.clock) ? s_model.line_free : s_model.clock) +
+                                model_frame_cycles();
+            s_line_head += size;
+        }
+        else
+        {
+            s_model.frame = (2u == size) ? (uint16_t)(((s_line_buffer[s_line_head] & MODEL_FRAME_NINTH_BIT) << 8u) |
+                                                      s_line_buffer[s_line_head + 1u]) :
+                                           s_line_buffer[s_line_head];
+            s_line_head += size;
+            s_model.frame_time = ((s_model.line_free > s_model.clock) ? s_model.line_free : s_model.clock) +
+                                 model_frame_cycles();
+            s_model.line_free = s_model.frame_time;
+            s_model.frame_ready = 1;
+        }
+    }
+
+    return s_model.frame_ready;
+}
+
+/*Run the receive interrupt of a frame waiting in D*/
+static uint8_t model_take_interrupt(uint8_t masked)
+{
+    uint8_t ret_val = 0;
+
+    if ((0u == masked) && (0u != (UART0->S1 & UART0_S1_RDRF_MASK)) && (0u != (UART0->C2 & UART0_C2_RIE_MASK)))
+    {
+        UART0_IRQHandler();
+        model_set_register(&UART0->S1, UART0->S1 & (uint8_t)~UART0_S1_RDRF_MASK);
+        ret_val = 1;
+    }
+
+    return ret_val;
+}
+
+/*The frame has reached the receiver*/
+static void model_receive(uint8_t masked)
+{
+    uint8_t address = (0u != (s_model.frame & 0x100u)) ? 1u : 0u;
+    uint8_t data = (uint8_t)s_model.frame;
+    uint8_t match = ((0u != (UART0->C4 & UART0_C4_MAEN1_MASK)) && (data == UART0->MA1)) ||
+                    ((0u != (UART0->C4 & UART0_C4_MAEN2_MASK)) && (data == UART0->MA2));
+
+    s_model.frame_ready = 0;
+    if (0u == (UART0->C2 & UART0_C2_RE_MASK))
+    {
+        s_model.lost_frames++;
+    }
+    /*The match address mode discards the data frames and the other addresses*/
+    else if ((0u != (UART0->C4 & (UART0_C4_MAEN1_MASK | UART0_C4_MAEN2_MASK))) && ((0u == address) || (0u == match)))
+    {
+        /*Do nothing*/
+    }
+    else if (0u != (UART0->S1 & UART0_S1_RDRF_MASK))
+    {
+        model_set_register(&UART0->S1, UART0->S1 | UART0_S1_OR_MASK);
+        s_model.lost_frames++;
+    }
+    else
+    {
+        model_set_register(&UART0->C3, (UART0->C3 & (uint8_t)~UART0_C3_R8T9_MASK) | ((0u != address) ? UART0_C3_R8T9_MASK : 0u));
+        model_set_register(&UART0->D, data);
+        model_set_register(&UART0->S1, UART0->S1 | UART0_S1_RDRF_MASK);
+    }
+    (void)model_take_interrupt(masked);
+}
+
+/*Cycle of the end of the running flash command, UINT64_MAX if the FTFA is idle*/
+static uint64_t model_flash_end(void)
+{
+    uint64_t end_us = ftfa_model_next_us();
+
+    return (UINT64_MAX != end_us) ? MODEL_US(end_us) : UINT64_MAX;
+}
+
+/*Move the clock to a time, taking the interrupts due on the way*/
+static void model_advance(uint64_t until)
+{
+    uint64_t next_reload = 0;
+    uint64_t next = 0;
+    uint8_t masked = (0u != g_mock_primask) ? 1u : 0u;
+
+    (void)model_take_interrupt(masked);
+    ftfa_model_run();
+    while (s_model.clock < until)
+    {
+        next_reload = ((s_model.clock / MODEL_PERIOD) + 1u) * MODEL_PERIOD;
+        next = ((0u != model_next_frame(0)) && (s_model.frame_time < next_reload)) ? s_model.frame_time : next_reload;
+        next = (model_flash_end() < next) ? model_flash_end() : next;
+        s_model.clock = (until < next) ? until : next;
+        model_set_systick();
+        if ((0u != s_model.frame_ready) && (s_model.clock == s_model.frame_time))
+        {
+            model_receive(masked);
+        }
+        else if (s_model.clock == model_flash_end())
+        {
+            ftfa_model_run();
+        }
+        else if (s_model.clock == next_reload)
+        {
+            SysTick_Handler();
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+    }
+}
+
+/*WFI: sleep until the next interrupt, its handler runs as the interrupts are restored. The host is
+ *waited for while the flash is idle, a running command ends on its own*/
+static void model_wfi(void)
+{
+    uint64_t next = ((s_model.clock / MODEL_PERIOD) + 1u) * MODEL_PERIOD;
+    uint8_t flash_busy = (UINT64_MAX != model_flash_end()) ? 1u : 0u;
+
+    if (0u == model_take_interrupt(0))
+    {
+        if (0u != model_next_frame((0u != flash_busy) ? 0u : 1u))
+        {
+            next = (s_model.frame_time < next) ? s_model.frame_time : next;
+        }
+        else if (0u == flash_busy)
+        {
+            board_end("reset by the host");
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+        model_advance((model_flash_end() < next) ? model_flash_end() : next);
+    }
+}
+
+/*Clock of the FTFA model: the code waits on a command, the interrupts due meanwhile are taken*/
+static uint64_t model_get_us(void)
+{
+    return s_model.clock / (MODEL_CORE_CLOCK / 1000000u);
+}
+
+static void model_run_until(uint64_t us)
+{
+    model_advance(MODEL_US(us));
+}
+
+static const ftfa_model_clock s_flash_clock = {
+    .get_us = model_get_us,
+    .run_until = model_run_until,
+};
+
+/*A write of the code to a UART0 register: run its instruction alone with the page open*/
+static void model_on_fault(int signal_number, siginfo_t *info, void *context)
+{
+    ucontext_t *user_context = (ucontext_t *)context;
+    uintptr_t address = (uintptr_t)info->si_addr;
+    char end[64];
+
+    if ((address - UART0_BASE) < MODEL_PAGE_SIZE)
+    {
+        s_access_pending = 1;
+        s_access_offset = address - UART0_BASE;
+        s_access_s1 = UART0->S1;
+        (void)mprotect((void *)UART0_BASE, MODEL_PAGE_SIZE, PROT_READ | PROT_WRITE);
+        user_context->uc_mcontext.gregs[REG_EFL] |= MODEL_TRAP_FLAG;
+    }
+    /*The FTFA registers, a block under command*/
+    else if (0u != ftfa_model_on_fault(info, user_context))
+    {
+        /*Do nothing*/
+    }
+    /*The core fetches the entry of the App: the jump*/
+    else if ((uintptr_t)user_context->uc_mcontext.gregs[REG_RIP] == address)
+    {
+        snprintf(end, sizeof(end), "jump to the App entry 0x%08X", (unsigned int)address);
+        board_end(end);
+    }
+    else
+    {
+        /*Not a model access: crash on it*/
+        signal(signal_number, SIG_DFL);
+    }
+}
+
+/*The instruction has run: send the data written, take the flags cleared and close the page again*/
+static void model_on_trap(int signal_number, siginfo_t *info, void *context)
+{
+    ucontext_t *user_context = (ucontext_t *)context;
+    uint8_t byte = 0;
+
+    (void)signal_number;
+    (void)info;
+
+    if (0u == s_access_pending)
+    {
+        /*An access of the FTFA model: it closes its page and clears the trap flag*/
+        (void)ftfa_model_on_trap(user_context);
+    }
+    else
+    {
+        s_access_pending = 0;
+        if (offsetof(UART0_Type, D) == s_access_offset)
+        {
+            byte = UART0->D;
+            if (0u != (UART0->C2 & UART0_C2_TE_MASK))
+            {
+                (void)write(s_line_out, &byte, 1u);
+            }
+        }
+        else if (offsetof(UART0_Type, S1) == s_access_offset)
+        {
+            UART0->S1 = s_access_s1 & (uint8_t)~(UART0->S1 & MODEL_S1_ERROR_CLEAR);
+        }
+        else
+        {
+            /*Do nothing*/
+        }
+        (void)mprotect((void *)UART0_BASE, MODEL_PAGE_SIZE, PROT_READ);
+        user_context->uc_mcontext.gregs[REG_EFL] &= ~MODEL_TRAP_FLAG;
+    }
+}
+
+/*A reset of the host tool, SIGTERM: the boot ends where it is, the flash keeps what it holds*/
+static void model_on_reset(int signal_number)
+{
+    (void)signal_number;
+
+    board_end("reset by the host");
+}
+
+/*Open the pseudo-terminal of the line and link its slave, return 0 on a failure*/
+static uint8_t board_open_pty(const char *link)
+{
+    struct termios settings;
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    const char *slave_name = NULL;
+    int slave = -1;
+    uint8_t ret_val = 0;
+
+    if ((master >= 0) && (0 == grantpt(master)) && (0 == unlockpt(master)))
+    {
+        slave_name = ptsname(master);
+        /*The slave stays open: the master reads no hang-up while the host tool reopens it*/
+        slave = (NULL != slave_name) ? open(slave_name, O_RDWR | O_NOCTTY) : -1;
+    }
+    if ((slave >= 0) && (0 == tcgetattr(slave, &settings)))
+    {
+        cfmakeraw(&settings);
+        (void)tcsetattr(slave, TCSANOW, &settings);
+        (void)unlink(link);
+        if (0 == symlink(slave_name, link))
+        {
+            s_line_in = master;
+            s_line_out = master;
+            s_pty_link = link;
+            s_pty_slave = slave;
+            ret_val = 1;
+        }
+    }
+
+    return ret_val;
+}
+
+/*Map the flash file on the FTFA model, the RAM and the UART0 page, return 0 on a failure*/
+static uint8_t board_map(const char *name, uint32_t weak_address)
+{
+    struct sigaction action;
+    uint8_t erased[FLASH_SECTOR_SIZE];
+    int file = open(name, O_RDWR | O_CREAT, 0644);
+    off_t size = (file >= 0) ? lseek(file, 0, SEEK_END) : 0;
+    uint32_t i = 0;
+    uint8_t flash = 0;
+    void *ram = NULL;
+    void *uart = NULL;
+
+    /*A new flash file starts erased*/
+    memset(erased, 0xFF, sizeof(erased));
+    for (i = (uint32_t)size; (file >= 0) && (i < FLASH_TOTAL_SIZE); i += FLASH_SECTOR_SIZE)
+    {
+        if ((ssize_t)sizeof(erased) != pwrite(file, erased, sizeof(erased), i))
+        {
+            close(file);
+            file = -1;
+        }
+    }
+    if (file >= 0)
+    {
+        flash = ftfa_model_init(file, &s_flash_clock);
+        close(file);
+    }
+    ram = mmap((void *)RAM_BASE_ADDRESS, RAM_TOTAL_SIZE, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    uart = mmap((void *)UART0_BASE, MODEL_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if ((0u == flash) || ((void *)RAM_BASE_ADDRESS != ram) || ((void *)UART0_BASE != uart))
+    {
+        return 0;
+    }
+
+    /*The bootloader sectors are protected*/
+    g_ftfa_model.protected_end = APP_INFO_ADDRESS;
+    g_ftfa_model.weak_address = weak_address;
+
+    /*The interrupts taken while the code waits on a flash command run inside its trap: their own
+     *register accesses trap again*/
+    memset(&action, 0, sizeof(action));
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    action.sa_sigaction = model_on_fault;
+    sigaction(SIGSEGV, &action, NULL);
+    action.sa_sigaction = model_on_trap;
+    sigaction(SIGTRAP, &action, NULL);
+    signal(SIGTERM, model_on_reset);
+
+    /*UART0 after reset: transmitter idle*/
+    UART0->S1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+    (void)mprotect((void *)UART0_BASE, MODEL_PAGE_SIZE, PROT_READ);
+
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *flash_name = NULL;
+    uint32_t weak_address = MODEL_NO_WEAK;
+    int arg = 0;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if (0 == strcmp(argv[arg], "-boot"))
+        {
+            s_boot_switch = 0;
+        }
+        else if ((0 == strcmp(argv[arg], "-weak")) && ((arg + 1) < argc))
+        {
+            arg++;
+            weak_address = (uint32_t)strtoul(argv[arg], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[arg], "-pty")) && ((arg + 1) < argc))
+        {
+            arg++;
+            if (0u == board_open_pty(argv[arg]))
+            {
+                fprintf(stderr, "test_board: no pseudo-terminal at %s\n", argv[arg]);
+                return 2;
+            }
+        }
+        else
+        {
+            flash_name = argv[arg];
+        }
+    }
+    if (NULL == flash_name)
+    {
+        printf("usage: test_board [-boot] [-weak <address>] [-pty <link>] <flash file>\n");
+        return 2;
+    }
+    if (0u == board_map(flash_name, weak_address))
+    {
+        fprintf(stderr, "test_board: the flash, RAM or registers can not be mapped, skipped\n");
+        if (NULL != s_pty_link)
+        {
+            (void)unlink(s_pty_link);
+        }
+        return 77;
+    }
+
+    /*Reset: the stack of the linker file, the clock at 0*/
+    g_mock_msp = (uint32_t)(uintptr_t)&__StackTop;
+    g_mock_wfi = model_wfi;
+    model_set_systick();
+    signal(SIGPIPE, SIG_IGN);
+
+    (void)Boot_reset();
+    board_end("end of main");
+
+    return 0;
+}
+/*EOF*/
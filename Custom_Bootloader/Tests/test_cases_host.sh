@@ -0,0 +1,200 @@
+#!/bin/sh
+# Host run of the Bootloader_TestCases.xlsx cases on test_board
+#
+# Usage: sh test_cases_host.sh <test_board> <Bootloader_TestCases.xlsx> <log dir> <App.srec> <old App.srec>
+#        (make -C Tests, then test_cases.sh checks the logs against test_cases_baseline)
+#
+# The cases and their steps come from the workbook (test_cases.sh -list), each
+# step is done on the host board as on the bench:
+#   Hold Boot button         the next reset holds the boot switch
+#   Enter Boot Mode          reset with the boot switch held
+#   Press Reset, Reset ...   reset, the boot switch released
+#   Send flash image         srec_gang.sh sends the TEST DATA file on the pty
+#   Reset while sending      the first half of the file, then SIGTERM
+# The flash of a case holds <old App.srec>, installed by an update, or is
+# erased if its TEST CASE says "No application". The App.srec sent is
+# changed as its TEST CASE says: "wrong format" a line that is not a record,
+# "checksum" a line with its checksum changed, "below" a line moved below
+# BASE_APP_ADDRESS. Each boot adds its terminal text and the "test_board:" end
+# line to <log dir>/<TEST CASE ID>.log, a "STAT boots=N time_ms=T" line ends it:
+# T is the model time of the case, the sum of its boots. Exits 1 if a board
+# exits with a failure, 77 if the board can not be mapped here.
+
+board=$1
+workbook=$2
+logs=$3
+image=$4
+old_image=$5
+scripts=../Project_Settings/Scripts
+failed=0
+
+if [ $# -lt 5 ] || [ ! -r "$workbook" ] || [ ! -r "$image" ] || [ ! -r "$old_image" ]; then
+    echo "usage: sh test_cases_host.sh <test_board> <Bootloader_TestCases.xlsx> <log dir> <App.srec> <old App.srec>" >&2
+    exit 2
+fi
+rm -rf "$logs"
+mkdir -p "$logs" || exit 2
+
+# vary <wrong format|checksum|below> <App.srec>: the file with its middle data line changed
+vary()
+{
+    awk -v change="$1" '
+    function hex(str,    i, value)
+    {
+        value = 0
+        for (i = 1; i <= length(str); i++)
+        {
+            value = value * 16 + index("0123456789ABCDEF", toupper(substr(str, i, 1))) - 1
+        }
+        return value
+    }
+    { sub(/\r$/, "") }
+    FNR == NR { lines = FNR; next }
+    (FNR == int(lines / 2)) && (change == "wrong format") {
+        $0 = substr($0, 1, 11) "G" substr($0, 13)
+    }
+    (FNR == int(lines / 2)) && (change == "checksum") {
+        $0 = substr($0, 1, length($0) - 1) ((substr($0, length($0)) == "0") ? "1" : "0")
+    }
+    (FNR == int(lines / 2)) && (change == "below") {
+        # S2: the address moved to 0x0090xx, then the checksum of the record again
+        $0 = substr($0, 1, 4) "0090" substr($0, 9, length($0) - 10)
+        sum = 0
+        for (i = 3; i < length($0); i += 2)
+        {
+            sum += hex(substr($0, i, 2))
+        }
+        $0 = $0 sprintf("%02X", 255 - (sum % 256))
+    }
+    FNR != NR { print }' "$2" "$2"
+}
+
+# Wait for the pty link of a board, return 1 if it did not come
+wait_link()
+{
+    tries=0
+    while [ ! -L "$1" ] && [ $tries -lt 50 ]; do
+        sleep 0.1
+        tries=$((tries + 1))
+    done
+    [ -L "$1" ]
+}
+
+# Run the boot that is pending: switch, file sent and reset while sending
+boot()
+{
+    [ -n "$pending" ] || return 0
+    pending=""
+    boots=$((boots + 1))
+    switch=""
+    [ -z "$boot_switch" ] || switch=-boot
+
+    if [ -z "$send" ]; then
+        "$board" $switch "$flash" < /dev/null > "$logs/board.out" 2> "$logs/board.err"
+        status=$?
+        tr -d '\r' < "$logs/board.out" >> "$log"
+    else
+        rm -f "$logs/board.pty"
+        "$board" $switch -pty "$logs/board.pty" "$flash" < /dev/null 2> "$logs/board.err" &
+        pid=$!
+        if wait_link "$logs/board.pty"; then
+            LOG_DIR=$logs TIMEOUT=5 sh "$scripts/srec_gang.sh" "$send" "$logs/board.pty" > /dev/null
+            tr -d '\r' < "$logs/board.pty.log" >> "$log"
+            [ -z "$reset_sending" ] || kill -TERM $pid
+        fi
+        wait $pid
+        status=$?
+    fi
+    # The terminal text may end without a new line
+    [ -z "$(tail -c 1 "$log")" ] || echo >> "$log"
+    cat "$logs/board.err" >> "$log"
+    ms=$(sed -n 's/^test_board: .* after \([0-9]*\) ms.*/\1/p' "$logs/board.err")
+    time_ms=$((time_ms + ${ms:-0}))
+    if [ $status -eq 77 ]; then
+        echo "test_cases_host: the board can not be mapped here, skipped"
+        exit 77
+    elif [ $status -ne 0 ]; then
+        failed=$((failed + 1))
+        echo "test_cases_host.sh: FAIL $id boot $boots exits $status: $(cat "$logs/board.err")"
+    fi
+    send=""
+    reset_sending=""
+}
+
+# The old App, installed by an update as each case starts with it
+rm -f "$logs/board.pty"
+"$board" -boot -pty "$logs/board.pty" "$logs/old_app.flash" < /dev/null 2> "$logs/board.err" &
+pid=$!
+! wait_link "$logs/board.pty" || TIMEOUT=5 sh "$scripts/srec_gang.sh" "$old_image" "$logs/board.pty" > /dev/null
+wait $pid
+status=$?
+if [ $status -eq 77 ]; then
+    echo "test_cases_host: the board can not be mapped here, skipped"
+    exit 77
+fi
+
+tab=$(printf '\t')
+sh "$scripts/test_cases.sh" -list "$workbook" > "$logs/cases" || exit 2
+while IFS="$tab" read -r id name steps data expected; do
+    log=$logs/$id.log
+    flash=$logs/$id.flash
+    : > "$log"
+    case $(echo "$name" | tr 'A-Z' 'a-z') in
+        *"no application"*) rm -f "$flash" ;;
+        *) cp "$logs/old_app.flash" "$flash" ;;
+    esac
+    case $(echo "$name" | tr 'A-Z' 'a-z') in
+        *"wrong format"*) vary "wrong format" "$image" > "$logs/$id.srec" ;;
+        *checksum*) vary checksum "$image" > "$logs/$id.srec" ;;
+        *below*) vary below "$image" > "$logs/$id.srec" ;;
+        *) cp "$image" "$logs/$id.srec" ;;
+    esac
+    boots=0
+    time_ms=0
+    pending=""
+    hold=""
+    send=""
+    reset_sending=""
+
+    echo "$steps" | sed 's/ | /\n/g' > "$logs/steps"
+    while read -r step; do
+        case $(echo "$step" | tr 'A-Z' 'a-z') in
+            *"hold boot"*)
+                hold=1
+                ;;
+            *"enter boot mode"*)
+                boot
+                pending=1
+                boot_switch=1
+                ;;
+            *"send flash image"*)
+                send=$logs/$id.srec
+                ;;
+            *"reset while sending"*)
+                head -n "$(($(wc -l < "$send") / 2))" "$send" > "$logs/$id.half.srec"
+                send=$logs/$id.half.srec
+                reset_sending=1
+                boot
+                pending=1
+                boot_switch=""
+                ;;
+            *reset*)
+                boot
+                pending=1
+                boot_switch=$hold
+                hold=""
+                ;;
+            *)
+                echo "test_cases_host.sh: $id: no host action for the step \"$step\"" >&2
+                failed=$((failed + 1))
+                ;;
+        esac
+    done < "$logs/steps"
+    boot
+
+    echo "STAT boots=$boots time_ms=$time_ms" >> "$log"
+    echo "$id: $boots boots, $time_ms ms"
+done < "$logs/cases"
+
+rm -f "$logs"/*.flash "$logs"/*.srec "$logs"/board.* "$logs/steps"
+[ $failed -eq 0 ]
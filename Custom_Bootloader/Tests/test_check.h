@@ -0,0 +1,55 @@
+/**
+ * @file  : test_check.h
+ * @author: Nguyen The Anh.
+ * @brief : Check macro shared by the host checks of the Tests directory.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Header guard
+ ******************************************************************************/
+
+#ifndef _TEST_CHECK_H_
+#define _TEST_CHECK_H_
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdio.h>
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*Number of checks run and failed by the check program*/
+static unsigned int s_checks = 0;
+static unsigned int s_failed = 0;
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Count a check, print it with its line if it fails*/
+#define CHECK(condition)                                                     \
+    do                                                                       \
+    {                                                                        \
+        s_checks++;                                                          \
+        if (!(condition))                                                    \
+        {                                                                    \
+            s_failed++;                                                      \
+            printf("%s:%d: FAIL %s\n", __FILE__, __LINE__, #condition);      \
+        }                                                                    \
+    } while (0)
+
+/*\Print the summary of the check program, its exit status*/
+#define CHECK_DONE(name) (printf("%s: %u checks, %u failed\n", (name), s_checks, s_failed), (0u != s_failed))
+
+/*******************************************************************************
+ * End of header guard
+ ******************************************************************************/
+#endif
+/*EOF*/
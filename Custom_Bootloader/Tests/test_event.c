@@ -0,0 +1,292 @@
+/**
+ * @file  : test_event.c
+ * @author: Nguyen The Anh.
+ * @brief : Host model of the main loop over a full update: idle time and sleep cycles with WFI.
+ * @version: 0.0
+ *
+ * Usage: test_event <file.srec>
+ *
+ * The file is sent at 115200 baud on a model clock of 48 MHz core cycles. Each byte is received
+ * by UART0_IRQHandler at its time, SysTick_Handler runs at each reload and SysTick->VAL follows
+ * the clock, so Event.c and Driver_core.c measure the sleep as on the target. The WFI of the
+ * mock moves the clock to the next interrupt and takes it. The loop is the one of Boot_main:
+ * dispatch the events, handle a ready line, else wait for an event. A line costs a fixed CPU
+ * time: its decode and the programming of its longwords at the data sheet time. The same update
+ * with the loop polling the queue instead of Event_wait gives the idle time spent awake.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <string.h>
+#include "test_check.h"
+#include "MKL46Z4.h"
+#include "Driver/Driver_core.h"
+#include "Driver/Driver_UART0.h"
+#include "Driver/Driver_PORT.h"
+#include "Driver/Driver_SIM.h"
+#include "Event/Event.h"
+#include "Queue/Queque.h"
+#include "Srec/Srec.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Largest S-record file of the check*/
+#define TEST_FILE_MAX (0x20000u)
+
+/*\Core clock and a byte time at 115200 baud, 10 bits a byte*/
+#define TEST_CORE_CLOCK (48000000u)
+#define TEST_BYTE_CYCLES (TEST_CORE_CLOCK * 10u / 115200u)
+
+/*\Cycles of a SysTick period*/
+#define TEST_PERIOD ((uint64_t)SYSTICK_RELOAD_VALUE + 1u)
+
+/*\CPU time of the work, in core cycles: a receive interrupt, a pass of the loop without a line,
+  the decode of a line and the program of a longword (65 us)*/
+#define TEST_ISR_CYCLES (150u)
+#define TEST_LOOP_CYCLES (200u)
+#define TEST_DECODE_CYCLES (10000u)
+#define TEST_PROGRAM_CYCLES (65u * (TEST_CORE_CLOCK / 1000000u))
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*Register blocks and core registers of the device header*/
+UART0_Type g_mock_uart0;
+SysTick_Type g_mock_systick;
+SCB_Type g_mock_scb;
+NVIC_Type g_mock_nvic;
+uint32_t g_mock_primask = 0;
+uint32_t g_mock_msp = 0;
+void (*g_mock_wfi)(void) = 0;
+
+/*Stack limits of the linker file*/
+uint32_t __StackLimit;
+uint32_t __StackTop;
+
+/*This array stores the S-record file*/
+static uint8_t s_file[TEST_FILE_MAX];
+static size_t s_file_size = 0;
+
+/*This variable stores the model clock, the bytes sent and the arrival of the next one*/
+static uint64_t s_clock = 0;
+static size_t s_sent = 0;
+static uint64_t s_next_byte = 0;
+
+/*This variable stores the core cycles of work: lines and interrupts, the rest is idle*/
+static uint64_t s_work = 0;
+
+/*This variable stores the work areas of Boot_main*/
+static uint8_t s_received_line[QUEUE_LINE_SIZE];
+static srec_line s_record;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+void UART0_IRQHandler(void);
+void SysTick_Handler(void);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Stand-ins of the modules the drivers call, the clock gates and pins do not exist on the host*/
+void Driver_PORT_set_MUX_pin(Port_type_enum_t port_type, uint8_t pin, Mux_type_enum_t mux_type)
+{
+    (void)port_type;
+    (void)pin;
+    (void)mux_type;
+}
+
+void Driver_SIM_SCGC4_set_UART0_clock_gate(clock_gate_state_enum_t uart0_clock_gate)
+{
+    (void)uart0_clock_gate;
+}
+
+void Driver_SIM_SCGC5_set_PORTn_clock_gate(Port_type_enum_t port, clock_gate_state_enum_t PORTn_gate)
+{
+    (void)port;
+    (void)PORTn_gate;
+}
+
+/*SysTick counts down from its reload value*/
+static void model_set_systick(void)
+{
+    g_mock_systick.VAL = SYSTICK_RELOAD_VALUE - (uint32_t)(s_clock % TEST_PERIOD);
+}
+
+/*Time of the next interrupt: the next byte or the next reload*/
+static uint64_t model_next_interrupt(void)
+{
+    uint64_t next_reload = ((s_clock / TEST_PERIOD) + 1u) * TEST_PERIOD;
+
+    return ((s_sent < s_file_size) && (s_next_byte < next_reload)) ? s_next_byte : next_reload;
+}
+
+/*Move the clock to a time, taking the interrupts due on the way*/
+static void model_advance(uint64_t until)
+{
+    uint64_t next = model_next_interrupt();
+
+    while (next <= until)
+    {
+        s_clock = next;
+        model_set_systick();
+        if ((s_sent < s_file_size) && (next == s_next_byte))
+        {
+            g_mock_uart0.S1 = UART0_S1_RDRF_MASK | UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+            g_mock_uart0.D = s_file[s_sent];
+            UART0_IRQHandler();
+            g_mock_uart0.S1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+            s_sent++;
+            s_next_byte += TEST_BYTE_CYCLES;
+            s_clock += TEST_ISR_CYCLES;
+            s_work += TEST_ISR_CYCLES;
+            until = (s_clock > until) ? s_clock : until;
+        }
+        else
+        {
+            SysTick_Handler();
+        }
+        next = model_next_interrupt();
+    }
+
+    s_clock = until;
+    model_set_systick();
+}
+
+/*The CPU works on a line for a number of cycles*/
+static void model_run_cpu(uint64_t cycles)
+{
+    s_work += cycles;
+    model_advance(s_clock + cycles);
+}
+
+/*WFI: sleep until the next interrupt, the interrupt is taken at once*/
+static void model_wfi(void)
+{
+    model_advance(model_next_interrupt());
+}
+
+/*Receive the file with the loop of Boot_main, return the number of lines decoded*/
+static uint32_t run_update(uint8_t sleep, event_statistic_info *statistics)
+{
+    uart0_config_info config = {
+        .baud_rate = 115200,
+        .OSR = 16,
+        .Tx_Rx_port = PORT_A,
+        .Tx_pin = 2,
+        .Rx_pin = 1,
+        .data_mode = DATA_8BITS,
+        .parity_state = PARITY_DISABLED,
+        .stop_bit_count = ONE_STOP_BIT,
+        .transmitter_state = TRANSMITTER_ENABLED,
+        .receiver_state = RECEIVER_ENABLED,
+        .transmiter_IRQ = TRANSMIT_IRQ_DISABLED,
+        .receiver_IRQ = RECEIVE_IRQ_ENABLED,
+        .error_rate = 20,
+    };
+    uart0_rx_statistic_info rx_statistics;
+    uint32_t lines = 0;
+    uint32_t bad_lines = 0;
+
+    s_clock = 0;
+    s_sent = 0;
+    s_next_byte = TEST_BYTE_CYCLES;
+    s_work = 0;
+    model_set_systick();
+    g_mock_uart0.S1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+    Driver_UART0_init(&config, 24000000u);
+    Driver_UART0_reset_rx_statistics();
+    Driver_SysTick_start();
+    model_set_systick();
+    Event_init();
+
+    while ((s_sent < s_file_size) || (QUEUE_ELEMENT_READY == Driver_UART0_check_first_buffer()))
+    {
+        Event_dispatch();
+        if (QUEUE_ELEMENT_READY == Driver_UART0_check_first_buffer())
+        {
+            Driver_UART0_receive_string(s_received_line);
+            parse_Srecord_line(s_received_line, &s_record);
+            bad_lines += check_srec_line(&s_record, s_received_line);
+            model_run_cpu(TEST_DECODE_CYCLES + (s_record.data_word * TEST_PROGRAM_CYCLES));
+            Driver_UART0_dequeue();
+            lines++;
+        }
+        else
+        {
+            /*Idle: a pass of the loop*/
+            model_advance(s_clock + TEST_LOOP_CYCLES);
+            if (0u != sleep)
+            {
+                Event_wait();
+            }
+        }
+    }
+
+    Event_get_statistics(statistics);
+    Driver_UART0_get_rx_statistics(&rx_statistics);
+    CHECK(s_file_size == rx_statistics.received_bytes);
+    CHECK(0u == bad_lines);
+
+    printf("Update of %u lines, %s: %llu ms, idle %llu %%, sleep %llu cycles (%llu %%) in %u WFI\n", lines,
+           (0u != sleep) ? "event loop" : "busy polling", (unsigned long long)(s_clock / (TEST_CORE_CLOCK / 1000u)),
+           (unsigned long long)((s_clock - s_work) * 100u / s_clock), (unsigned long long)statistics->sleep_cycles,
+           (unsigned long long)(statistics->sleep_cycles * 100u / s_clock), statistics->sleep_count);
+
+    return lines;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *file = NULL;
+    event_statistic_info polling;
+    event_statistic_info sleeping;
+    uint64_t polling_clock = 0;
+    uint64_t polling_work = 0;
+    uint32_t lines = 0;
+
+    if (argc < 2)
+    {
+        printf("usage: test_event <file.srec>\n");
+        return 2;
+    }
+
+    file = fopen(argv[1], "rb");
+    CHECK(NULL != file);
+    if (NULL != file)
+    {
+        s_file_size = fread(s_file, 1u, sizeof(s_file), file);
+        fclose(file);
+    }
+    g_mock_wfi = model_wfi;
+
+    /*Busy polling: the idle time is spent awake*/
+    lines = run_update(0, &polling);
+    polling_clock = s_clock;
+    polling_work = s_work;
+    CHECK(0u != lines);
+    CHECK((0u == polling.sleep_cycles) && (0u == polling.sleep_count));
+
+    /*Event loop: the same update, the idle time is spent in WFI*/
+    CHECK(lines == run_update(1, &sleeping));
+    CHECK(0u != sleeping.sleep_count);
+    CHECK(sleeping.sleep_cycles <= (s_clock - s_work));
+    /*The last byte arrives at the same time, the line after it is handled within a byte time*/
+    CHECK(((s_clock + TEST_BYTE_CYCLES) > polling_clock) && ((polling_clock + TEST_BYTE_CYCLES) > s_clock));
+    /*Most of the idle time is asleep, the rest is the passes of the loop between two bytes*/
+    CHECK((sleeping.sleep_cycles * 10u) > ((s_clock - s_work) * 9u));
+    CHECK(polling_work == s_work);
+
+    return CHECK_DONE("test_event");
+}
+/*EOF*/
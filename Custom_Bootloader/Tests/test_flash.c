@@ -0,0 +1,429 @@
+/**
+ * @file  : test_flash.c
+ * @author: Nguyen The Anh.
+ * @brief : Host FTFA model running the flash layer: same-block restriction, read while write and block erase.
+ * @version: 0.0
+ *
+ * FLASH.c runs unchanged on the FTFA model of ftfa_model.c. The clock of the check moves when it
+ * runs CPU work (receiving a line) and when the code waits for a command.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <ucontext.h>
+#include "test_check.h"
+#include "ftfa_model.h"
+#include "MKL46Z4.h"
+#include "HAL/FLASH.h"
+#include "Event/Event.h"
+#include "Queue/Queque.h"
+#include "Flash_layout.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Update of the check: S3 records of 32 data bytes, 80 characters a line at 115200 baud*/
+#define TEST_LINE_DATA (32u)
+#define TEST_LINE_US   (80u * 10u * 1000000u / 115200u)
+
+/*\Image of the update: from the App base across the start of block 1*/
+#define TEST_IMAGE_SIZE (0x18000u)
+#define TEST_IMAGE_LINES (TEST_IMAGE_SIZE / TEST_LINE_DATA)
+
+/*\Bootloader and old App content before an update*/
+#define TEST_BOOT_FILL (0x5Au)
+#define TEST_OLD_APP_FILL (0x00u)
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*PRIMASK of the core intrinsics*/
+uint32_t g_mock_primask = 0;
+
+/*This variable stores the clock of the check*/
+static uint64_t s_now_us = 0;
+
+/*This variable stores the lines received and taken by the update, the reception time of the next line*/
+static uint32_t s_lines_received = 0;
+static uint32_t s_lines_taken = 0;
+static uint64_t s_receive_us = 0;
+static uint64_t s_receive_seen_us = 0;
+
+/*This variable stores the number of EVENT_FLASH_DONE posted*/
+static uint32_t s_flash_done_events = 0;
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Stand-in of the event module*/
+void Event_post(event_id_enum_t event)
+{
+    s_flash_done_events += (EVENT_FLASH_DONE == event) ? 1u : 0u;
+}
+
+/*Clock of the check: the code waits without receiving, its lines are counted by the update*/
+static uint64_t model_get_us(void)
+{
+    return s_now_us;
+}
+
+static void model_run_until(uint64_t us)
+{
+    s_now_us = (us > s_now_us) ? us : s_now_us;
+}
+
+static const ftfa_model_clock s_clock = {
+    .get_us = model_get_us,
+    .run_until = model_run_until,
+};
+
+/*A register or block access faults: run its instruction alone*/
+static void model_on_fault(int signal_number, siginfo_t *info, void *context)
+{
+    if (0u == ftfa_model_on_fault(info, (ucontext_t *)context))
+    {
+        /*Not a model access: crash on it*/
+        signal(signal_number, SIG_DFL);
+    }
+}
+
+/*The instruction has run*/
+static void model_on_trap(int signal_number, siginfo_t *info, void *context)
+{
+    (void)signal_number;
+    (void)info;
+
+    (void)ftfa_model_on_trap((ucontext_t *)context);
+}
+
+/*Map the registers and the flash, start on an idle FTFA with the interrupts enabled*/
+static uint8_t model_init(void)
+{
+    struct sigaction action;
+
+    if (0u == ftfa_model_init(-1, &s_clock))
+    {
+        return 0;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_flags = SA_SIGINFO;
+    action.sa_sigaction = model_on_fault;
+    sigaction(SIGSEGV, &action, NULL);
+    action.sa_sigaction = model_on_trap;
+    sigaction(SIGTRAP, &action, NULL);
+
+    return 1;
+}
+
+/*Idle FTFA at time 0: bootloader and old App programmed, the whole App region in use*/
+static void model_reset(void)
+{
+    while (0u != g_ftfa_model.busy)
+    {
+        s_now_us = g_ftfa_model.end_us;
+        ftfa_model_run();
+    }
+    memset(&g_ftfa_model, 0, offsetof(ftfa_model, protected_end));
+    g_ftfa_model.spinning = 0;
+    s_now_us = 0;
+
+    ftfa_model_fill(0, TEST_BOOT_FILL, BASE_APP_ADDRESS);
+    ftfa_model_fill(BASE_APP_ADDRESS, TEST_OLD_APP_FILL, FLASH_TOTAL_SIZE - BASE_APP_ADDRESS);
+}
+
+/*The CPU works for a time, the interrupt of a finished background command is taken*/
+static void model_run_cpu(uint64_t duration_us)
+{
+    s_now_us += duration_us;
+    ftfa_model_run();
+}
+
+/*Number of bytes in a range that do not hold a value*/
+static uint32_t count_not(uint32_t start, uint32_t end, uint8_t value)
+{
+    uint32_t count = 0;
+    uint32_t address = 0;
+
+    for (address = start; address < end; address++)
+    {
+        count += (value != *ftfa_model_byte(address)) ? 1u : 0u;
+    }
+
+    return count;
+}
+
+/*Longword of the update image at an address*/
+static uint32_t get_image_word(uint32_t address)
+{
+    return (address * 2654435761u) | 1u;
+}
+
+/*Number of longwords of the image not programmed*/
+static uint32_t count_image_errors(void)
+{
+    uint32_t count = 0;
+    uint32_t address = 0;
+    uint32_t word = 0;
+
+    for (address = BASE_APP_ADDRESS; address < (BASE_APP_ADDRESS + TEST_IMAGE_SIZE); address += 4u)
+    {
+        memcpy(&word, ftfa_model_byte(address), sizeof(word));
+        count += (get_image_word(address) != word) ? 1u : 0u;
+    }
+
+    return count;
+}
+
+/*Receive lines during the time the interrupts were enabled since the last call. The host
+  sends without a pause until the receive queue is full, its last line is kept free*/
+static void receive_lines(void)
+{
+    uint64_t enabled_us = s_now_us - g_ftfa_model.masked_us;
+
+    s_receive_us += enabled_us - s_receive_seen_us;
+    s_receive_seen_us = enabled_us;
+    while ((s_receive_us >= TEST_LINE_US) && (s_lines_received < TEST_IMAGE_LINES) &&
+           ((s_lines_received - s_lines_taken) < (MAX_QUEQUE_SIZE - 1u)))
+    {
+        s_lines_received++;
+        s_receive_us -= TEST_LINE_US;
+    }
+    if ((s_lines_received == TEST_IMAGE_LINES) || ((s_lines_received - s_lines_taken) == (MAX_QUEQUE_SIZE - 1u)))
+    {
+        /*The host waits*/
+        s_receive_us = 0;
+    }
+}
+
+/*Erase the App region and program the image line by line as it is received, return the total time.
+  Without background the erase runs to the end and every flash call is made with the interrupts
+  masked, as before read while write*/
+static uint64_t run_update(uint8_t background)
+{
+    uint32_t address = 0;
+    uint32_t i = 0;
+    uint8_t result = 1;
+
+    model_reset();
+    s_lines_received = 0;
+    s_lines_taken = 0;
+    s_receive_us = 0;
+    s_receive_seen_us = 0;
+    g_mock_primask = (0u != background) ? 0u : 1u;
+    if (0u != background)
+    {
+        /*Boot_main: the sectors of block 1 are erased while receiving*/
+        result &= Erase_Multi_Sector_Background(BASE_APP_ADDRESS, APP_REGION_SIZE / FLASH_SECTOR_SIZE);
+    }
+    else
+    {
+        result &= Erase_Multi_Sector(BASE_APP_ADDRESS, APP_REGION_SIZE / FLASH_SECTOR_SIZE);
+    }
+
+    for (address = BASE_APP_ADDRESS; address < (BASE_APP_ADDRESS + TEST_IMAGE_SIZE); address += TEST_LINE_DATA)
+    {
+        /*Idle until the line is received*/
+        receive_lines();
+        if (s_lines_received == s_lines_taken)
+        {
+            model_run_cpu(TEST_LINE_US - s_receive_us);
+            receive_lines();
+        }
+        s_lines_taken++;
+
+        if (0u != background)
+        {
+            (void)Flash_Background_Erase_poll();
+            result &= Flash_Background_Erase_wait(address + TEST_LINE_DATA - 1u);
+        }
+        for (i = 0; i < TEST_LINE_DATA; i += 4u)
+        {
+            result &= Program_LongWord(address + i, get_image_word(address + i));
+        }
+    }
+    if (0u != background)
+    {
+        result &= Flash_Background_Erase_wait(FLASH_DELETED_VALUE);
+    }
+    g_mock_primask = 0;
+
+    CHECK(1u == result);
+    CHECK(0u == g_ftfa_model.violations);
+    CHECK(0u == count_not(0, BASE_APP_ADDRESS, TEST_BOOT_FILL));
+    CHECK(0u == count_image_errors());
+    CHECK(0u == count_not(BASE_APP_ADDRESS + TEST_IMAGE_SIZE, FLASH_TOTAL_SIZE, 0xFFu));
+
+    printf("Update of %u KB, %s: %llu ms, flash busy %llu ms, stalled %llu ms, interrupts masked %llu ms\n",
+           TEST_IMAGE_SIZE / 1024u, (0u != background) ? "background erase" : "all masked",
+           (unsigned long long)(s_now_us / 1000u), (unsigned long long)(g_ftfa_model.busy_us / 1000u),
+           (unsigned long long)(g_ftfa_model.stall_us / 1000u), (unsigned long long)(g_ftfa_model.masked_us / 1000u));
+
+    return s_now_us;
+}
+
+/*Read while write: the update keeps receiving while block 1 is erased or programmed*/
+static void check_read_while_write(void)
+{
+    uint64_t masked_us = run_update(0);
+    uint64_t background_us = 0;
+
+    CHECK(g_ftfa_model.masked_us == g_ftfa_model.busy_us);
+    background_us = run_update(1);
+    CHECK(background_us < masked_us);
+    /*The interrupts are only masked for the commands on the boot block*/
+    CHECK(g_ftfa_model.masked_us < g_ftfa_model.busy_us);
+    printf("Read while write: interrupts enabled during %llu ms of flash commands, the update is %llu ms shorter\n",
+           (unsigned long long)((g_ftfa_model.busy_us - g_ftfa_model.masked_us) / 1000u),
+           (unsigned long long)((masked_us - background_us) / 1000u));
+
+    /*A read through the flash layer waits for the command on its block*/
+    model_reset();
+    s_flash_done_events = 0;
+    CHECK(1u == Erase_Multi_Sector_Background(FLASH_BLOCK_SIZE, 2u));
+    CHECK((0u != g_ftfa_model.busy) && (1u == g_ftfa_model.busy_block));
+    CHECK(FLASH_DELETED_VALUE == Read_FlashAddress(FLASH_BLOCK_SIZE));
+    CHECK(0u == g_ftfa_model.violations);
+
+    /*The next erase finishes while the CPU works, its interrupt wakes the main loop*/
+    g_ftfa_model.interrupts = 0;
+    s_flash_done_events = 0;
+    CHECK(1u == Flash_Background_Erase_poll());
+    model_run_cpu(MODEL_ERASE_SECTOR_US);
+    CHECK((1u == g_ftfa_model.interrupts) && (1u == s_flash_done_events));
+    CHECK(0u == Flash_Background_Erase_poll());
+    CHECK(0xFFu == Read_Flash_byte(FLASH_BLOCK_SIZE + FLASH_SECTOR_SIZE));
+    CHECK(0u == g_ftfa_model.violations);
+
+    /*The model catches a direct read of the block under command*/
+    CHECK(1u == Erase_Multi_Sector_Background(FLASH_BLOCK_SIZE + 4u * FLASH_SECTOR_SIZE, 1u));
+    (void)*(volatile uint8_t *)(uintptr_t)(FLASH_BLOCK_SIZE + 8u * FLASH_SECTOR_SIZE);
+    CHECK(1u == g_ftfa_model.violations);
+
+    /*And a command on the boot block launched without masking the interrupts*/
+    CHECK(1u == Flash_Background_Erase_wait(FLASH_DELETED_VALUE));
+    CHECK(1u == Erase_Sector(BASE_APP_ADDRESS));
+    CHECK(1u == g_ftfa_model.violations);
+    FTFA->FCCOB0 = CMD_ERASE_FLASH_SECTOR;
+    FTFA->FCCOB1 = (uint8_t)(BASE_APP_ADDRESS >> 16);
+    FTFA->FCCOB2 = (uint8_t)(BASE_APP_ADDRESS >> 8);
+    FTFA->FCCOB3 = (uint8_t)(BASE_APP_ADDRESS >> 0);
+    FTFA->FSTAT = FTFA_FSTAT_CCIF_MASK;
+    CHECK(2u == g_ftfa_model.violations);
+
+    return;
+}
+
+/*Full App wipe: block erase of the whole blocks against one sector erase per sector*/
+static void check_region_wipe(void)
+{
+    uint32_t address = 0;
+    uint64_t sector_us = 0;
+    uint8_t result = 1;
+
+    /*Before: Erase_Multi_Sector erased every sector*/
+    model_reset();
+    for (address = BASE_APP_ADDRESS; address < FLASH_TOTAL_SIZE; address += FLASH_SECTOR_SIZE)
+    {
+        result &= Erase_Sector(address);
+    }
+    sector_us = s_now_us;
+    CHECK(1u == result);
+    CHECK((APP_REGION_SIZE / FLASH_SECTOR_SIZE) == g_ftfa_model.sector_erases);
+    CHECK(0u == count_not(BASE_APP_ADDRESS, FLASH_TOTAL_SIZE, 0xFFu));
+
+    /*After: block 1 is one command, the App sectors of the boot block stay sector erases*/
+    model_reset();
+    CHECK(1u == Erase_Multi_Sector(BASE_APP_ADDRESS, APP_REGION_SIZE / FLASH_SECTOR_SIZE));
+    CHECK(1u == g_ftfa_model.block_erases);
+    CHECK(((FLASH_BLOCK_SIZE - BASE_APP_ADDRESS) / FLASH_SECTOR_SIZE) == g_ftfa_model.sector_erases);
+    CHECK(0u == count_not(0, BASE_APP_ADDRESS, TEST_BOOT_FILL));
+    CHECK(0u == count_not(BASE_APP_ADDRESS, FLASH_TOTAL_SIZE, 0xFFu));
+    CHECK(0u == g_ftfa_model.violations);
+    CHECK(s_now_us < sector_us);
+    printf("Full App wipe: %u sector erases in %llu ms before, %u sector erases and %u block erase in %llu ms after\n",
+           (APP_REGION_SIZE / FLASH_SECTOR_SIZE), (unsigned long long)(sector_us / 1000u), g_ftfa_model.sector_erases,
+           g_ftfa_model.block_erases, (unsigned long long)(s_now_us / 1000u));
+
+    /*A range short of a whole block is erased by sectors*/
+    model_reset();
+    CHECK(1u == Erase_Multi_Sector(FLASH_BLOCK_SIZE + FLASH_SECTOR_SIZE, (FLASH_BLOCK_SIZE / FLASH_SECTOR_SIZE) - 1u));
+    CHECK((0u == g_ftfa_model.block_erases) && (((FLASH_BLOCK_SIZE / FLASH_SECTOR_SIZE) - 1u) == g_ftfa_model.sector_erases));
+    CHECK(0u == count_not(FLASH_BLOCK_SIZE, FLASH_BLOCK_SIZE + FLASH_SECTOR_SIZE, TEST_OLD_APP_FILL));
+
+    /*The boot block is never erased whole*/
+    model_reset();
+    CHECK(0u == Erase_Block(FLASH_BASE_ADDRESS));
+    CHECK((0u == g_ftfa_model.block_erases) && (0u == g_ftfa_model.violations));
+    CHECK(0u == count_not(0, BASE_APP_ADDRESS, TEST_BOOT_FILL));
+
+    /*The background erase uses the block erase as well*/
+    CHECK(1u == Erase_Multi_Sector_Background(BASE_APP_ADDRESS, APP_REGION_SIZE / FLASH_SECTOR_SIZE));
+    CHECK(1u == Flash_Background_Erase_wait(FLASH_DELETED_VALUE));
+    CHECK(1u == g_ftfa_model.block_erases);
+    CHECK(0u == count_not(BASE_APP_ADDRESS, FLASH_TOTAL_SIZE, 0xFFu));
+    CHECK(0u == g_ftfa_model.violations);
+
+    return;
+}
+
+/*Margin read: the program check compares at the level of FCCOB4, a weak longword reads right and fails it*/
+static void check_margin_read(void)
+{
+    model_reset();
+    CHECK(1u == Erase_Sector(FLASH_BLOCK_SIZE));
+    CHECK(1u == Program_LongWord(FLASH_BLOCK_SIZE, 0x12345678u));
+    CHECK(1u == Program_Check_LongWord(FLASH_BLOCK_SIZE, 0x12345678u, FLASH_MARGIN_USER));
+    CHECK(1u == Program_Check_LongWord(FLASH_BLOCK_SIZE, 0x12345678u, FLASH_MARGIN_FACTORY));
+    CHECK(0u == Program_Check_LongWord(FLASH_BLOCK_SIZE, 0x12345679u, FLASH_MARGIN_USER));
+
+    /*A level that does not exist is an access error*/
+    CHECK(0u == Program_Check_LongWord(FLASH_BLOCK_SIZE, 0x12345678u, 0u));
+    CHECK(3u == g_ftfa_model.checks);
+
+    g_ftfa_model.weak_address = FLASH_BLOCK_SIZE + 4u;
+    CHECK(1u == Program_LongWord(FLASH_BLOCK_SIZE + 4u, 0x9ABCDEF0u));
+    CHECK(0x9ABCDEF0u == Read_FlashAddress(FLASH_BLOCK_SIZE + 4u));
+    CHECK(0u == Program_Check_LongWord(FLASH_BLOCK_SIZE + 4u, 0x9ABCDEF0u, FLASH_MARGIN_USER));
+    g_ftfa_model.weak_address = MODEL_NO_WEAK;
+    CHECK(0u == g_ftfa_model.violations);
+
+    /*A command on the protected flash does not run*/
+    g_ftfa_model.protected_end = APP_INFO_ADDRESS;
+    CHECK(0u == Erase_Sector(FLASH_BASE_ADDRESS));
+    CHECK(0u == count_not(0, BASE_APP_ADDRESS, TEST_BOOT_FILL));
+    CHECK((1u == g_ftfa_model.sector_erases) && (1u == g_ftfa_model.violations));
+    g_ftfa_model.protected_end = 0;
+
+    return;
+}
+
+int main(void)
+{
+    if (0u == model_init())
+    {
+        printf("test_flash: can not map the FTFA registers and the flash at their addresses\n");
+        return 1;
+    }
+
+    check_read_while_write();
+    check_region_wipe();
+    check_margin_read();
+
+    return CHECK_DONE("test_flash");
+}
+/*EOF*/
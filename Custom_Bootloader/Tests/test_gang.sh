@@ -0,0 +1,98 @@
+#!/bin/sh
+# Host check of srec_gang.sh on pseudo-terminals attached to host boards
+#
+# Usage: sh test_gang.sh <test_board> <boards> <App.srec> <App.bin>   (make -C Tests)
+#
+# Each board is test_board in boot mode on a new flash file, its line is a
+# pseudo-terminal linked at test_gang_<n>.pty. srec_gang.sh programs them all at
+# once with one more port that does not exist: that port fails, the others are
+# updated, their flash holds the image and the report counts one failure.
+
+board=$1
+boards=$2
+image=$3
+binary=$4
+scripts=../Project_Settings/Scripts
+checks=0
+failed=0
+
+# check <condition text> <status>
+check()
+{
+    checks=$((checks + 1))
+    if [ "$2" -ne 0 ]; then
+        failed=$((failed + 1))
+        echo "test_gang.sh: FAIL $1"
+    fi
+}
+
+ports=""
+pids=""
+n=0
+while [ $n -lt "$boards" ]; do
+    n=$((n + 1))
+    rm -f test_gang_$n.flash test_gang_$n.pty
+    "$board" -boot -pty test_gang_$n.pty test_gang_$n.flash 2> test_gang_$n.err &
+    pids="$pids $!"
+    ports="$ports test_gang_$n.pty"
+done
+
+# The links appear once the boards have opened their line
+tries=0
+n=0
+while [ $n -lt "$boards" ] && [ $tries -lt 50 ]; do
+    n=0
+    for port in $ports; do
+        [ -L "$port" ] && n=$((n + 1))
+    done
+    [ $n -lt "$boards" ] && sleep 0.1
+    tries=$((tries + 1))
+done
+if [ $n -lt "$boards" ]; then
+    kill $pids 2> /dev/null
+    wait
+    if grep -q "can not be mapped" test_gang_*.err 2> /dev/null; then
+        echo "test_gang: the board can not be mapped here, skipped"
+        exit 0
+    fi
+    echo "test_gang.sh: FAIL the boards did not open their line"
+    cat test_gang_*.err
+    exit 1
+fi
+
+# The boards run FLASH.c on the trapped flash model and share the CPUs of the host: the
+# end of an update takes seconds of real time, TIMEOUT waits for it (at most 255 tenths)
+# $ports is not quoted: one argument per port
+# shellcheck disable=SC2086
+report=$(TIMEOUT=250 sh "$scripts/srec_gang.sh" "$image" $ports test_gang_none.pty)
+check "srec_gang.sh exits 1 with a failed port" $(($? != 1))
+printf '%s\n' "$report"
+
+n=0
+for pid in $pids; do
+    n=$((n + 1))
+    wait "$pid"
+    check "board $n exits 0" $?
+    grep -q "end of main after .* 0 frames lost, 0 violations" test_gang_$n.err
+    check "board $n ends the update with no frame lost: $(cat test_gang_$n.err)" $?
+    printf '%s\n' "$report" | grep -q "^test_gang_$n.pty .* OK$"
+    check "board $n is reported OK" $?
+    cmp -s -n "$(wc -c < "$binary")" -i 40960:0 test_gang_$n.flash "$binary"
+    check "board $n holds the image at 0xA000" $?
+done
+
+printf '%s\n' "$report" | grep -q "^test_gang_none.pty .* NO_PORT$"
+check "the missing port is reported NO_PORT" $?
+printf '%s\n' "$report" | grep -q "^$((boards + 1)) boards, 0 skipped, 1 failed, $((boards * $(tr -d '\r' < "$image" | wc -c))) bytes"
+check "the report counts every port, one failure and the bytes of the boards" $?
+
+# Concurrent: the wall time is below the sum of the board times
+printf '%s\n' "$report" | awk -v boards="$boards" '
+    $NF == "OK" { sum += $4 }
+    / aggregate$/ { wall = $(NF - 4) }
+    END { exit !((wall > 0) && (wall * 2 < sum) && (boards > 1)) }'
+check "the boards are programmed at once" $?
+
+rm -f test_gang_*.err
+echo "test_gang: $checks checks, $failed failed"
+[ $failed -eq 0 ]
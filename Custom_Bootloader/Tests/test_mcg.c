@@ -0,0 +1,187 @@
+/**
+ * @file  : test_mcg.c
+ * @author: Nguyen The Anh.
+ * @brief : Host check of the clock tree frequency calculator for every clock profile.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <string.h>
+#include "test_check.h"
+#include "MKL46Z4.h"
+#include "Driver/Driver_MCG.h"
+#include "Driver/Driver_SIM.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Highest core clock and bus clock of the MKL46Z256*/
+#define TEST_CORE_CLOCK_MAX (48000000u)
+#define TEST_BUS_CLOCK_MAX (24000000u)
+
+/*\Value of a frequency the calculator has not written*/
+#define TEST_UNTOUCHED (0xA5A5A5A5u)
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Stand-in of the SIM driver, the calculator does not write registers*/
+void Driver_SIM_CLKDIV1_set_dividers(uint8_t core_divider, uint8_t bus_divider)
+{
+    (void)core_divider;
+    (void)bus_divider;
+}
+
+/*Clock profile of Boot_main*/
+static MCG_clock_config_info get_boot_profile(MCG_profile_enum_t profile)
+{
+    MCG_clock_config_info clock_config = {
+        .profile = profile,
+        .FLL_config = {
+            .DCO_max_frequency = DCO_FIX_TUNED_MAX_FREQUENCY,
+            .DCO_range = DCO_MID_RANGE,
+        },
+        .crystal_frequency = MCG_CRYSTAL_FREQUENCY,
+        .PLL_divider = 2,
+        .PLL_multiplier = 24,
+        .core_divider = (MCG_PROFILE_PEE == profile) ? 2 : 1,
+        .bus_divider = 2,
+    };
+
+    return clock_config;
+}
+
+/*Calculate the frequencies, every field starts untouched*/
+static MCG_clock_frequency_info get_frequency(MCG_clock_config_info *clock_config)
+{
+    MCG_clock_frequency_info frequency;
+
+    memset(&frequency, 0xA5, sizeof(frequency));
+    Driver_MCG_get_clock_frequency(clock_config, &frequency);
+
+    return frequency;
+}
+
+/*Baud rate error in per mille of the UART0 divisor Driver_UART0_update_Baud_div sets*/
+static uint32_t get_baud_error(uint32_t clock, uint32_t baud_rate, uint32_t OSR)
+{
+    uint32_t divisor = clock / (baud_rate * OSR);
+    uint32_t actual = clock / (divisor * OSR);
+
+    return ((actual > baud_rate) ? (actual - baud_rate) : (baud_rate - actual)) * 1000u / baud_rate;
+}
+
+int main(void)
+{
+    static const uint32_t FLL_factor[2][4] = {{640, 1280, 1920, 2560}, {732, 1464, 2197, 2929}};
+    MCG_clock_config_info clock_config;
+    MCG_clock_frequency_info frequency;
+    uint32_t reference = 0;
+    uint32_t expected = 0;
+    uint32_t mismatch = 0;
+    uint32_t divider = 0;
+    uint32_t multiplier = 0;
+    uint32_t i = 0;
+
+    /*PEE of Boot_main: 96 MHz PLL, 48 MHz core, 24 MHz bus, UART0 on MCGPLLCLK/2*/
+    clock_config = get_boot_profile(MCG_PROFILE_PEE);
+    frequency = get_frequency(&clock_config);
+    CHECK((96000000u == frequency.MCGPLLCLK) && (0u == frequency.MCGFLLCLK));
+    CHECK(96000000u == frequency.MCGOUTCLK);
+    CHECK((48000000u == frequency.core_clock) && (24000000u == frequency.bus_clock));
+    CHECK(48000000u == frequency.peripheral_clock);
+    CHECK(get_baud_error(frequency.peripheral_clock, 115200u, 16u) < 20u);
+
+    /*FEI out of reset, handed to the App by the fast path: 640 * 32768 Hz, bus clock /2*/
+    clock_config = get_boot_profile(MCG_PROFILE_FEI);
+    clock_config.FLL_config.DCO_max_frequency = DCO_DEFAULT_RANGE;
+    clock_config.FLL_config.DCO_range = DCO_LOW_RANGE;
+    clock_config.core_divider = 1;
+    clock_config.bus_divider = 2;
+    frequency = get_frequency(&clock_config);
+    CHECK((20971520u == frequency.core_clock) && (10485760u == frequency.bus_clock));
+    CHECK(20971520u == frequency.peripheral_clock);
+
+    /*FEI of Boot_main: DMX32 mid range, 1464 * 32768 Hz, UART0 on MCGFLLCLK*/
+    clock_config = get_boot_profile(MCG_PROFILE_FEI);
+    frequency = get_frequency(&clock_config);
+    CHECK((47972352u == frequency.MCGFLLCLK) && (0u == frequency.MCGPLLCLK));
+    CHECK((47972352u == frequency.core_clock) && (23986176u == frequency.bus_clock));
+    CHECK(47972352u == frequency.peripheral_clock);
+    CHECK((frequency.core_clock <= TEST_CORE_CLOCK_MAX) && (frequency.bus_clock <= TEST_BUS_CLOCK_MAX));
+    CHECK(get_baud_error(frequency.peripheral_clock, 115200u, 16u) < 20u);
+
+    /*Every FLL range*/
+    for (i = 0; i < (DMX32_OPTION_COUNT * DRST_DRS_OPTION_COUNT); i++)
+    {
+        clock_config = get_boot_profile(MCG_PROFILE_FEI);
+        clock_config.FLL_config.DCO_max_frequency = (DMX32_type_enum_t)(i / DRST_DRS_OPTION_COUNT);
+        clock_config.FLL_config.DCO_range = (DCO_range_type_enum_t)(i % DRST_DRS_OPTION_COUNT);
+        frequency = get_frequency(&clock_config);
+        expected = FLL_factor[i / DRST_DRS_OPTION_COUNT][i % DRST_DRS_OPTION_COUNT] * MCGFLLCLK_REFERENCE_CLOCK;
+        mismatch += ((expected != frequency.MCGOUTCLK) || (expected != frequency.peripheral_clock)) ? 1u : 0u;
+    }
+    CHECK(0u == mismatch);
+
+    /*Every PLL divider and multiplier: the PLL where it locks, else the FLL of the profile as
+     *Driver_MCG_Init_clock runs it*/
+    mismatch = 0;
+    for (divider = 1; divider <= 25u; divider++)
+    {
+        for (multiplier = MCG_PLL_MULTIPLIER_BASE - 1u; multiplier <= 55u; multiplier++)
+        {
+            clock_config = get_boot_profile(MCG_PROFILE_PEE);
+            clock_config.PLL_divider = (uint8_t)divider;
+            clock_config.PLL_multiplier = (uint8_t)multiplier;
+            frequency = get_frequency(&clock_config);
+
+            reference = MCG_CRYSTAL_FREQUENCY / divider;
+            expected = (((2000000u <= reference) && (reference <= 4000000u)) && (multiplier >= 24u) &&
+                        ((reference * multiplier) >= 48000000u) && ((reference * multiplier) <= 100000000u))
+                           ? (reference * multiplier)
+                           : 0u;
+            if (0u != expected)
+            {
+                mismatch += ((expected != frequency.MCGPLLCLK) || ((expected / 2u) != frequency.peripheral_clock) ||
+                             ((expected / 2u) != frequency.core_clock))
+                                ? 1u
+                                : 0u;
+            }
+            else
+            {
+                mismatch += ((0u != frequency.MCGPLLCLK) || (47972352u != frequency.MCGFLLCLK) ||
+                             (47972352u != frequency.peripheral_clock))
+                                ? 1u
+                                : 0u;
+            }
+        }
+    }
+    CHECK(0u == mismatch);
+
+    /*Dividers the SIM driver ignores are ignored, nothing is written*/
+    clock_config = get_boot_profile(MCG_PROFILE_PEE);
+    clock_config.core_divider = 0;
+    frequency = get_frequency(&clock_config);
+    CHECK(TEST_UNTOUCHED == frequency.core_clock);
+    clock_config.core_divider = 17;
+    frequency = get_frequency(&clock_config);
+    CHECK(TEST_UNTOUCHED == frequency.core_clock);
+    clock_config.core_divider = 16;
+    clock_config.bus_divider = 9;
+    frequency = get_frequency(&clock_config);
+    CHECK(TEST_UNTOUCHED == frequency.bus_clock);
+    clock_config.bus_divider = 8;
+    frequency = get_frequency(&clock_config);
+    CHECK((6000000u == frequency.core_clock) && (750000u == frequency.bus_clock));
+
+    return CHECK_DONE("test_mcg");
+}
+/*EOF*/
@@ -0,0 +1,570 @@
+/**
+ * @file  : test_multidrop.c
+ * @author: Nguyen The Anh.
+ * @brief : Multi-drop update of host boards on a simulated shared line: broadcast, then collect and retransmit per node.
+ * @version: 0.0
+ *
+ * Usage: test_multidrop <board> <node board prefix> <nodes> <file.srec>
+ *
+ * Each node is a test_board built with BOOT_NODE_ADDRESS, started in boot mode on an erased
+ * flash file. The line is shared: every frame of the host reaches every node, as 9-bit frames
+ * of test_board. The nodes can not answer on the shared line: the host sends the file once
+ * after the broadcast address, with one line corrupted on the wire of node 2 only, then pauses
+ * for the nodes to erase the old App, program the staged image and verify it. Each node
+ * is then addressed in turn: #STATUS gives its rejected lines, a #CRC or #SECTORS argument that
+ * does not fit in 32 bits must be refused, #SECTORS gives the CRC of its sectors,
+ * the records of each sector that differs from the file are sent again with #PACE, and #COMMIT
+ * ends its update. The node reports its result and its boot ends. A node that is not addressed
+ * must stay silent. Every flash must hold the image, no frame may be lost, and the fleet update,
+ * the model time of the last node, is compared with the point-to-point update of one board with
+ * <board>, N x T without the shared line.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test_check.h"
+#include "Queue/Queque.h"
+#include "Srec/Srec.h"
+#include "Crc/Crc32.h"
+#include "Flash_layout.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Largest S-record file and number of lines of the check*/
+#define TEST_FILE_MAX  (0x20000u)
+#define TEST_LINES_MAX (4096u)
+
+/*\Largest number of nodes, and of bytes kept of a node answer*/
+#define TEST_NODES_MAX  (8u)
+#define TEST_ANSWER_MAX (0x10000u)
+
+/*\Address frame received by every node, as BOOT_BROADCAST_ADDRESS of Update.h*/
+#define TEST_BROADCAST_ADDRESS (0xFFu)
+
+/*\First byte of a 9-bit frame of test_board: data, address or pause*/
+#define TEST_FRAME_DATA    (0x00u)
+#define TEST_FRAME_ADDRESS (0x01u)
+#define TEST_FRAME_PAUSE   (0x02u)
+
+/*\Time of a 9-bit frame at 115200 baud, 11 bits, and the data sheet times of the flash work, in us*/
+#define TEST_FRAME_US           (96u)
+#define TEST_ERASE_SECTOR_US    (14000u)
+#define TEST_PROGRAM_LONGWORD_US (65u)
+
+/*\Line of the file corrupted on the wire of node 2*/
+#define TEST_CORRUPT_LINE (10u)
+
+/*\Real time a node has to answer, in ms*/
+#define TEST_ANSWER_TIMEOUT_MS (10000)
+
+/*******************************************************************************
+ * Struct
+ ******************************************************************************/
+
+/*A node board on the line*/
+typedef struct test_node
+{
+    pid_t pid;                       /*Process of the board*/
+    int line_in;                     /*Frames of the host*/
+    int line_out;                    /*Bytes sent by the node*/
+    int report;                      /*stderr of the board*/
+    uint8_t live;                    /*1 until the boot of the node has ended*/
+    char answer[TEST_ANSWER_MAX];    /*Bytes sent since the last command*/
+    size_t answer_length;
+} test_node;
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*This array stores the S-record file and the start of each line*/
+static char s_file[TEST_FILE_MAX];
+static size_t s_file_size = 0;
+static size_t s_line_start[TEST_LINES_MAX + 1u];
+static uint32_t s_line_count = 0;
+
+/*This array stores the image of the file in flash and its range*/
+static uint8_t s_image[FLASH_TOTAL_SIZE];
+static uint32_t s_image_start = FLASH_TOTAL_SIZE;
+static uint32_t s_image_end = 0;
+
+/*This array stores the nodes*/
+static test_node s_nodes[TEST_NODES_MAX + 1u];
+static uint32_t s_node_count = 0;
+
+/*This variable stores the bytes sent by a node that was not addressed*/
+static size_t s_chatter = 0;
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Start a board in boot mode on a new flash file*/
+static void node_start(test_node *node, const char *board, const char *flash)
+{
+    int line_in[2];
+    int line_out[2];
+    int report[2];
+
+    (void)unlink(flash);
+    memset(node, 0, offsetof(test_node, answer));
+    /*The pipes of the host are not inherited: a node sees the end of its line once the host closes it*/
+    if ((0 == pipe2(line_in, O_CLOEXEC)) && (0 == pipe2(line_out, O_CLOEXEC)) && (0 == pipe2(report, O_CLOEXEC)))
+    {
+        node->pid = fork();
+        if (0 == node->pid)
+        {
+            dup2(line_in[0], 0);
+            dup2(line_out[1], 1);
+            dup2(report[1], 2);
+            execl(board, board, "-boot", flash, (char *)NULL);
+            _exit(127);
+        }
+        close(line_in[0]);
+        close(line_out[1]);
+        close(report[1]);
+        node->line_in = line_in[1];
+        node->line_out = line_out[0];
+        node->report = report[0];
+        node->live = (node->pid > 0) ? 1u : 0u;
+    }
+    node->answer_length = 0;
+    node->answer[0] = '\0';
+}
+
+/*Wait for the end of the boot of a node, return its model time in ms or 0*/
+static unsigned long node_end(test_node *node, int *status)
+{
+    char report[512];
+    ssize_t length = 0;
+    const char *time = NULL;
+
+    close(node->line_in);
+    length = read(node->report, report, sizeof(report) - 1u);
+    report[(length > 0) ? length : 0] = '\0';
+    close(node->report);
+    close(node->line_out);
+    (void)waitpid(node->pid, status, 0);
+    node->live = 0;
+    fputs(report, stdout);
+    time = strstr(report, " after ");
+
+    return ((NULL != strstr(report, "end of main")) && (NULL != strstr(report, " 0 frames lost")) && (NULL != time)) ?
+               strtoul(time + 7, NULL, 10) :
+               0u;
+}
+
+/*Send frames on the line: every live node receives them, a node in `noisy` gets `noise` instead*/
+static void line_send(const uint8_t *frames, const uint8_t *noise, size_t size, uint32_t noisy)
+{
+    uint32_t i = 0;
+
+    for (i = 1; i <= s_node_count; i++)
+    {
+        if (0u != s_nodes[i].live)
+        {
+            (void)write(s_nodes[i].line_in, (i == noisy) ? noise : frames, size);
+        }
+    }
+}
+
+/*Send an address frame*/
+static void line_send_address(uint8_t address)
+{
+    uint8_t frame[2] = {TEST_FRAME_ADDRESS, address};
+
+    line_send(frame, frame, sizeof(frame), 0);
+}
+
+/*Send text as data frames, the node in noisy receives it with a digit changed*/
+static void line_send_text(const char *text, size_t length, uint32_t noisy)
+{
+    static uint8_t frames[2u * QUEUE_LINE_SIZE];
+    static uint8_t noise[2u * QUEUE_LINE_SIZE];
+    size_t i = 0;
+
+    for (i = 0; (i < length) && (i < QUEUE_LINE_SIZE); i++)
+    {
+        frames[2u * i] = TEST_FRAME_DATA;
+        frames[(2u * i) + 1u] = (uint8_t)text[i];
+    }
+    memcpy(noise, frames, 2u * i);
+    noise[2u * 5u + 1u] ^= 0x01u;
+    line_send(frames, noise, 2u * i, noisy);
+}
+
+/*Leave the line idle for a time*/
+static void line_pause(uint32_t duration_us)
+{
+    uint8_t frame[2] = {TEST_FRAME_PAUSE, 0};
+    uint32_t i = 0;
+
+    for (i = 0; i < ((duration_us / TEST_FRAME_US) + 1u); i++)
+    {
+        line_send(frame, frame, sizeof(frame), 0);
+    }
+}
+
+/*Read the answer of the addressed node until a text and the end of its line, or until the end
+ *of its boot if text is NULL. The other nodes must stay silent. Return 1 if found*/
+static uint8_t node_read(uint32_t addressed, const char *text)
+{
+    struct pollfd lines[TEST_NODES_MAX];
+    uint32_t nodes[TEST_NODES_MAX];
+    test_node *node = &s_nodes[addressed];
+    char chatter[256];
+    const char *found = NULL;
+    ssize_t count = 0;
+    uint8_t ret_val = 0;
+    uint8_t done = 0;
+    nfds_t n = 0;
+    nfds_t i = 0;
+
+    while (0u == done)
+    {
+        n = 0;
+        for (i = 1; i <= s_node_count; i++)
+        {
+            if (0u != s_nodes[i].live)
+            {
+                lines[n].fd = s_nodes[i].line_out;
+                lines[n].events = POLLIN;
+                nodes[n] = (uint32_t)i;
+                n++;
+            }
+        }
+        done = (poll(lines, n, TEST_ANSWER_TIMEOUT_MS) <= 0) ? 1u : 0u;
+        for (i = 0; (0u == done) && (i < n); i++)
+        {
+            if (0 == lines[i].revents)
+            {
+                continue;
+            }
+            if (nodes[i] != addressed)
+            {
+                count = read(lines[i].fd, chatter, sizeof(chatter));
+                s_chatter += (count > 0) ? (size_t)count : 0u;
+                continue;
+            }
+            count = read(lines[i].fd, &node->answer[node->answer_length],
+                         sizeof(node->answer) - 1u - node->answer_length);
+            if (count <= 0)
+            {
+                /*The end of the boot*/
+                ret_val = (NULL == text) ? 1u : 0u;
+                done = 1;
+            }
+            else
+            {
+                node->answer_length += (size_t)count;
+                node->answer[node->answer_length] = '\0';
+                found = (NULL != text) ? strstr(node->answer, text) : NULL;
+                /*A line ends the answer, an ACK of #PACE is a single character*/
+                if ((NULL != found) && ((NULL != strchr(found, '\n')) || ('\0' == text[1])))
+                {
+                    ret_val = 1;
+                    done = 1;
+                }
+                else if ((sizeof(node->answer) - 1u) == node->answer_length)
+                {
+                    /*Keep the end of a long answer*/
+                    memmove(node->answer, &node->answer[sizeof(node->answer) / 2u], sizeof(node->answer) / 2u);
+                    node->answer_length -= sizeof(node->answer) / 2u;
+                }
+                else
+                {
+                    /*Do nothing*/
+                }
+            }
+        }
+    }
+
+    return ret_val;
+}
+
+/*Send a line to the addressed node and read its answer up to a text*/
+static const char *node_command(uint32_t addressed, const char *line, size_t length, const char *text)
+{
+    const char *ret_val = NULL;
+
+    s_nodes[addressed].answer_length = 0;
+    s_nodes[addressed].answer[0] = '\0';
+    line_send_text(line, length, 0);
+    if (1u == node_read(addressed, text))
+    {
+        ret_val = strstr(s_nodes[addressed].answer, text);
+    }
+
+    return ret_val;
+}
+
+/*Read the file, split its lines and build its image with the bootloader decoder*/
+static uint8_t load_file(const char *name)
+{
+    FILE *file = fopen(name, "rb");
+    static uint8_t line[QUEUE_LINE_SIZE];
+    srec_line record;
+    size_t i = 0;
+    size_t length = 0;
+    uint8_t ret_val = 1;
+
+    if (NULL == file)
+    {
+        return 0;
+    }
+    s_file_size = fread(s_file, 1u, sizeof(s_file) - 1u, file);
+    fclose(file);
+    memset(s_image, 0xFF, sizeof(s_image));
+
+    for (i = 0; (i < s_file_size) && (s_line_count < TEST_LINES_MAX); i++)
+    {
+        if ((0u == i) || ('\n' == s_file[i - 1u]))
+        {
+            s_line_start[s_line_count++] = i;
+        }
+    }
+    s_line_start[s_line_count] = s_file_size;
+
+    for (i = 0; i < s_line_count; i++)
+    {
+        length = strcspn(&s_file[s_line_start[i]], "\r\n");
+        length = (length < (QUEUE_LINE_SIZE - 1u)) ? length : (QUEUE_LINE_SIZE - 1u);
+        memcpy(line, &s_file[s_line_start[i]], length);
+        line[length] = '\0';
+        parse_Srecord_line(line, &record);
+        ret_val &= (0u == check_srec_line(&record, line)) ? 1u : 0u;
+        if (((S1 == record.type) || (S2 == record.type) || (S3 == record.type)) &&
+            ((record.address + record.byte_count) <= FLASH_TOTAL_SIZE))
+        {
+            memcpy(&s_image[record.address], record.data, record.data_word * 4u);
+            s_image_start = (record.address < s_image_start) ? record.address : s_image_start;
+            s_image_end = ((record.address + (record.data_word * 4u)) > s_image_end) ?
+                              (record.address + (record.data_word * 4u)) : s_image_end;
+        }
+    }
+
+    return ret_val;
+}
+
+/*Address of the data record of a line, FLASH_TOTAL_SIZE for the other records*/
+static uint32_t line_address(uint32_t index)
+{
+    static uint8_t line[QUEUE_LINE_SIZE];
+    srec_line record;
+    size_t length = strcspn(&s_file[s_line_start[index]], "\r\n");
+
+    length = (length < (QUEUE_LINE_SIZE - 1u)) ? length : (QUEUE_LINE_SIZE - 1u);
+    memcpy(line, &s_file[s_line_start[index]], length);
+    line[length] = '\0';
+    parse_Srecord_line(line, &record);
+
+    return ((S1 == record.type) || (S2 == record.type) || (S3 == record.type)) ? record.address : FLASH_TOTAL_SIZE;
+}
+
+/*Collect the result of an addressed node, send again the records of its bad sectors and commit.
+ *Return the number of lines sent again*/
+static uint32_t node_finish(uint32_t addressed, uint32_t *rejected)
+{
+    uint32_t first = s_image_start / FLASH_SECTOR_SIZE;
+    uint32_t count = ((s_image_end - 1u) / FLASH_SECTOR_SIZE) - first + 1u;
+    uint32_t resent = 0;
+    uint32_t sector = 0;
+    uint32_t address = 0;
+    uint32_t i = 0;
+    char command[64];
+    const char *answer = NULL;
+    char *next = NULL;
+    uint8_t bad[FLASH_TOTAL_SIZE / FLASH_SECTOR_SIZE] = {0};
+    uint8_t paced = 0;
+
+    line_send_address((uint8_t)addressed);
+
+    answer = node_command(addressed, "#STATUS\n", 8u, "VERIFY");
+    CHECK((NULL != answer) && (NULL != strstr(s_nodes[addressed].answer, "complete=1")));
+    if (NULL == answer)
+    {
+        /*The node does not answer, its boot is ended*/
+        *rejected = 0xFFFFFFFFu;
+        return 0;
+    }
+    answer = strstr(s_nodes[addressed].answer, "rejected=");
+    *rejected = (NULL != answer) ? (uint32_t)strtoul(answer + 9, NULL, 0) : 0xFFFFFFFFu;
+
+    /*An argument past 32 bits or 8 hexadecimal digits is refused, not wrapped onto the App region
+     *(0xA000, sector 40). 10 decimal digits are taken*/
+    CHECK(NULL != node_command(addressed, "#CRC 0x1FFFFFFFF 4\n", 19u, "ERROR"));
+    CHECK(NULL != node_command(addressed, "#CRC 0x10000A000 4\n", 19u, "ERROR"));
+    CHECK(NULL != node_command(addressed, "#CRC 0x00000A000 4\n", 19u, "ERROR"));
+    CHECK(NULL != node_command(addressed, "#SECTORS 4294967336 1\n", 22u, "ERROR"));
+    CHECK(NULL != node_command(addressed, "#SECTORS 0000000040 1\n", 22u, "crc="));
+
+    snprintf(command, sizeof(command), "#SECTORS %u %u\n", first, count);
+    answer = node_command(addressed, command, strlen(command), "crc=");
+    CHECK(NULL != answer);
+    next = (NULL != answer) ? (char *)(answer + 4) : NULL;
+    for (sector = first; (NULL != next) && (sector < (first + count)); sector++)
+    {
+        bad[sector] = (strtoul(next, &next, 0) !=
+                       Crc32_final(Crc32_update(CRC32_INITIAL_VALUE, &s_image[sector * FLASH_SECTOR_SIZE], FLASH_SECTOR_SIZE))) ?
+                          1u : 0u;
+        next = (',' == *next) ? (next + 1) : NULL;
+    }
+
+    /*The records are programmed at once: each line waits for the ACK of the last one*/
+    for (i = 0; i < s_line_count; i++)
+    {
+        address = line_address(i);
+        if ((address < FLASH_TOTAL_SIZE) && (0u != bad[address / FLASH_SECTOR_SIZE]))
+        {
+            if (0u == paced)
+            {
+                CHECK(NULL != node_command(addressed, "#PACE 1\n", 8u, "PACE on=1"));
+                paced = 1;
+            }
+            CHECK(NULL != node_command(addressed, &s_file[s_line_start[i]], s_line_start[i + 1u] - s_line_start[i], "+"));
+            resent++;
+        }
+    }
+
+    answer = node_command(addressed, "#COMMIT\n", 8u, "COMMIT");
+    CHECK((NULL != answer) && (0 == strncmp(answer, "COMMIT ok", 9u)));
+
+    /*The node reports its update while it is addressed, then its boot ends*/
+    CHECK(1u == node_read(addressed, NULL));
+
+    return resent;
+}
+
+/*Point-to-point update of one board, return its model time in ms*/
+static unsigned long run_single(const char *board, int *status)
+{
+    test_node *node = &s_nodes[0];
+    char answer[4096];
+    ssize_t count = 0;
+
+    node_start(node, board, "test_multidrop_0.flash");
+    /*The file is sent on the prompt*/
+    while ((NULL == strstr(node->answer, "Waiting for receiving Srec file")) &&
+           ((count = read(node->line_out, &node->answer[node->answer_length],
+                          sizeof(node->answer) - 1u - node->answer_length)) > 0))
+    {
+        node->answer_length += (size_t)count;
+        node->answer[node->answer_length] = '\0';
+    }
+    (void)write(node->line_in, s_file, s_file_size);
+    close(node->line_in);
+    node->line_in = open("/dev/null", O_WRONLY);
+    while (read(node->line_out, answer, sizeof(answer)) > 0)
+    {
+        /*Do nothing*/
+    }
+
+    return node_end(node, status);
+}
+
+int main(int argc, char *argv[])
+{
+    char board[256];
+    char name[256];
+    unsigned long single = 0;
+    unsigned long fleet = 0;
+    unsigned long node_time = 0;
+    uint32_t rejected = 0;
+    uint32_t resent = 0;
+    uint32_t total_resent = 0;
+    uint32_t i = 0;
+    uint32_t commit_us = 0;
+    int status = 0;
+    FILE *flash = NULL;
+    static uint8_t content[FLASH_TOTAL_SIZE];
+
+    if (argc < 5)
+    {
+        printf("usage: test_multidrop <board> <node board prefix> <nodes> <file.srec>\n");
+        return 2;
+    }
+    s_node_count = (uint32_t)strtoul(argv[3], NULL, 0);
+    CHECK((s_node_count >= 2u) && (s_node_count <= TEST_NODES_MAX));
+    CHECK(1u == load_file(argv[4]));
+    CHECK((s_image_start < s_image_end) && (TEST_CORRUPT_LINE < s_line_count));
+    if ((s_node_count < 2u) || (s_node_count > TEST_NODES_MAX) || (s_image_start >= s_image_end))
+    {
+        return CHECK_DONE("test_multidrop");
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    single = run_single(argv[1], &status);
+    if (WIFEXITED(status) && (77 == WEXITSTATUS(status)))
+    {
+        printf("test_multidrop: the board can not be mapped here, skipped\n");
+        return 0;
+    }
+    CHECK(0u != single);
+
+    for (i = 1; i <= s_node_count; i++)
+    {
+        snprintf(board, sizeof(board), "%s%u", argv[2], i);
+        snprintf(name, sizeof(name), "test_multidrop_%u.flash", i);
+        node_start(&s_nodes[i], board, name);
+    }
+
+    /*Broadcast: every node receives the image, node 2 misses a line*/
+    commit_us = ((((s_image_end - s_image_start) / FLASH_SECTOR_SIZE) + 2u) * TEST_ERASE_SECTOR_US) +
+                (((s_image_end - s_image_start) / 4u) * TEST_PROGRAM_LONGWORD_US);
+    line_send_address(TEST_BROADCAST_ADDRESS);
+    for (i = 0; i < s_line_count; i++)
+    {
+        line_send_text(&s_file[s_line_start[i]], s_line_start[i + 1u] - s_line_start[i], (TEST_CORRUPT_LINE == i) ? 2u : 0u);
+    }
+    /*The nodes erase the old App and write the staged image in one burst, then verify it: wait for it*/
+    line_pause(commit_us);
+
+    /*Addressed: collect, send again and commit, node by node*/
+    for (i = 1; i <= s_node_count; i++)
+    {
+        resent = node_finish(i, &rejected);
+        total_resent += resent;
+        node_time = node_end(&s_nodes[i], &status);
+        CHECK(0 == status);
+        CHECK(0u != node_time);
+        CHECK(rejected == ((2u == i) ? 1u : 0u));
+        CHECK((2u == i) ? (0u != resent) : (0u == resent));
+        fleet = (node_time > fleet) ? node_time : fleet;
+
+        snprintf(name, sizeof(name), "test_multidrop_%u.flash", i);
+        flash = fopen(name, "rb");
+        CHECK((NULL != flash) && (sizeof(content) == fread(content, 1u, sizeof(content), flash)));
+        CHECK(0 == memcmp(&content[s_image_start], &s_image[s_image_start], s_image_end - s_image_start));
+        if (NULL != flash)
+        {
+            fclose(flash);
+        }
+    }
+    CHECK(0u == s_chatter);
+
+    /*One stream for the fleet: about T instead of N x T*/
+    CHECK(fleet < (s_node_count * single));
+    CHECK((fleet * 10u) < (single * 15u));
+    printf("Multi-drop update of %u nodes: %lu ms, point-to-point %lu ms a board (%lu ms in turn), %u lines sent again\n",
+           s_node_count, fleet, single, s_node_count * single, total_resent);
+
+    return CHECK_DONE("test_multidrop");
+}
+/*EOF*/
@@ -0,0 +1,154 @@
+#!/bin/sh
+# Host check of the update skip decision of srec_gang.sh on test_board
+#
+# Usage: sh test_skip.sh <test_board> <App.srec>   (make -C Tests)
+#
+# <App.srec> gets a manifest from srec_manifest.awk and is installed on a new
+# flash file by an update. test_board in boot mode on that flash answers
+# "#QUERY" from Command.c: the App is intact, its answer must report it valid.
+# srec_skip.awk decides from that answer and the image to send: only the same
+# image is skipped. srec_gang.sh with SKIP_SAME then asks the board itself: the
+# same image is reported SKIPPED with the flash untouched, another version is
+# sent. With the updated flag of the App erased, the answer reports no valid
+# App and the same image is sent.
+
+board=$1
+image=$2
+scripts=../Project_Settings/Scripts
+temporary="test_skip.flash test_skip.app test_skip.line test_skip.out test_skip.err test_skip.pty test_skip.pty.log"
+temporary="$temporary test_skip_v7.srec test_skip_v8.srec test_skip_data.srec test_skip_crlf.srec"
+checks=0
+failed=0
+
+# check <condition text> <status>
+check()
+{
+    checks=$((checks + 1))
+    if [ "$2" -ne 0 ]; then
+        failed=$((failed + 1))
+        echo "test_skip.sh: FAIL $1"
+    fi
+}
+
+# skipped <status>: the board can not be mapped here
+skipped()
+{
+    if [ "$1" -eq 77 ]; then
+        echo "test_skip: the board can not be mapped here, skipped"
+        # $temporary is not quoted: one argument per file
+    # shellcheck disable=SC2086
+    rm -f $temporary
+        exit 0
+    fi
+}
+
+# expect <SKIP|UPDATE> <answer> <image to send>
+expect()
+{
+    decision=$(awk -f "$scripts/srec_skip.awk" -v query="$2" "$3")
+    status=$?
+    case $1 in
+        SKIP) [ $status -eq 0 ] && [ "$decision" = "SKIP" ] ;;
+        *) [ $status -eq 1 ] && [ "${decision%% *}" = "UPDATE" ] ;;
+    esac
+    check "expected $1 for $3 on the answer \"$2\": $decision" $?
+}
+
+# wait_text <text>: wait for the board to send it on test_skip.out
+wait_text()
+{
+    tries=0
+    while ! grep -q "$1" test_skip.out 2> /dev/null && [ $tries -lt 50 ]; do
+        sleep 0.1
+        tries=$((tries + 1))
+    done
+}
+
+# query: the "QUERY valid=" answer of test_board in boot mode on test_skip.flash, in answer
+query()
+{
+    rm -f test_skip.line test_skip.out
+    mkfifo test_skip.line || exit 2
+    "$board" -boot test_skip.flash < test_skip.line > test_skip.out 2> test_skip.err &
+    pid=$!
+    exec 3> test_skip.line
+    wait_text "Waiting for receiving Srec file"
+    printf '#QUERY\n' >&3
+    wait_text "QUERY valid="
+    exec 3>&-
+    wait $pid
+    skipped $?
+    answer=$(tr -d '\r' < test_skip.out | grep "QUERY valid=")
+}
+
+# gang <image> [1]: srec_gang.sh sends <image> to test_board on test_skip.flash, SKIP_SAME set with 1
+gang()
+{
+    rm -f test_skip.pty test_skip.pty.log
+    "$board" -boot -pty test_skip.pty test_skip.flash 2> test_skip.err &
+    pid=$!
+    tries=0
+    while [ ! -L test_skip.pty ] && [ $tries -lt 50 ]; do
+        sleep 0.1
+        tries=$((tries + 1))
+    done
+    report=$(LOG_DIR=. SKIP_SAME=$2 sh "$scripts/srec_gang.sh" "$1" test_skip.pty)
+    # A skipped board is left in boot mode: reset it
+    kill -TERM $pid 2> /dev/null
+    wait $pid
+    skipped $?
+}
+
+awk -f "$scripts/srec_manifest.awk" -v version=7 "$image" > test_skip_v7.srec 2> /dev/null
+awk -f "$scripts/srec_manifest.awk" -v version=8 "$image" > test_skip_v8.srec 2> /dev/null
+# One data digit changed: same version and range, another CRC
+awk '/^S[123]/ && !changed++ { $0 = substr($0, 1, 12) ((substr($0, 13, 1) == "0") ? "1" : "0") substr($0, 14) } { print }' \
+    "$image" | awk -f "$scripts/srec_manifest.awk" -v version=7 > test_skip_data.srec 2> /dev/null
+sed 's/$/\r/' test_skip_v7.srec > test_skip_crlf.srec
+
+# The board holds version 7
+rm -f test_skip.flash
+gang test_skip_v7.srec
+printf '%s\n' "$report" | grep -q "^test_skip.pty .* OK$"
+check "version 7 is installed: $report" $?
+cp test_skip.flash test_skip.app
+
+# The answer of the board: the same image is skipped, whatever the line ends, anything else is sent
+query
+printf '%s\n' "$answer" | grep -q "^QUERY valid=1 "
+check "the board answers on its installed App: $answer" $?
+expect SKIP "$answer" test_skip_v7.srec
+expect SKIP "$answer" test_skip_crlf.srec
+expect UPDATE "$answer" test_skip_v8.srec
+expect UPDATE "$answer" test_skip_data.srec
+expect UPDATE "$answer" "$image"
+expect UPDATE "" test_skip_v7.srec
+cmp -s test_skip.flash test_skip.app
+check "the query leaves the flash untouched" $?
+
+# srec_gang.sh asks the board: the same image is not sent
+gang test_skip_v7.srec 1
+printf '%s\n' "$report" | grep -q "^test_skip.pty .* SKIPPED$"
+check "srec_gang.sh skips the board that holds the image: $report" $?
+grep -q "^QUERY valid=1 " test_skip.pty.log
+check "srec_gang.sh decides on the answer of the board" $?
+cmp -s test_skip.flash test_skip.app
+check "the skipped board keeps its flash" $?
+
+# Another version is sent
+gang test_skip_v8.srec 1
+printf '%s\n' "$report" | grep -q "^test_skip.pty .* OK$"
+check "srec_gang.sh updates the board to version 8: $report" $?
+
+# The updated flag of version 7 erased (APP_UPDATED_FLAG_LOCATION 0x9C08): not valid, the image is sent
+cp test_skip.app test_skip.flash
+printf '\377\377\377\377' | dd of=test_skip.flash bs=1 seek=39944 conv=notrunc 2> /dev/null
+query
+printf '%s\n' "$answer" | grep -q "^QUERY valid=0 "
+check "the board answers no valid App once its flag is erased: $answer" $?
+expect UPDATE "$answer" test_skip_v7.srec
+
+# shellcheck disable=SC2086
+rm -f $temporary
+echo "test_skip: $checks checks, $failed failed"
+[ $failed -eq 0 ]
@@ -0,0 +1,243 @@
+/**
+ * @file  : test_srec.c
+ * @author: Nguyen The Anh.
+ * @brief : Host differential check of the S-record decoder against the files of GNU objcopy.
+ * @version: 0.0
+ *
+ * Usage: test_srec <image.bin> <load address> <data record type> data|words <file.srec>...
+ *
+ * Each file is the image converted by objcopy at the load address, with its S0 and termination
+ * records. Every line must pass check_srec_line, and fail it once a digit is changed or the
+ * line is cut. The decoded words hold every data byte, a partial last word completed with 0xFF.
+ * In data mode the data fields rebuild the image byte for byte. In words mode (the files of
+ * srec_repack.awk) the longwords written to flash are kept, they must start on a longword,
+ * cover the image and complete its last longword with 0xFF.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_check.h"
+#include "Srec/Srec.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Largest image of the check, the App region of the 256 KB flash*/
+#define TEST_IMAGE_MAX (0x40000u)
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*This array stores the source image*/
+static uint8_t s_image[TEST_IMAGE_MAX];
+
+/*This array stores the image rebuilt from the records*/
+static uint8_t s_rebuilt[TEST_IMAGE_MAX];
+
+/*This array marks the bytes of s_rebuilt set by a record*/
+static uint8_t s_covered[TEST_IMAGE_MAX];
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Data bytes of a data record, the decoder keeps them all in record->data*/
+static uint32_t get_data_size(const srec_line *record)
+{
+    uint32_t not_data = (S1 == record->type) ? S1_NOT_DATA_COUNT :
+                        ((S2 == record->type) ? S2_NOT_DATA_COUNT : S3_NOT_DATA_COUNT);
+
+    return (record->byte_count >= not_data) ? (record->byte_count - not_data) : 0u;
+}
+
+/*Decode a line in a buffer of its exact size, ASan reports a read past its end*/
+static uint8_t decode_line(const char *text, srec_line *record)
+{
+    size_t length = strlen(text);
+    uint8_t *line = malloc(length + 1u);
+    uint8_t ret_val = 1;
+
+    if (NULL != line)
+    {
+        memcpy(line, text, length + 1u);
+        parse_Srecord_line(line, record);
+        ret_val = check_srec_line(record, line);
+        free(line);
+    }
+
+    return ret_val;
+}
+
+/*A line with one hex digit changed, or its last digit cut, must be rejected*/
+static void check_corrupted(const char *text, uint32_t line_number)
+{
+    char line[SREC_LINE_BUFFER_SIZE];
+    srec_line record;
+    size_t length = strlen(text);
+    size_t position = 2u + (line_number % (length - 2u));
+
+    memcpy(line, text, length + 1u);
+    line[position] = ('0' == line[position]) ? '1' : '0';
+    CHECK(1u == decode_line(line, &record));
+
+    memcpy(line, text, length + 1u);
+    line[length - 1u] = '\0';
+    CHECK(1u == decode_line(line, &record));
+}
+
+/*Decode a file, rebuild the image and compare it with the source*/
+static void check_file(const char *name, uint32_t load_address, uint32_t image_size, uint8_t data_type,
+                       uint8_t words)
+{
+    FILE *file = fopen(name, "r");
+    char text[SREC_LINE_BUFFER_SIZE + 2u];
+    srec_line record;
+    uint32_t line_number = 0;
+    uint32_t data_records = 0;
+    uint32_t bad_lines = 0;
+    uint32_t bad_bytes = 0;
+    uint32_t size = 0;
+    uint32_t offset = 0;
+    uint32_t end = 0;
+    uint32_t i = 0;
+    uint8_t terminated = 0;
+
+    CHECK(NULL != file);
+    if (NULL == file)
+    {
+        return;
+    }
+
+    memset(s_rebuilt, 0, sizeof(s_rebuilt));
+    memset(s_covered, 0, sizeof(s_covered));
+    while (NULL != fgets(text, sizeof(text), file))
+    {
+        text[strcspn(text, "\r\n")] = '\0';
+        line_number++;
+
+        if ((0u != terminated) || (0u != decode_line(text, &record)))
+        {
+            /*Nothing after the termination record, every line is accepted*/
+            bad_lines++;
+            continue;
+        }
+        check_corrupted(text, line_number);
+
+        if (S0 == record.type)
+        {
+            CHECK(1u == line_number);
+        }
+        else if ((S1 <= record.type) && (record.type <= S3))
+        {
+            CHECK(data_type == record.type);
+            data_records++;
+            size = get_data_size(&record);
+            CHECK(((size + WORD_ALIGN - 1u) / WORD_ALIGN) == record.data_word);
+            for (i = size; i < (record.data_word * WORD_ALIGN); i++)
+            {
+                CHECK(0xFFu == record.data[i]);
+            }
+            /*In words mode the longwords are written whole*/
+            if (0u != words)
+            {
+                CHECK(0u == (record.address % WORD_ALIGN));
+                size = record.data_word * WORD_ALIGN;
+            }
+            offset = record.address - load_address;
+            if ((record.address < load_address) || (offset > (TEST_IMAGE_MAX - size)))
+            {
+                bad_bytes += size;
+                continue;
+            }
+            for (i = 0; i < size; i++)
+            {
+                /*A byte written twice is an overlap*/
+                bad_bytes += s_covered[offset + i];
+                s_covered[offset + i] = 1;
+                s_rebuilt[offset + i] = record.data[i];
+            }
+        }
+        else if ((S5 == record.type) || (S6 == record.type))
+        {
+            CHECK(data_records == record.address);
+        }
+        else
+        {
+            /*S7 ends S3, S8 ends S2, S9 ends S1*/
+            CHECK((10u - data_type) == record.type);
+            terminated = 1;
+        }
+    }
+    fclose(file);
+
+    /*The image, then 0xFF up to the end of its last longword in words mode*/
+    end = (0u != words) ? ((image_size + WORD_ALIGN - 1u) & ~(WORD_ALIGN - 1u)) : image_size;
+    for (i = 0; i < TEST_IMAGE_MAX; i++)
+    {
+        if (i < image_size)
+        {
+            bad_bytes += ((1u != s_covered[i]) || (s_image[i] != s_rebuilt[i])) ? 1u : 0u;
+        }
+        else if (i < end)
+        {
+            bad_bytes += ((1u != s_covered[i]) || (0xFFu != s_rebuilt[i])) ? 1u : 0u;
+        }
+        else
+        {
+            bad_bytes += s_covered[i];
+        }
+    }
+
+    CHECK(0u == bad_lines);
+    CHECK(0u == bad_bytes);
+    CHECK(1u == terminated);
+    printf("%s: %u lines, %u data records, %u bad lines, %u bad bytes\n", name, line_number, data_records,
+           bad_lines, bad_bytes);
+
+    return;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *file = NULL;
+    uint32_t image_size = 0;
+    uint32_t load_address = 0;
+    uint8_t data_type = 0;
+    uint8_t words = 0;
+    int i = 0;
+
+    if (argc < 6)
+    {
+        printf("usage: test_srec <image.bin> <load address> <data record type> data|words <file.srec>...\n");
+        return 2;
+    }
+
+    file = fopen(argv[1], "rb");
+    CHECK(NULL != file);
+    if (NULL != file)
+    {
+        image_size = (uint32_t)fread(s_image, 1u, sizeof(s_image), file);
+        fclose(file);
+    }
+    CHECK(0u != image_size);
+    load_address = (uint32_t)strtoul(argv[2], NULL, 0);
+    data_type = (uint8_t)strtoul(argv[3], NULL, 0);
+    words = (0 == strcmp(argv[4], "words")) ? 1u : 0u;
+
+    for (i = 5; i < argc; i++)
+    {
+        check_file(argv[i], load_address, image_size, data_type, words);
+    }
+
+    return CHECK_DONE("test_srec");
+}
+/*EOF*/
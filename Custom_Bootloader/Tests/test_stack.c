@@ -0,0 +1,261 @@
+/**
+ * @file  : test_stack.c
+ * @author: Nguyen The Anh.
+ * @brief : Host stack-painting high-water check of the receive and decode path of Boot_main.
+ * @version: 0.0
+ *
+ * Usage: test_stack <file.srec>
+ *
+ * The RAM of the target is mapped at RAM_BASE_ADDRESS and the linker symbols __StackLimit and
+ * __StackTop are those of the linker file. The path runs on that stack: each byte of the file
+ * is received by UART0_IRQHandler, each line is read from the queue, decoded and checked in the
+ * static work areas of Boot_main. Driver_Stack_paint paints the stack before and
+ * Driver_Stack_get_used gives the high-water mark after. The same path with the line buffer and
+ * the record on the stack, as Boot_main had them, is measured for comparison. The frames are
+ * those of the host compiler, the target worst case is the one of `make stack-report`.
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include "test_check.h"
+#include "MKL46Z4.h"
+#include "Driver/Driver_core.h"
+#include "Driver/Driver_UART0.h"
+#include "Driver/Driver_PORT.h"
+#include "Driver/Driver_SIM.h"
+#include "Event/Event.h"
+#include "Queue/Queque.h"
+#include "Srec/Srec.h"
+#include "Flash_layout.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Largest S-record file of the check*/
+#define TEST_FILE_MAX (0x20000u)
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*Register blocks and core registers of the device header*/
+UART0_Type g_mock_uart0;
+SysTick_Type g_mock_systick;
+SCB_Type g_mock_scb;
+NVIC_Type g_mock_nvic;
+uint32_t g_mock_primask = 0;
+uint32_t g_mock_msp = 0;
+void (*g_mock_wfi)(void) = 0;
+
+/*Stack limits of the linker file, given to the link*/
+extern uint32_t __StackLimit;
+extern uint32_t __StackTop;
+
+/*This array stores the S-record file*/
+static uint8_t s_file[TEST_FILE_MAX];
+static size_t s_file_size = 0;
+
+/*This variable stores the work areas of Boot_main*/
+static uint8_t s_received_line[QUEUE_LINE_SIZE] __attribute__((aligned(4)));
+static srec_line s_record;
+
+/*This variable stores the result of a run on the target stack*/
+static uint32_t s_painted = 0;
+static uint32_t s_used = 0;
+static uint32_t s_lines = 0;
+static uint32_t s_bad_lines = 0;
+static uint8_t s_on_stack = 0;
+
+/*This variable stores the contexts of the run*/
+static ucontext_t s_main_context;
+static ucontext_t s_run_context;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+void UART0_IRQHandler(void);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Stand-ins of the modules the drivers call, the clock gates and pins do not exist on the host*/
+void Driver_PORT_set_MUX_pin(Port_type_enum_t port_type, uint8_t pin, Mux_type_enum_t mux_type)
+{
+    (void)port_type;
+    (void)pin;
+    (void)mux_type;
+}
+
+void Driver_SIM_SCGC4_set_UART0_clock_gate(clock_gate_state_enum_t uart0_clock_gate)
+{
+    (void)uart0_clock_gate;
+}
+
+void Driver_SIM_SCGC5_set_PORTn_clock_gate(Port_type_enum_t port, clock_gate_state_enum_t PORTn_gate)
+{
+    (void)port;
+    (void)PORTn_gate;
+}
+
+void Event_post(event_id_enum_t event)
+{
+    (void)event;
+}
+
+/*Receive a byte in the interrupt handler, the transmitter is idle*/
+static void receive_byte(uint8_t byte)
+{
+    g_mock_uart0.S1 = UART0_S1_RDRF_MASK | UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+    g_mock_uart0.D = byte;
+    UART0_IRQHandler();
+    g_mock_uart0.S1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+}
+
+/*Read, decode and check a line in the static work areas*/
+static __attribute__((noinline)) void decode_static(void)
+{
+    Driver_UART0_receive_string(s_received_line);
+    Driver_UART0_dequeue();
+    parse_Srecord_line(s_received_line, &s_record);
+    s_bad_lines += check_srec_line(&s_record, s_received_line);
+}
+
+/*The same with the line buffer and the record on the stack*/
+static __attribute__((noinline)) void decode_on_stack(void)
+{
+    uint8_t received_line[QUEUE_LINE_SIZE];
+    srec_line record;
+
+    Driver_UART0_receive_string(received_line);
+    Driver_UART0_dequeue();
+    parse_Srecord_line(received_line, &record);
+    s_bad_lines += check_srec_line(&record, received_line);
+}
+
+/*Receive the file and decode its lines on the target stack*/
+static void run_on_target_stack(void)
+{
+    uint32_t frame = 0; /*This variable marks the frame of the run, the top of the painted stack*/
+    size_t i = 0;
+
+    g_mock_msp = (uint32_t)(uintptr_t)&frame;
+    Driver_Stack_paint();
+    s_painted = Driver_Stack_get_used();
+
+    for (i = 0; i < s_file_size; i++)
+    {
+        receive_byte(s_file[i]);
+        if (QUEUE_ELEMENT_READY == Driver_UART0_check_first_buffer())
+        {
+            s_lines++;
+            if (0u != s_on_stack)
+            {
+                decode_on_stack();
+            }
+            else
+            {
+                decode_static();
+            }
+        }
+    }
+
+    s_used = Driver_Stack_get_used();
+}
+
+/*Run the path on the stack of the linker file, return the high-water mark*/
+static uint32_t measure(uint8_t on_stack)
+{
+    uart0_config_info config = {
+        .baud_rate = 115200,
+        .OSR = 16,
+        .Tx_Rx_port = PORT_A,
+        .Tx_pin = 2,
+        .Rx_pin = 1,
+        .data_mode = DATA_8BITS,
+        .parity_state = PARITY_DISABLED,
+        .stop_bit_count = ONE_STOP_BIT,
+        .transmitter_state = TRANSMITTER_ENABLED,
+        .receiver_state = RECEIVER_ENABLED,
+        .transmiter_IRQ = TRANSMIT_IRQ_DISABLED,
+        .receiver_IRQ = RECEIVE_IRQ_ENABLED,
+        .error_rate = 20,
+    };
+
+    g_mock_uart0.S1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+    Driver_UART0_init(&config, 24000000u);
+    s_on_stack = on_stack;
+    s_lines = 0;
+    s_bad_lines = 0;
+
+    getcontext(&s_run_context);
+    s_run_context.uc_stack.ss_sp = &__StackLimit;
+    s_run_context.uc_stack.ss_size = Driver_Stack_get_size();
+    s_run_context.uc_link = &s_main_context;
+    makecontext(&s_run_context, run_on_target_stack, 0);
+    CHECK(0 == swapcontext(&s_main_context, &s_run_context));
+
+    CHECK(0u != s_lines);
+    CHECK(0u == s_bad_lines);
+    /*Only the frames above the run are left unpainted*/
+    CHECK(s_painted < s_used);
+
+    return s_used;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *file = NULL;
+    void *ram = NULL;
+    uint32_t static_used = 0;
+    uint32_t stack_used = 0;
+
+    if (argc < 2)
+    {
+        printf("usage: test_stack <file.srec>\n");
+        return 2;
+    }
+
+    file = fopen(argv[1], "rb");
+    CHECK(NULL != file);
+    if (NULL != file)
+    {
+        s_file_size = fread(s_file, 1u, sizeof(s_file), file);
+        fclose(file);
+    }
+
+    /*The stack of the linker file is at the top of the RAM*/
+    ram = mmap((void *)RAM_BASE_ADDRESS, RAM_TOTAL_SIZE, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    CHECK((void *)RAM_BASE_ADDRESS == ram);
+    CHECK((RAM_BASE_ADDRESS + RAM_TOTAL_SIZE) == (uintptr_t)&__StackTop);
+    CHECK(TEST_STACK_SIZE == Driver_Stack_get_size());
+    if ((void *)RAM_BASE_ADDRESS != ram)
+    {
+        return CHECK_DONE("test_stack");
+    }
+
+    static_used = measure(0);
+    stack_used = measure(1);
+    CHECK(static_used < Driver_Stack_get_size());
+    /*The work areas off the stack save at least the line buffer and the record, or an overflow*/
+    CHECK((stack_used == Driver_Stack_get_size()) ||
+          ((stack_used - static_used) >= (QUEUE_LINE_SIZE + sizeof(srec_line))));
+    printf("Stack high-water of %u lines: %u of %u bytes, %u bytes with the line buffer and record on the stack\n",
+           s_lines, static_used, Driver_Stack_get_size(), stack_used);
+
+    return CHECK_DONE("test_stack");
+}
+/*EOF*/
@@ -0,0 +1,198 @@
+#!/bin/sh
+# Host check of an unpaced update on test_board, as a terminal sends a file, and of the paced one
+#
+# Usage: sh test_stream.sh <test_board> <App.bin> <App.srec> <overrun App.srec> <manifest App.srec> <14 KB App.srec>
+#                          <large App.srec> [<large App.srec> ...]
+#        (make -C Tests)
+#
+# Each file is sent at once, with no command and no pacing, on the prompt of a
+# board in boot mode. <App.srec> fits in the staging buffer: it is received in
+# RAM on a new flash file, and the old App is erased and the image written once
+# the termination record is in. The update must succeed with no frame lost,
+# and the flash must hold the image at 0xA000.
+# Each <large App.srec>, with or without a manifest, is then sent on the flash
+# of that update: an erase while the host keeps sending would lose frames, so
+# it must end too_large with the flash untouched. So must <App.srec> with a
+# wrong checksum, ended bad_line. Sent paced by srec_gang.sh, the first
+# <large App.srec> is streamed to flash after an erase of the old App: it
+# must be installed with no frame lost.
+# <App.srec> is last sent on a new flash with a longword of the image range
+# already programmed: the program command of the image longword fails and the
+# update must end verify_failed (the board exits 1 on the violation).
+# A host that turns pacing on and then ignores it overruns the receive queue: a
+# manifest image across the flash blocks, <overrun App.srec>, is streamed after its S0, its last
+# record first, which waits for the background erase while the others come. The
+# lines dropped on the full queue must fail the update bad_line at its
+# termination record.
+# An App that shrinks leaves no programmed sector behind: the 40 KB <manifest
+# App.srec> is installed paced by srec_gang.sh, then <App.srec> with a manifest
+# of version 3 and then <14 KB App.srec> without one, both unpaced. Each
+# update must succeed with no violation: the erase covers the old App with the
+# load range of the new one.
+
+board=$1
+binary=$2
+image=$3
+overrun=$4
+manifest=$5
+shrink=$6
+shift 6
+checks=0
+failed=0
+
+# check <condition text> <status>
+check()
+{
+    checks=$((checks + 1))
+    if [ "$2" -ne 0 ]; then
+        failed=$((failed + 1))
+        echo "test_stream.sh: FAIL $1"
+    fi
+}
+
+# wait_text <text>: wait for the board to send it on test_stream.out
+wait_text()
+{
+    tries=0
+    while ! grep -qF "$1" test_stream.out 2> /dev/null && [ $tries -lt 50 ]; do
+        sleep 0.1
+        tries=$((tries + 1))
+    done
+}
+
+# gang <App.srec>: srec_gang.sh sends it paced to a board on test_stream.flash, its report in report
+gang()
+{
+    rm -f test_stream.pty
+    "$board" -boot -pty test_stream.pty test_stream.flash 2> test_stream.err &
+    pid=$!
+    tries=0
+    while [ ! -L test_stream.pty ] && [ $tries -lt 50 ]; do
+        sleep 0.1
+        tries=$((tries + 1))
+    done
+    report=$(sh ../Project_Settings/Scripts/srec_gang.sh "$1" test_stream.pty)
+    wait $pid
+}
+
+# send <App.srec>: the file at once on the prompt of a board on test_stream.flash, its exit status in status
+send()
+{
+    rm -f test_stream.line test_stream.out
+    mkfifo test_stream.line || exit 2
+    "$board" -boot test_stream.flash < test_stream.line > test_stream.out 2> test_stream.err &
+    pid=$!
+    exec 3> test_stream.line
+
+    # The file is sent on the prompt
+    wait_text "Waiting for receiving Srec file"
+    cat "$1" >&3
+    exec 3>&-
+    wait $pid
+    status=$?
+    if [ $status -eq 77 ]; then
+        echo "test_stream: the board can not be mapped here, skipped"
+        rm -f test_stream.flash test_stream.line test_stream.out test_stream.err
+        exit 0
+    fi
+}
+
+rm -f test_stream.flash
+send "$image"
+check "$image: the board exits 0" $status
+grep -q "RESULT status=success" test_stream.out
+check "$image: the update succeeds" $?
+grep -q "end of main after .* 0 frames lost, 0 violations" test_stream.err
+check "$image: no frame is lost: $(cat test_stream.err)" $?
+cmp -s -n "$(wc -c < "$binary")" -i 40960:0 test_stream.flash "$binary"
+check "$image: the flash holds the image at 0xA000" $?
+echo "$image: $(cat test_stream.err)"
+cp test_stream.flash test_stream.app
+
+# A line with a wrong checksum, as "checksum" of test_cases_host.sh
+awk '{ sub(/\r$/, "") } NR == 100 { $0 = substr($0, 1, length($0) - 1) ((substr($0, length($0)) == "0") ? "1" : "0") } { print }' \
+    "$image" > test_stream.bad
+for large in "$@" test_stream.bad; do
+    result=too_large
+    [ "$large" != test_stream.bad ] || result=bad_line
+    cp test_stream.app test_stream.flash
+    send "$large"
+    check "$large: the board exits 0" $status
+    grep -q "RESULT status=$result" test_stream.out
+    check "$large: the update ends $result" $?
+    grep -q "Flash has not been written, the old Application is kept" test_stream.out
+    check "$large: the board reports the old App kept" $?
+    grep -q "end of main after .* 0 sector erases, 0 block erases, 0 longwords programmed" test_stream.err
+    check "$large: no flash command is run: $(cat test_stream.err)" $?
+    cmp -s test_stream.flash test_stream.app
+    check "$large: the flash still holds the old App" $?
+    echo "$large: $(cat test_stream.err)"
+done
+
+# The first large image paced: the old App is erased at its first line, then it is streamed
+cp test_stream.app test_stream.flash
+gang "$1"
+printf '%s\n' "$report" | grep -q "^test_stream.pty .* OK$"
+check "$1 paced: srec_gang.sh installs it: $report" $?
+grep -q "end of main after .* 0 frames lost, 0 violations" test_stream.err
+check "$1 paced: no frame is lost: $(cat test_stream.err)" $?
+echo "$1 paced: $(cat test_stream.err)"
+
+# A longword of the image range left programmed, past the old App, is not erased by the update
+LC_ALL=C awk 'BEGIN { for (i = 0; i < 262144; i++) printf("%c", ((i >= 43008) && (i < 43012)) ? 0 : 255) }' \
+    > test_stream.flash
+send "$image"
+[ $status -eq 1 ]
+check "$image on a programmed longword: the board exits 1 on the violation" $?
+grep -q "RESULT status=verify_failed" test_stream.out
+check "$image on a programmed longword: the update fails verification" $?
+echo "$image on a programmed longword: $(cat test_stream.err)"
+
+# Pacing on, the S0 alone, then the rest at once
+awk '/^S[123]/ { data[++records] = $0; next } /^S0/ { print; next } { last = $0 }
+         END { print data[records]; for (i = 1; i < records; i++) print data[i]; print last }' "$overrun" \
+    > test_stream.overrun
+rm -f test_stream.flash test_stream.line test_stream.out
+mkfifo test_stream.line || exit 2
+"$board" -boot test_stream.flash < test_stream.line > test_stream.out 2> test_stream.err &
+pid=$!
+exec 3> test_stream.line
+wait_text "Waiting for receiving Srec file"
+printf '#PACE 1\n' >&3
+wait_text "PACE on=1"
+head -n 1 test_stream.overrun >&3
+wait_text "+"
+tail -n +2 test_stream.overrun >&3
+exec 3>&-
+wait $pid
+check "a queue overrun: the board exits 0" $?
+grep -q "RESULT status=bad_line" test_stream.out
+check "a queue overrun: the update ends bad_line" $?
+grep -q " dropped=[1-9]" test_stream.out
+check "a queue overrun: the receive queue drops lines" $?
+echo "a queue overrun: $(cat test_stream.err)"
+
+# A 40 KB App with a manifest, then a 12 KB one with a manifest, then a 14 KB one without
+rm -f test_stream.flash
+gang "$manifest"
+printf '%s\n' "$report" | grep -q "^test_stream.pty .* OK$"
+check "$manifest: srec_gang.sh installs it: $report" $?
+awk -f ../Project_Settings/Scripts/srec_manifest.awk -v version=3 "$image" > test_stream.small 2> /dev/null
+for shrunk in test_stream.small "$shrink"; do
+    send "$shrunk"
+    check "$shrunk after a larger App: the board exits 0" $status
+    grep -q "RESULT status=success" test_stream.out
+    check "$shrunk after a larger App: the update succeeds" $?
+    grep -q "end of main after .* 0 violations" test_stream.err
+    check "$shrunk after a larger App: no violation: $(cat test_stream.err)" $?
+    echo "$shrunk after a larger App: $(cat test_stream.err)"
+done
+# Past the 14 KB App (0xD800) the 40 KB of the first one read erased
+LC_ALL=C awk 'BEGIN { for (i = 0; i < 26624; i++) printf("%c", 255) }' > test_stream.app
+cmp -s -n 26624 -i 55296:0 test_stream.flash test_stream.app
+check "$shrink after a larger App: the sectors past it are erased" $?
+
+rm -f test_stream.flash test_stream.app test_stream.bad test_stream.line test_stream.out test_stream.err
+rm -f test_stream.overrun test_stream.small test_stream.pty
+echo "test_stream: $checks checks, $failed failed"
+[ $failed -eq 0 ]
@@ -0,0 +1,128 @@
+/**
+ * @file  : test_systick.c
+ * @author: Nguyen The Anh.
+ * @brief : Host check of the SysTick timestamps across reloads, with the interrupts masked or not.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include "test_check.h"
+#include "MKL46Z4.h"
+#include "Driver/Driver_core.h"
+#include "Event/Event.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Core clock cycles of a SysTick period*/
+#define TEST_PERIOD ((uint64_t)SYSTICK_RELOAD_VALUE + 1u)
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*Core registers of the device header*/
+SysTick_Type g_mock_systick;
+SCB_Type g_mock_scb;
+NVIC_Type g_mock_nvic;
+uint32_t g_mock_primask = 0;
+uint32_t g_mock_msp = 0;
+void (*g_mock_wfi)(void) = 0;
+
+/*Stack limits of the linker file*/
+uint32_t __StackLimit;
+uint32_t __StackTop;
+
+/*This variable stores the EVENT_MASK of the events posted by the driver*/
+static uint32_t s_events_posted = 0;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+void SysTick_Handler(void);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Stand-in of the event module*/
+void Event_post(event_id_enum_t event)
+{
+    s_events_posted |= EVENT_MASK(event);
+}
+
+/*The counter has counted down to value after a reload, its interrupt waits pending*/
+static void reload(uint32_t value)
+{
+    g_mock_systick.VAL = value;
+    g_mock_scb.ICSR |= SCB_ICSR_PENDSTSET_Msk;
+}
+
+/*The core takes the pending SysTick exception*/
+static void take_exception(void)
+{
+    g_mock_scb.ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+    SysTick_Handler();
+}
+
+int main(void)
+{
+    uint32_t primask = 0;
+    uint64_t before = 0;
+
+    Driver_SysTick_start();
+    CHECK(SYSTICK_RELOAD_VALUE == g_mock_systick.LOAD);
+    CHECK(0u != (g_mock_systick.CTRL & SysTick_CTRL_TICKINT_Msk));
+
+    /*The counter counts down from the reload value*/
+    g_mock_systick.VAL = SYSTICK_RELOAD_VALUE - 100u;
+    CHECK(100u == Driver_SysTick_get_ticks64());
+    CHECK(100u == Driver_SysTick_get_ticks());
+
+    /*A reload while the interrupts are masked: the pending period is counted, time goes on*/
+    primask = Driver_Save_and_disable_IRQs();
+    CHECK(1u == g_mock_primask);
+    reload(SYSTICK_RELOAD_VALUE - 50u);
+    before = Driver_SysTick_get_ticks64();
+    CHECK((TEST_PERIOD + 50u) == before);
+    CHECK((uint32_t)(TEST_PERIOD + 50u) == Driver_SysTick_get_ticks());
+
+    /*Once taken, the handler counts the same period*/
+    Driver_Restore_IRQs(primask);
+    CHECK(0u == g_mock_primask);
+    take_exception();
+    CHECK(0u != (s_events_posted & EVENT_MASK(EVENT_TICK)));
+    CHECK(before == Driver_SysTick_get_ticks64());
+    g_mock_systick.VAL = SYSTICK_RELOAD_VALUE - 60u;
+    CHECK((TEST_PERIOD + 60u) == Driver_SysTick_get_ticks64());
+
+    /*Past 2^32 cycles the 64-bit timestamp goes on, the 32-bit one wraps*/
+    while (Driver_SysTick_get_ticks64() < (((uint64_t)1u << 32u) - TEST_PERIOD))
+    {
+        take_exception();
+    }
+    before = Driver_SysTick_get_ticks64();
+    reload(SYSTICK_RELOAD_VALUE);
+    CHECK((before + TEST_PERIOD - 60u) == Driver_SysTick_get_ticks64());
+    take_exception();
+    reload(SYSTICK_RELOAD_VALUE);
+    CHECK(Driver_SysTick_get_ticks64() > ((uint64_t)1u << 32u));
+    CHECK((uint32_t)Driver_SysTick_get_ticks64() == Driver_SysTick_get_ticks());
+    take_exception();
+
+    /*Stopped: the counter and its pending interrupt are cleared*/
+    Driver_SysTick_stop();
+    CHECK(0u == g_mock_systick.CTRL);
+    CHECK(SCB_ICSR_PENDSTCLR_Msk == g_mock_scb.ICSR);
+
+    return CHECK_DONE("test_systick");
+}
+/*EOF*/
@@ -0,0 +1,255 @@
+/**
+ * @file  : test_uart0_rx.c
+ * @author: Nguyen The Anh.
+ * @brief : Host check of the UART0 receive interrupt on a register block in RAM: line errors,
+ *          baud rate step-down and the full receive queue.
+ * @version: 0.0
+ *
+ * @copyright Copyright (c) 2024.
+ *
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+
+#include <string.h>
+#include "test_check.h"
+#include "MKL46Z4.h"
+#include "Driver/Driver_UART0.h"
+#include "Driver/Driver_PORT.h"
+#include "Driver/Driver_SIM.h"
+#include "Event/Event.h"
+#include "Queue/Queque.h"
+
+/*******************************************************************************
+ * Macro
+ ******************************************************************************/
+
+/*\Source clock of UART0 in the checks, 115200 baud with OSR 16 gives a divisor of 13*/
+#define TEST_CLOCK (24000000u)
+
+/*\OR, NF, FE and PF flags*/
+#define TEST_ERROR_FLAGS (UART0_S1_OR_MASK | UART0_S1_NF_MASK | UART0_S1_FE_MASK | UART0_S1_PF_MASK)
+
+/*******************************************************************************
+ * Variable
+ ******************************************************************************/
+
+/*UART0 register block of the device header*/
+UART0_Type g_mock_uart0;
+
+/*This variable stores the events posted by the driver*/
+static unsigned int s_events_posted = 0;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+void UART0_IRQHandler(void);
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+/*Stand-ins of the modules the driver calls, the clock gates and pins do not exist on the host*/
+void Driver_PORT_set_MUX_pin(Port_type_enum_t port_type, uint8_t pin, Mux_type_enum_t mux_type)
+{
+    (void)port_type;
+    (void)pin;
+    (void)mux_type;
+}
+
+void Driver_SIM_SCGC4_set_UART0_clock_gate(clock_gate_state_enum_t uart0_clock_gate)
+{
+    (void)uart0_clock_gate;
+}
+
+void Driver_SIM_SCGC5_set_PORTn_clock_gate(Port_type_enum_t port, clock_gate_state_enum_t PORTn_gate)
+{
+    (void)port;
+    (void)PORTn_gate;
+}
+
+void Event_post(event_id_enum_t event)
+{
+    (void)event;
+    s_events_posted++;
+}
+
+/*Baud rate divisor in BDH and BDL*/
+static uint32_t get_divisor(void)
+{
+    return ((uint32_t)(g_mock_uart0.BDH & UART0_BDH_SBR_MASK) << 8u) | g_mock_uart0.BDL;
+}
+
+/*Run the interrupt handler on a received byte, the transmitter is idle*/
+static void receive_byte(uint8_t byte, uint8_t error_flags)
+{
+    g_mock_uart0.S1 = UART0_S1_RDRF_MASK | UART0_S1_TDRE_MASK | UART0_S1_TC_MASK | error_flags;
+    g_mock_uart0.D = byte;
+    UART0_IRQHandler();
+    g_mock_uart0.S1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+}
+
+/*Receive a line and its end, one byte in every error_period has a framing error (0 for none)*/
+static void receive_line(const char *line, unsigned int error_period)
+{
+    unsigned int i = 0;
+
+    for (i = 0; '\0' != line[i]; i++)
+    {
+        receive_byte((uint8_t)line[i], ((0u != error_period) && (0u == (i % error_period))) ? UART0_S1_FE_MASK : 0u);
+    }
+    receive_byte('\n', 0u);
+}
+
+/*Receive bytes that are not a line end, one in every error_period with an error*/
+static void receive_bytes(unsigned int count, unsigned int error_period, uint8_t error_flags)
+{
+    unsigned int i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        receive_byte('A', (0u == ((i + 1u) % error_period)) ? error_flags : 0u);
+    }
+}
+
+/*Read the first ready line, return 1 if it is the expected one or any line for NULL*/
+static unsigned int read_line(const char *expected)
+{
+    uint8_t line[QUEUE_LINE_SIZE];
+    unsigned int ret_val = 0;
+
+    if (QUEUE_ELEMENT_READY == Driver_UART0_check_first_buffer())
+    {
+        Driver_UART0_receive_string(line);
+        Driver_UART0_dequeue();
+        ret_val = ((NULL == expected) || (0 == strcmp((const char *)line, expected))) ? 1u : 0u;
+    }
+
+    return ret_val;
+}
+
+int main(void)
+{
+    uart0_config_info config = {
+        .baud_rate = 115200,
+        .OSR = 16,
+        .Tx_Rx_port = PORT_A,
+        .Tx_pin = 2,
+        .Rx_pin = 1,
+        .data_mode = DATA_8BITS,
+        .parity_state = PARITY_DISABLED,
+        .stop_bit_count = ONE_STOP_BIT,
+        .transmitter_state = TRANSMITTER_ENABLED,
+        .receiver_state = RECEIVER_ENABLED,
+        .transmiter_IRQ = TRANSMIT_IRQ_DISABLED,
+        .receiver_IRQ = RECEIVE_IRQ_ENABLED,
+        .error_rate = 0,
+    };
+    uart0_error_counter_info counters;
+    uart0_rx_statistic_info statistics;
+    unsigned int i = 0;
+
+    g_mock_uart0.S1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+    Driver_UART0_init(&config, TEST_CLOCK);
+    CHECK(13u == get_divisor());
+    CHECK(0u == Driver_UART0_get_error_rate());
+
+    /*Lines are received and each error type is counted, its flag is cleared*/
+    receive_line("S0030000FC", 0u);
+    CHECK(1u == read_line("S0030000FC"));
+    g_mock_uart0.S1 = UART0_S1_RDRF_MASK | UART0_S1_OR_MASK | UART0_S1_NF_MASK;
+    g_mock_uart0.D = 'S';
+    UART0_IRQHandler();
+    CHECK((UART0_S1_OR_MASK | UART0_S1_NF_MASK) == g_mock_uart0.S1);
+    receive_byte('0', UART0_S1_FE_MASK);
+    receive_byte('3', UART0_S1_PF_MASK);
+    receive_byte('\n', 0u);
+    CHECK(1u == read_line("S03"));
+    Driver_UART0_get_error_counters(&counters);
+    CHECK((1u == counters.overrun_count) && (1u == counters.noise_count));
+    CHECK((1u == counters.framing_count) && (1u == counters.parity_count));
+
+    /*Without the host handshake a noisy line never changes the baud rate*/
+    receive_bytes(4u * UART0_ERROR_WINDOW_BYTES, 2u, UART0_S1_FE_MASK);
+    receive_byte('\n', 0u);
+    CHECK(1u == read_line(NULL));
+    CHECK(0u == Driver_UART0_get_step_down_baud());
+    Driver_UART0_step_down();
+    CHECK(13u == get_divisor());
+
+    /*The step-down follows a rate: errors spread below it over many windows do not trigger it*/
+    Driver_UART0_reset_error_counters();
+    Driver_UART0_set_error_rate(20u);
+    CHECK(20u == Driver_UART0_get_error_rate());
+    receive_bytes(20u * UART0_ERROR_WINDOW_BYTES, 64u, UART0_S1_FE_MASK);
+    receive_byte('\n', 0u);
+    CHECK(1u == read_line(NULL));
+    CHECK(0u == Driver_UART0_get_step_down_baud());
+
+    /*A burst at the rate requests it, the baud rate only changes once the host has been told*/
+    receive_bytes(UART0_ERROR_WINDOW_BYTES, 8u, UART0_S1_NF_MASK);
+    receive_byte('\n', 0u);
+    CHECK(1u == read_line(NULL));
+    CHECK(57600u == Driver_UART0_get_step_down_baud());
+    CHECK(13u == get_divisor());
+    CHECK(115200u == Driver_UART0_get_baud_rate());
+
+    Driver_UART0_step_down();
+    CHECK(26u == get_divisor());
+    CHECK(57600u == Driver_UART0_get_baud_rate());
+    CHECK(0u == Driver_UART0_get_step_down_baud());
+    Driver_UART0_get_error_counters(&counters);
+    CHECK(1u == counters.step_down_count);
+
+    /*At the lowest baud rate a crossed rate has nothing to step down to*/
+    for (i = 0; i < UART0_STEP_DOWN_BAUD_COUNT; i++)
+    {
+        receive_bytes(UART0_ERROR_WINDOW_BYTES, 2u, UART0_S1_FE_MASK);
+        Driver_UART0_step_down();
+    }
+    receive_byte('\n', 0u);
+    CHECK(1u == read_line(NULL));
+    CHECK(9600u == Driver_UART0_get_baud_rate());
+    Driver_UART0_get_error_counters(&counters);
+    CHECK(3u == counters.step_down_count);
+    receive_bytes(UART0_ERROR_WINDOW_BYTES, 2u, UART0_S1_FE_MASK);
+    CHECK(0u == Driver_UART0_get_step_down_baud());
+    receive_byte('\n', 0u);
+    CHECK(1u == read_line(NULL));
+
+    /*Disabled again by the host*/
+    Driver_UART0_set_error_rate(0u);
+    receive_bytes(UART0_ERROR_WINDOW_BYTES, 1u, UART0_S1_FE_MASK);
+    CHECK(0u == Driver_UART0_get_step_down_baud());
+    receive_byte('\n', 0u);
+    CHECK(1u == read_line(NULL));
+
+    /*One queue line is kept to receive into: a line that finds the others unread is dropped at
+     *its end and the unread lines are kept*/
+    Driver_UART0_reset_rx_statistics();
+    for (i = 0; i < (MAX_QUEQUE_SIZE - 1u); i++)
+    {
+        receive_line("S1130000", 0u);
+    }
+    receive_line("LOST", 0u);
+    Driver_UART0_get_rx_statistics(&statistics);
+    CHECK(5u == statistics.dropped_bytes);
+    CHECK((MAX_QUEQUE_SIZE - 1u) == statistics.peak_queue_occupancy);
+    CHECK(1u == read_line("S1130000"));
+
+    /*The line after the dropped one is received once a line has been read*/
+    receive_line("S9030000FC", 0u);
+    for (i = 1; i < (MAX_QUEQUE_SIZE - 1u); i++)
+    {
+        CHECK(1u == read_line("S1130000"));
+    }
+    CHECK(1u == read_line("S9030000FC"));
+    CHECK(0u == read_line(NULL));
+    CHECK(0u != s_events_posted);
+
+    return CHECK_DONE("test_uart0_rx");
+}
+/*EOF*/